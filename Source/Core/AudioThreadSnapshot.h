@@ -1,6 +1,9 @@
 #pragma once
+#include <array>
 #include <atomic>
-#include <memory>
+#include <cstdint>
+#include <tuple>
+#include <algorithm>
 #include <juce_core/juce_core.h>
 
 namespace CZ101 {
@@ -9,19 +12,45 @@ namespace Core {
 /**
  * A lock-free snapshot system for passing parameter structures from the 
  * Message Thread (UI) to the Audio Thread safely.
+ *
+ * Each committed snapshot carries a version and the sections that differ from
+ * the snapshot committed before it, so the audio thread only re-applies what
+ * changed (and nothing at all while the parameters are idle).
  */
 struct ParameterSnapshot {
+    enum Section : uint32_t {
+        Oscillators = 1u << 0, // dco1, dco2, lineSelect, lineMod
+        System      = 1u << 1,
+        Modulation  = 1u << 2,
+        Arp         = 1u << 3,
+        Lfo         = 1u << 4,
+        Effects     = 1u << 5,
+        Envelopes   = 1u << 6,
+        AllSections = (1u << 7) - 1
+    };
+
+    // Never a pool version: stamped on the snapshots the audio thread builds for a Program Change
+    // or SysEx patch, so the first pool snapshot after one cannot look like its successor
+    static constexpr uint64_t OVERRIDE_VERSION = ~uint64_t { 0 };
+
+    uint64_t version = 0;                 // Set by AudioThreadSnapshot::commit
+    uint32_t dirtySections = AllSections; // Sections changed since version - 1
+
     struct DCOParams {
          int wave1 = 0, wave2 = 0;
          float level = 1.0f;
          int octave = 0;
          int coarse = 0;
          int fine = 0;
+         auto tie() const noexcept { return std::tie(wave1, wave2, level, octave, coarse, fine); }
     } dco1, dco2;
 
+    int lineSelect = 2; // 0 = Line 1, 1 = Line 2, 2 = Line 1+1', 3 = Line 1+2'
+
     struct LineModParams {
         bool ring = false;
         bool noise = false;
+        auto tie() const noexcept { return std::tie(ring, noise); }
     } lineMod;
 
     struct SystemParams {
@@ -31,8 +60,11 @@ struct ParameterSnapshot {
         int voiceLimit = 8;
         bool hardwareNoise = false;
         int oversampling = 1; // [NEW]
+        bool oversamplingMixBus = false; // Decimate once after voice summation instead of per voice
         int opMode = 0; // [NEW] 0=CZ101, 1=CZ5000
         int midiChannel = 1; // [NEW]
+        auto tie() const noexcept { return std::tie(masterVol, masterTune, bendRange, voiceLimit, hardwareNoise,
+                                                    oversampling, oversamplingMixBus, opMode, midiChannel); }
     } system;
 
     struct ModParams {
@@ -44,6 +76,9 @@ struct ParameterSnapshot {
         int keyFollowDco = 0; // [NEW]
         int detune = 0; 
         float glideTime = 0.0f; // [NEW]
+        auto tie() const noexcept { return std::tie(veloDcw, veloAmp, wheelToDcw, wheelToLfoRate, wheelToVibrato,
+                                                    atToDcw, atToVibrato, keyFollowDcw, keyFollowAmp, keyFollowDco,
+                                                    detune, glideTime); }
     } mod;
     
     struct ArpParams {
@@ -55,6 +90,7 @@ struct ParameterSnapshot {
         float gate = 1.0f;
         float swing = 0.0f;
         int swingMode = 0; // 8th or 16th
+        auto tie() const noexcept { return std::tie(enabled, latch, rate, pattern, octave, gate, swing, swingMode); }
     } arp;
 
     struct LfoParams {
@@ -62,6 +98,7 @@ struct ParameterSnapshot {
         int waveform = 0;
         float depth = 0.0f;
         float delay = 0.0f;
+        auto tie() const noexcept { return std::tie(rate, waveform, depth, delay); }
     } lfo;
 
     struct EffectsParams {
@@ -86,6 +123,9 @@ struct ParameterSnapshot {
         float lpfCutoff = 20000.0f;
         float lpfReso = 0.0f;
         float hpfCutoff = 20.0f;
+        auto tie() const noexcept { return std::tie(chorusOn, chorusRate, chorusDepth, chorusMix, delayTime, delayFb,
+                                                    delayMix, reverbSize, reverbMix, driveAmount, driveColor, driveMix,
+                                                    lpfCutoff, lpfReso, hpfCutoff); }
     } effects;
     
     // We include basic envelope settings for snapshot restoration
@@ -95,48 +135,99 @@ struct ParameterSnapshot {
         float levels[8] = {0};
         int sustain = -1;
         int end = 0;
+        bool operator==(const EnvParam& o) const noexcept {
+            return std::equal(rates, rates + 8, o.rates) && std::equal(levels, levels + 8, o.levels)
+                && sustain == o.sustain && end == o.end;
+        }
     };
     
     struct VoiceEnvelopes {
         EnvParam dcw1, dcw2;
         EnvParam dca1, dca2;
         EnvParam pitch1, pitch2; // Optional
+        auto tie() const noexcept { return std::tie(dcw1, dcw2, dca1, dca2, pitch1, pitch2); }
     } envelopes;
+
+    /** Sections in which two snapshots differ (field-wise, so struct padding never counts) */
+    static uint32_t diffSections(const ParameterSnapshot& a, const ParameterSnapshot& b) noexcept {
+        uint32_t dirty = 0;
+        if (a.dco1.tie() != b.dco1.tie() || a.dco2.tie() != b.dco2.tie()
+            || a.lineSelect != b.lineSelect || a.lineMod.tie() != b.lineMod.tie()) dirty |= Oscillators;
+        if (a.system.tie() != b.system.tie())       dirty |= System;
+        if (a.mod.tie() != b.mod.tie())             dirty |= Modulation;
+        if (a.arp.tie() != b.arp.tie())             dirty |= Arp;
+        if (a.lfo.tie() != b.lfo.tie())             dirty |= Lfo;
+        if (a.effects.tie() != b.effects.tie())     dirty |= Effects;
+        if (a.envelopes.tie() != b.envelopes.tie()) dirty |= Envelopes;
+        return dirty;
+    }
 };
 
+/**
+ * Publishes ParameterSnapshots from the Message Thread (single writer) to the
+ * Audio Thread (single reader) without allocating.
+ *
+ * Snapshots live in a fixed pool. The reader announces the snapshot it is using
+ * in a hazard pointer and keeps it until its next get(); the writer only fills a
+ * slot that is neither published nor announced. Both sides store before they
+ * load the other side's pointer (seq_cst), so a slot the reader could still be
+ * reading is never overwritten, and a reader that announced a stale slot sees
+ * the newer pointer on re-validation and moves to it.
+ */
 class AudioThreadSnapshot {
 public:
-    AudioThreadSnapshot() : currentSnapshot(new ParameterSnapshot()) {}
-    
-    ~AudioThreadSnapshot() {
-        if (auto* ptr = currentSnapshot.exchange(nullptr))
-            delete ptr;
-    }
+    // Published + announced by the reader + one being filled, and a spare
+    static constexpr int POOL_SIZE = 4;
+
+    AudioThreadSnapshot() = default;
 
     /**
-     * Publishes a new snapshot to the audio thread.
-     * Called from Message Thread.
+     * Publishes a copy of next to the audio thread, stamped with a version and its dirty sections.
+     * Called from Message Thread (the only writer, so the current snapshot is stable here).
      */
-    void commit(std::unique_ptr<ParameterSnapshot> next) {
-        auto* old = currentSnapshot.exchange(next.release(), std::memory_order_acq_rel);
-        if (old) {
-            // In a production environment, we might defer deletion or use a pool
-            // to be strictly real-time safe if the Message Thread can't block.
-            // But since this is called from Message Thread, standard delete is usually fine.
-            delete old;
-        }
+    void commit(const ParameterSnapshot& next) noexcept {
+        const auto* prev = currentSnapshot.load(std::memory_order_relaxed);
+        auto& slot = acquireFreeSlot(prev);
+
+        slot = next;
+        slot.version = prev->version + 1;
+        slot.dirtySections = ParameterSnapshot::diffSections(*prev, slot);
+
+        currentSnapshot.store(&slot, std::memory_order_seq_cst);
     }
 
     /**
-     * Retrieves the current snapshot.
+     * Retrieves the current snapshot; it stays valid until the next call.
      * Called from Audio Thread.
      */
-    const ParameterSnapshot* get() const noexcept {
-        return currentSnapshot.load(std::memory_order_acquire);
+    const ParameterSnapshot* get() noexcept {
+        auto* snapshot = currentSnapshot.load(std::memory_order_seq_cst);
+        for (;;) {
+            readerHazard.store(snapshot, std::memory_order_seq_cst);
+            auto* latest = currentSnapshot.load(std::memory_order_seq_cst);
+            if (latest == snapshot) return snapshot;
+            snapshot = latest; // A commit landed in between: announce the newer one instead
+        }
     }
 
 private:
-    alignas(64) std::atomic<ParameterSnapshot*> currentSnapshot{ nullptr };
+    std::array<ParameterSnapshot, POOL_SIZE> pool {};
+    size_t nextSlot = 1; // Writer-side round-robin start
+
+    alignas(64) std::atomic<ParameterSnapshot*> currentSnapshot{ &pool[0] };
+    alignas(64) std::atomic<const ParameterSnapshot*> readerHazard{ nullptr };
+
+    ParameterSnapshot& acquireFreeSlot(const ParameterSnapshot* published) noexcept {
+        const auto* inUse = readerHazard.load(std::memory_order_seq_cst);
+        for (size_t i = 0; i < pool.size(); ++i) {
+            auto& candidate = pool[(nextSlot + i) % pool.size()];
+            if (&candidate == published || &candidate == inUse) continue;
+            nextSlot = (nextSlot + i + 1) % pool.size();
+            return candidate;
+        }
+        jassertfalse; // Unreachable: at most two of POOL_SIZE slots are ever in use
+        return pool[0];
+    }
     
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(AudioThreadSnapshot)
 };
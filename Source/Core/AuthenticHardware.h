@@ -2,6 +2,7 @@
 #include <juce_core/juce_core.h>
 #include <cmath>
 #include <algorithm>
+#include "../Utils/FastMath.h"
 
 namespace CZ101 {
 namespace Core {
@@ -36,8 +37,8 @@ namespace HardwareConstants {
     inline float getAuthenticDCWKeytrack(int midiNote, float dcwEnvValue) {
         float noteFromC3 = (midiNote - 60) / 12.0f;
         float exponent = 1.3f + (dcwEnvValue * 0.7f);
-        float tracking = std::pow(2.0f, noteFromC3 * exponent) - 1.0f;
-        tracking = std::tanh(tracking * 2.0f) * 0.5f;
+        float tracking = Utils::FastMath::exp2(noteFromC3 * exponent) - 1.0f;
+        tracking = Utils::FastMath::tanh(tracking * 2.0f) * 0.5f;
         return tracking * (0.02f + dcwEnvValue * 0.03f);
     }
 
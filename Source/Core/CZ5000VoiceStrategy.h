@@ -14,22 +14,22 @@ namespace Core {
 class CZ5000VoiceStrategy : public VoiceAssignmentStrategy
 {
 public:
-    int findVoiceToSteal(const Voice* voices, int numVoices, int maxActiveVoices) override
+    int findVoiceToSteal(const Voice* voices, const int16_t* activeIndices, int numActive, int maxActiveVoices) override
     {
-        // 1. Search for a free voice (not active)
+        // 1. Search for a voice that went silent but is not retired yet
         // (Usually handled by VoiceManager before calling steal, but good to check)
-        for (int i = 0; i < maxActiveVoices; ++i) {
-            if (!voices[i].isActive()) return i;
+        for (int i = 0; i < numActive; ++i) {
+            if (!voices[activeIndices[i]].isActive()) return activeIndices[i];
         }
 
         // 2. Search for voices in Release phase (steal them first!)
         // Authentic behavior: If multiple are released, pick the oldest one?
         // Or just the next one in round-robin sequence?
         // Let's assume finding *any* releasing voice is better than a held one.
-        for (int i = 0; i < maxActiveVoices; ++i) {
+        for (int i = 0; i < numActive; ++i) {
             // How to check release phase? Voice needs an accessor or we check envelope state.
             // Assuming Voice has isReleasing() or similar.
-            if (voices[i].isReleasing()) return i; 
+            if (voices[activeIndices[i]].isReleasing()) return activeIndices[i]; 
         }
 
         // 3. If all voices are held, use Round Robin
@@ -0,0 +1,46 @@
+#include "ControlRateModulation.h"
+#include "../Utils/FastMath.h"
+#include "../DSP/Filters/SVFFilter.h"
+#include <algorithm>
+
+namespace CZ101 {
+namespace Core {
+
+void ControlRateLanes::process(int numLanes) const noexcept
+{
+    for (int l = 0; l < 2; ++l)
+    {
+        const float* envDcw = dcwEnv[l];
+        const float* envDca = dcaEnv[l];
+        const float* envPitch = pitchEnv[l];
+        float* outDcw = dcw[l];
+        float* outDca = dca[l];
+        float* outFreq = frequency[l];
+
+        // Velocity-scaled DCW envelope plus modulation, capped below full distortion
+        for (int i = 0; i < numLanes; ++i)
+            outDcw[i] = std::min(std::max(envDcw[i] * dcwScale[i] + dcwOffset[i], 0.0f), 0.99f);
+
+        for (int i = 0; i < numLanes; ++i)
+            outDca[i] = std::min(std::max(envDca[i] + dcaOffset[i], 0.0f), 1.0f) * dcaScale[i];
+
+        // Pitch envelope spans +-1 octave; vibrato and key follow are folded into one exponent
+        for (int i = 0; i < numLanes; ++i)
+            outFreq[i] = (envPitch[i] - 0.5f) * 2.0f + pitchOffset[i];
+
+        Utils::FastMath::exp2(outFreq, outFreq, numLanes);
+
+        for (int i = 0; i < numLanes; ++i)
+            outFreq[i] *= baseFrequency[i];
+    }
+
+    for (int i = 0; i < numLanes; ++i)
+        frequency[1][i] *= detune[i];
+
+    // Cutoff LUT instead of tan() per voice
+    DSP::SVFCutoffTable::gain(lpfCutoff, lowG, numLanes);
+    DSP::SVFCutoffTable::gain(hpfCutoff, highG, numLanes);
+}
+
+} // namespace Core
+} // namespace CZ101
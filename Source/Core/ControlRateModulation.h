@@ -0,0 +1,87 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+
+namespace CZ101 {
+namespace Core {
+
+/**
+ * @brief Structure-of-arrays view of one control tick's modulation, one lane per voice
+ *
+ * Voices gather what needs their own state (envelopes, LFO, smoothers, glide) into
+ * a lane; process() then evaluates the per-line DCW, DCA and frequency targets and the
+ * filter gains for every lane in straight loops over contiguous floats (no per-voice
+ * branches), so the compiler can vectorise them across voices.
+ */
+struct ControlRateLanes
+{
+    // --- Inputs (written by Voice::gatherControlInputs) ---
+    float* dcwEnv[2] {};       // DCW envelope value per line
+    float* dcaEnv[2] {};       // DCA envelope value per line
+    float* pitchEnv[2] {};     // Pitch envelope value per line (0.5 = centre)
+    float* dcwScale = nullptr;  // Velocity sensitivity on the DCW envelope
+    float* dcwOffset = nullptr; // Key follow + velocity/wheel/aftertouch DCW
+    float* dcaOffset = nullptr; // DCA key follow
+    float* dcaScale = nullptr;  // Velocity -> DCA
+    float* pitchOffset = nullptr;   // log2 offset shared by both lines (vibrato + DCO key follow)
+    float* baseFrequency = nullptr; // Glided note frequency * bend * tune * velocity pitch
+    float* detune = nullptr;        // Line 2 detune factor
+    float* lpfCutoff = nullptr;     // Filter cutoffs as f / fs
+    float* hpfCutoff = nullptr;
+
+    // --- Outputs (read by Voice::applyControlOutputs) ---
+    float* dcw[2] {};
+    float* dca[2] {};
+    float* frequency[2] {};
+    float* lowG = nullptr;  // TPT gains tan(pi * f / fs) for DSP::SVFVoiceFilter
+    float* highG = nullptr;
+
+    void process(int numLanes) const noexcept;
+};
+
+/** Owns the arrays behind a ControlRateLanes view (not copyable: the view points into it). */
+template <int NumLanes>
+class ControlRateBuffers
+{
+public:
+    ControlRateBuffers() noexcept
+    {
+        int next = 0;
+        auto take = [this, &next]() noexcept { return storage[static_cast<std::size_t>(next++)].data(); };
+
+        for (int l = 0; l < 2; ++l)
+        {
+            view.dcwEnv[l] = take();
+            view.dcaEnv[l] = take();
+            view.pitchEnv[l] = take();
+            view.dcw[l] = take();
+            view.dca[l] = take();
+            view.frequency[l] = take();
+        }
+        view.dcwScale = take();
+        view.dcwOffset = take();
+        view.dcaOffset = take();
+        view.dcaScale = take();
+        view.pitchOffset = take();
+        view.baseFrequency = take();
+        view.detune = take();
+        view.lpfCutoff = take();
+        view.hpfCutoff = take();
+        view.lowG = take();
+        view.highG = take();
+    }
+
+    ControlRateBuffers(const ControlRateBuffers&) = delete;
+    ControlRateBuffers& operator=(const ControlRateBuffers&) = delete;
+
+    const ControlRateLanes& lanes() const noexcept { return view; }
+
+private:
+    static constexpr int NUM_ARRAYS = 2 * 6 + 11;
+    alignas(32) std::array<std::array<float, NumLanes>, NUM_ARRAYS> storage {};
+    ControlRateLanes view;
+};
+
+} // namespace Core
+} // namespace CZ101
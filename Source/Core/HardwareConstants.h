@@ -3,6 +3,7 @@
 #include <cmath>
 #include <algorithm>
 #include <cstdlib>
+#include "../Utils/FastMath.h"
 
 namespace CZ101 {
 namespace Core {
@@ -36,14 +37,27 @@ namespace HardwareConstants {
     // Control Rate Divider (Process control every 8 samples)
     constexpr int CONTROL_RATE_DIVIDER = 8;
     constexpr int CONTROL_RATE_MASK = CONTROL_RATE_DIVIDER - 1;
+    
+    // Configurable divider range (powers of two). DCW/DCA are ramped between ticks,
+    // so larger dividers trade modulation bandwidth for CPU without zipper noise.
+    constexpr int MIN_CONTROL_RATE_DIVIDER = 1;
+    constexpr int MAX_CONTROL_RATE_DIVIDER = 32;
+
+    // Silent-voice retirement: a released voice whose estimated output stays below the
+    // floor for the hold time (in control ticks) is faded out and freed before its envelope
+    // reaches the end point. Slow CZ releases otherwise hold a voice for seconds of silence.
+    constexpr float SILENCE_FLOOR_DB = -96.0f;
+    constexpr float SILENCE_FLOOR_OFF_DB = -200.0f; // At or below: retirement disabled
+    constexpr int SILENCE_HOLD_TICKS = 64;          // ~12 ms at 44.1 kHz with the default divider
+    constexpr float SILENCE_FADE_SECONDS = 0.002f;
 
     // Audit Fix 10.3: Non-Linear Line Mixing (Simulate summing amp saturation)
     // Uses tanh approximation for warmth and safety.
     inline float mixLines(float l1, float l2) {
         float sum = l1 + l2;
-        // Soft saturation: std::tanh(sum)
+        // Soft saturation: tanh(sum)
         // We allow a bit of "hotness"
-        return std::tanh(sum); 
+        return Utils::FastMath::tanh(sum); 
     }
 
 } // namespace HardwareConstants
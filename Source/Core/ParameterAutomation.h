@@ -0,0 +1,109 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <juce_core/juce_core.h>
+
+namespace CZ101 {
+namespace Core {
+
+/**
+ * @brief Host automation of continuous parameters, read on the audio thread
+ *
+ * Each parameter is bound to its APVTS value atomic, which the host writes before
+ * calling processBlock (during offline bounces too, when the message thread may not
+ * run). beginBlock() turns the value into a ramp from where the previous block
+ * ended to the current value, so automation needs no message-thread round trip.
+ * Consumers either sample the ramp at RAMP_SEGMENT_SAMPLES breakpoints (voices)
+ * or take its end value once per block (effects, which smooth internally).
+ */
+class ParameterAutomation
+{
+public:
+    enum Param
+    {
+        MasterVolume,
+        LpfCutoff,
+        LpfReso,
+        HpfCutoff,
+        MacroBrilliance,
+        LfoRate,
+        LfoDepth,
+        ChorusRate,
+        ChorusDepth,
+        ChorusMix,
+        DelayFeedback,
+        DelayMix,
+        ReverbSize,
+        ReverbMix,
+        DriveAmount,
+        DriveColor,
+        DriveMix,
+        NUM_PARAMS
+    };
+
+    // Breakpoint spacing while a ramp is running (1.5 ms at 44.1 kHz)
+    static constexpr int RAMP_SEGMENT_SAMPLES = 64;
+
+    struct Ramp
+    {
+        float start = 0.0f;
+        float end = 0.0f;
+
+        /** Value at fraction (0 = block start, 1 = block end) */
+        float at(float fraction) const noexcept { return start + (end - start) * fraction; }
+    };
+
+    /** Message thread, before playback; unbound parameters keep their default */
+    void bind(Param p, std::atomic<float>* source, float defaultValue) noexcept
+    {
+        sources[(size_t)p] = source;
+        ramps[(size_t)p] = { defaultValue, defaultValue };
+    }
+
+    /** Jump to the current values without ramping (prepareToPlay) */
+    void reset() noexcept
+    {
+        for (size_t i = 0; i < ramps.size(); ++i)
+            if (sources[i] != nullptr)
+                ramps[i].start = ramps[i].end = sources[i]->load(std::memory_order_relaxed);
+        ramping = false;
+    }
+
+    /** Audio thread, once per block: the previous end becomes the new start */
+    void beginBlock() noexcept
+    {
+        ramping = false;
+        for (size_t i = 0; i < ramps.size(); ++i)
+        {
+            auto& r = ramps[i];
+            r.start = r.end;
+            if (sources[i] != nullptr)
+                r.end = sources[i]->load(std::memory_order_relaxed);
+            ramping |= (r.end != r.start);
+        }
+    }
+
+    /**
+     * Audio thread: hold a parameter at value for the rest of the block, ignoring its source
+     * (a program the APVTS has not caught up with yet). The next beginBlock() ramps on from it.
+     */
+    void hold(Param p, float value) noexcept
+    {
+        ramps[(size_t)p] = { value, value };
+    }
+
+    const Ramp& operator[](Param p) const noexcept { return ramps[(size_t)p]; }
+    float getEnd(Param p) const noexcept { return ramps[(size_t)p].end; }
+
+    /** True when any parameter moved since the previous block */
+    bool isRamping() const noexcept { return ramping; }
+
+private:
+    std::array<std::atomic<float>*, NUM_PARAMS> sources {};
+    std::array<Ramp, NUM_PARAMS> ramps {};
+    bool ramping = false;
+};
+
+} // namespace Core
+} // namespace CZ101
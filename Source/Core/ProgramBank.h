@@ -0,0 +1,90 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <memory>
+#include <vector>
+#include <juce_core/juce_core.h>
+
+namespace CZ101 {
+namespace Core {
+
+/**
+ * @brief Immutable copy of every bank slot, for real-time program changes
+ *
+ * The message thread publishes the whole bank as one set; a MIDI Program Change
+ * on the audio thread looks its program up without locking the PresetManager.
+ * The programs are kept as patches, not snapshots: the snapshot is built when the
+ * program is applied, so the parameters a patch does not store take their live
+ * values at that moment and nothing has to be rebuilt when those values change.
+ *
+ * Sets are reclaimed with hazard pointers like AudioThreadSnapshot: the reader
+ * announces the set it holds, and publish() frees only sets that are neither
+ * current nor announced. The reader uses two hazard slots so a lookup that misses
+ * in a newer set does not give up the set it is still playing from.
+ */
+template <typename Program>
+class BasicProgramBank
+{
+public:
+    BasicProgramBank() = default;
+
+    /** Message thread: replaces every program (allocates, frees sets the audio thread left) */
+    void publish(std::vector<Program> programs)
+    {
+        auto next = std::make_unique<Programs>();
+        next->programs = std::move(programs);
+
+        current.store(next.get(), std::memory_order_seq_cst);
+        published.push_back(std::move(next));
+
+        const auto* held = hazards[0].load(std::memory_order_seq_cst);
+        const auto* probing = hazards[1].load(std::memory_order_seq_cst);
+        const auto* latest = current.load(std::memory_order_relaxed);
+        published.erase(std::remove_if(published.begin(), published.end(), [&](const std::unique_ptr<Programs>& p)
+        {
+            return p.get() != latest && p.get() != held && p.get() != probing;
+        }), published.end());
+    }
+
+    /**
+     * Audio thread: a program in the newest set, or nullptr if the set has no such
+     * slot. A returned program stays valid until a later lookup succeeds.
+     */
+    const Program* find(int program) noexcept
+    {
+        const auto* latest = current.load(std::memory_order_seq_cst);
+        for (;;)
+        {
+            hazards[1].store(latest, std::memory_order_seq_cst);
+            const auto* recheck = current.load(std::memory_order_seq_cst);
+            if (recheck == latest) break;
+            latest = recheck; // A publish landed in between: announce the newer set instead
+        }
+
+        const Program* found = nullptr;
+        if (latest != nullptr && program >= 0 && program < static_cast<int>(latest->programs.size()))
+        {
+            found = &latest->programs[static_cast<size_t>(program)];
+            hazards[0].store(latest, std::memory_order_seq_cst);
+        }
+        hazards[1].store(nullptr, std::memory_order_seq_cst);
+        return found;
+    }
+
+private:
+    struct Programs
+    {
+        std::vector<Program> programs;
+    };
+
+    std::vector<std::unique_ptr<Programs>> published; // Message thread only
+    alignas(64) std::atomic<const Programs*> current { nullptr };
+    alignas(64) std::array<std::atomic<const Programs*>, 2> hazards {}; // [0] held, [1] being probed
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(BasicProgramBank)
+};
+
+} // namespace Core
+} // namespace CZ101
@@ -2,8 +2,11 @@
 #include "Voice.h"
 #include "AudioThreadSnapshot.h" // [NEW]
 #include "HardwareConstants.h"
+#include "ControlRateModulation.h"
 #include "AuthenticHardware.h"
+#include "../Utils/FastMath.h"
 #include <cmath>
+#include <algorithm>
 #include "../DSP/Envelopes/ADSRtoStage.h"
 
 namespace CZ101 {
@@ -11,15 +14,13 @@ namespace Core {
 
 Voice::Voice()
 {
-    // Initialize Modern Filters
-    lpf.setType(DSP::ResonantFilter::LOWPASS);
-    hpf.setType(DSP::ResonantFilter::HIGHPASS);
-
     // Audit Fix [11.2]: Pitch Envelope Initialization
     // Pitch envelopes must start at 0.5 (Center/No Pitch Shift) to avoid sweep up from 0.0
     pitchEnvelope1.setInitialValue(0.5f);
     pitchEnvelope2.setInitialValue(0.5f);
 
+    setSilenceRetirement(HardwareConstants::SILENCE_FLOOR_DB, HardwareConstants::SILENCE_HOLD_TICKS);
+
     // Audit Fix 1.5: Safe Initialization
     // Initialize with a default valid sample rate to prevent div-by-zero 
     // in envelope calculations if accessed before prepareToPlay.
@@ -40,32 +41,57 @@ void Voice::setModel(DSP::MultiStageEnvelope::Model newModel) noexcept
 void Voice::setSampleRate(double sr) noexcept
 {
     sampleRate = sr;
-    osc1.setSampleRate(sr);
-    osc2.setSampleRate(sr);
-    dcwEnvelope1.setSampleRate(sr);
-    dcaEnvelope1.setSampleRate(sr);
-    pitchEnvelope1.setSampleRate(sr);
-    dcwEnvelope2.setSampleRate(sr);
-    dcaEnvelope2.setSampleRate(sr);
-    pitchEnvelope2.setSampleRate(sr);
-    lfoModule.setSampleRate(sr);
-    lpf.setSampleRate(sr);
-    hpf.setSampleRate(sr);
+    osc1.setSampleRate(sr * oversamplingFactor);
+    osc2.setSampleRate(sr * oversamplingFactor);
+    filterPrimed = false;
     
     osc1Level.reset(sr, 0.02);
     osc2Level.reset(sr, 0.02);
-    currentDetuneFactor.reset(sr, 0.05); // Detune needs longer smoothing
     masterVolume.reset(sr, 0.02);
 
+    updateControlRateTiming();
+
     updateDCWEnvelopeFromADSR(1);
     updateDCAEnvelopeFromADSR(1);
     updatePitchEnvelopeFromADSR(1);
     updateDCWEnvelopeFromADSR(2);
     updateDCAEnvelopeFromADSR(2);
     updatePitchEnvelopeFromADSR(2);
+}
+
+void Voice::setControlRateDivider(int divider) noexcept
+{
+    divider = juce::jlimit(HardwareConstants::MIN_CONTROL_RATE_DIVIDER, HardwareConstants::MAX_CONTROL_RATE_DIVIDER,
+                           juce::nextPowerOfTwo(juce::jmax(1, divider)));
+    if (divider == controlDivider) return;
     
-    // Smoothed Matrix Init (Control Rate = SR / 8)
-    double cr = sr / 8.0;
+    controlDivider = divider;
+    updateControlRateTiming();
+}
+
+void Voice::setSilenceRetirement(float floorDb, int holdTicks) noexcept
+{
+    silenceFloorGain = floorDb <= HardwareConstants::SILENCE_FLOOR_OFF_DB ? 0.0f : juce::Decibels::decibelsToGain(floorDb, HardwareConstants::SILENCE_FLOOR_OFF_DB);
+    silenceHoldTicks = juce::jmax(1, holdTicks);
+}
+
+void Voice::updateControlRateTiming() noexcept
+{
+    // Envelopes, LFO and detune advance once per tick but are clocked as if the tick
+    // ran at sampleRate with the default divider; scaling that clock by 8 / divider
+    // keeps every time constant the same whatever divider is chosen.
+    const double tickClock = sampleRate * HardwareConstants::CONTROL_RATE_DIVIDER / controlDivider;
+    dcwEnvelope1.setSampleRate(tickClock);
+    dcaEnvelope1.setSampleRate(tickClock);
+    pitchEnvelope1.setSampleRate(tickClock);
+    dcwEnvelope2.setSampleRate(tickClock);
+    dcaEnvelope2.setSampleRate(tickClock);
+    pitchEnvelope2.setSampleRate(tickClock);
+    lfoModule.setSampleRate(tickClock);
+    currentDetuneFactor.reset(tickClock, 0.05); // Detune needs longer smoothing
+    
+    // Smoothed Matrix Init (Control Rate = SR / divider)
+    const double cr = sampleRate / controlDivider;
     smoothedMatrix.veloToDcw.reset(cr, 0.05);
     smoothedMatrix.veloToDca.reset(cr, 0.05);
     smoothedMatrix.wheelToDcw.reset(cr, 0.05);
@@ -105,7 +131,14 @@ void Voice::noteOn(int midiNote, float velocity) noexcept
     
     osc1.reset();
     osc2.reset();
+    decimator.reset();
     lfoModule.reset();
+    controlTickPending = true;
+    
+    silentTicks = 0;
+    retiring = false;
+    retireGain = 1.0f;
+    silenceRetired = false;
     
     dcwEnvelope1.noteOn();
     dcaEnvelope1.noteOn();
@@ -138,8 +171,14 @@ void Voice::reset() noexcept
     pitchEnvelope2.setCurrentValue(0.5f); // Audit Fix 1.1: Center Pitch Envelope
     
     lfoModule.reset();
-    lpf.reset();
-    hpf.reset();
+    filter.reset();
+    
+    dcwStep1 = dcwStep2 = 0.0f;
+    dcaStep1 = dcaStep2 = 0.0f;
+    
+    silentTicks = 0;
+    retiring = false;
+    retireGain = 1.0f;
 }
 
 // ... Oscillators ...
@@ -159,14 +198,19 @@ void Voice::setOsc2Detune(float semitones) noexcept
 { 
     // This is legacy, the processor now calls setModulationMatrix or specific setters
     osc2Detune.setTargetValue(semitones); 
-    currentDetuneFactor.setTargetValue(std::exp2(semitones / 12.0f)); 
+    currentDetuneFactor.setTargetValue(Utils::FastMath::semitonesToRatio(semitones)); 
 }
 
 void Voice::setOsc2DetuneHardware(int oct, int coarse, int fineCents) noexcept
 {
     float totalSemitones = (oct * 12.0f) + coarse + (fineCents / 100.0f);
     osc2Detune.setTargetValue(totalSemitones);
-    currentDetuneFactor.setTargetValue(std::exp2(totalSemitones / 12.0f));
+    currentDetuneFactor.setTargetValue(Utils::FastMath::semitonesToRatio(totalSemitones));
+}
+
+void Voice::setLineSelect(int index) noexcept
+{
+    lineSelect = static_cast<LineSelect>(juce::jlimit(0, 3, index));
 }
 
 void Voice::setHardSync(bool enabled) noexcept { isHardSyncEnabled = enabled; }
@@ -182,8 +226,8 @@ void Voice::setLFOFrequency(float hz) noexcept { lfoModule.setFrequency(hz); }
 void Voice::setLFOWaveform(DSP::LFO::Waveform w) noexcept { lfoModule.setWaveform(w); }
 void Voice::setLFODelay(float s) noexcept { lfoModule.setDelay(s); }
 
-void Voice::setPitchBend(float semitones) noexcept { pitchBendFactor = std::exp2(semitones / 12.0f); }
-void Voice::setMasterTune(float semitones) noexcept { masterTuneFactor = std::exp2(semitones / 12.0f); }
+void Voice::setPitchBend(float semitones) noexcept { pitchBendFactor = Utils::FastMath::semitonesToRatio(semitones); }
+void Voice::setMasterTune(float semitones) noexcept { masterTuneFactor = Utils::FastMath::semitonesToRatio(semitones); }
 void Voice::setMasterVolume(float level) noexcept { masterVolume.setTargetValue(level); }
 
 // ============================================================================
@@ -279,44 +323,12 @@ void Voice::updatePitchEnvelopeFromADSR(int line) noexcept
 // RENDERING
 // ============================================================================
 
-// Fast Tanh Approximation (Rational type)
-// Much faster than std::tanh for real-time audio
-inline float fastTanh(float x) noexcept
-{
-    // Audit Fix [Denormals]: Ensure x is not a denormal
-    if (std::abs(x) < 1e-9f) return x; 
-
-    float x2 = x * x;
-    float a = x * (135135.0f + x2 * (17325.0f + x2 * (378.0f + x2)));
-    float b = 135135.0f + x2 * (62370.0f + x2 * (3150.0f + x2 * 28.0f));
-    return (b < 1e-20f) ? std::copysign(1.0f, x) : a / b;
-}
-
-// Deterministic exp2 approximation for cross-platform bit-identicality
-// Using a 5th order polynomial or high precision rational
-inline float deterministicExp2(float x) noexcept
-{
-    // Simple 3rd order minimax for larger range [-12, 12] semitones? 
-    // Input x is "semitones / 12 * 2" ? No, input to exp2 is the power. 2^x.
-    // Pitch mod +1 oct = 2^1. x=1.
-    // Pitch mod +2 oct = 2^2. x=2.
-    // If we clamp to [-1, 1], we limit pitch mod to ±1 octave.
-    // CZ can do several octaves.
-    // We should widen the range. The polynomial approx diverges outside [-1,1].
-    // Better to use std::exp2 for full range fidelity if we want "Professional" results.
-    // Or use a range reduction technique.
-    // Given modern CPU, std::exp2 is often intrinsic and fast enough.
-    // Replacing with std::exp2 for safety and range.
-    return std::exp2(x); 
-    // return 1.0f + x * (0.69314718f + x * (0.24022650f + x * (0.05550411f + x * 0.00961812f)));
-}
-
 float Voice::renderNextSample() noexcept
 {
-    if (!dcaEnvelope1.isActive() && !dcaEnvelope2.isActive()) return 0.0f;
+    if (!isActive()) return 0.0f;
     
-    // === CONTROL RATE MODULATION (Every 8 samples) ===
-    if ((sampleCounter++ & HardwareConstants::CONTROL_RATE_MASK) == 0)
+    // === CONTROL RATE MODULATION (Every controlDivider samples) ===
+    if ((sampleCounter++ & static_cast<uint32_t>(controlDivider - 1)) == 0)
     {
         processControlRate();
     }
@@ -325,28 +337,89 @@ float Voice::renderNextSample() noexcept
     return applyPostProcessing(rawMix);
 }
 
-void Voice::processControlRate() noexcept
+void Voice::renderBlock(float* out, int numSamples) noexcept
 {
-    calculateEnvelopeValues();
-    calculateLFOAndVibrato();
-    calculateDCWModulation();
-    calculateDCAModulation();
-    calculatePitchModulation();
+    static_assert(MAX_SEGMENT == HardwareConstants::MAX_CONTROL_RATE_DIVIDER, "Segment scratch must cover one control period");
+    int pos = 0;
+    
+    while (pos < numSamples)
+    {
+        if (!isActive())
+        {
+            // Voice finished mid-block: silence the remainder
+            std::fill(out + pos, out + numSamples, 0.0f);
+            return;
+        }
+        
+        // Control tick falls on the same grid as renderNextSample(); a fresh note ticks at once, as on the bank path
+        const int phaseInTick = static_cast<int>(sampleCounter & static_cast<uint32_t>(controlDivider - 1));
+        if (phaseInTick == 0 || controlTickPending)
+            processControlRate();
+        
+        // Run the audio-rate kernel up to the next control tick (or block end)
+        const int run = std::min(numSamples - pos, controlDivider - phaseInTick);
+        
+        if (oversamplingFactor <= 1 && isSingleLine())
+        {
+            auto line = soloLine();
+            line.osc.setFrequency(line.frequency);
+            line.osc.renderBlock(osc1Segment.data(), run, line.dcw, line.dcwStep);
+            advanceDcwRamps(run);
+            
+            for (int i = 0; i < run; ++i)
+                out[pos + i] = applyPostProcessing(mixSoloLine(line, osc1Segment[(size_t)i]));
+        }
+        else if (oversamplingFactor <= 1)
+        {
+            // Frequency is control-rate and DCW a linear ramp, so each line renders the whole run in one kernel call
+            osc1.setFrequency(cachedFreq1);
+            osc2.setFrequency(cachedFreq2);
+            osc1.renderBlock(osc1Segment.data(), run, dcwVal1, dcwStep1, nullptr, syncSegment.data());
+            osc2.renderBlock(osc2Segment.data(), run, dcwVal2, dcwStep2, isHardSyncEnabled ? syncSegment.data() : nullptr, nullptr);
+            advanceDcwRamps(run);
+            
+            for (int i = 0; i < run; ++i)
+                out[pos + i] = applyPostProcessing(mixOscillatorOutputs(osc1Segment[(size_t)i], osc2Segment[(size_t)i]));
+        }
+        else
+        {
+            renderOversampledSegment(osc1Segment.data(), run);
+            
+            for (int i = 0; i < run; ++i)
+                out[pos + i] = applyPostProcessing(osc1Segment[(size_t)i]);
+        }
+        
+        sampleCounter += static_cast<uint32_t>(run);
+        pos += run;
+    }
 }
 
-void Voice::calculateEnvelopeValues() noexcept
+void Voice::processControlRate() noexcept
 {
-    dcwVal1 = dcwEnvelope1.getNextValue();
-    dcaVal1 = dcaEnvelope1.getNextValue();
-    
-    dcwVal2 = dcwEnvelope2.getNextValue();
-    dcaVal2 = dcaEnvelope2.getNextValue();
+    // Standalone tick (renderBlock / renderNextSample): the batched evaluation with one lane
+    ControlRateBuffers<1> buffers;
+    gatherControlInputs(buffers.lanes(), 0);
+    buffers.lanes().process(1);
+    applyControlOutputs(buffers.lanes(), 0);
 }
-    
-void Voice::calculateLFOAndVibrato() noexcept
+
+void Voice::gatherControlInputs(const ControlRateLanes& lanes, int lane) noexcept
 {
-    // LFO
-    vibratoMod = 1.0f;
+    controlTickPending = false;
+    
+    // Envelopes (a line that is not sounding keeps its envelopes frozen)
+    const bool on1 = line1On(), on2 = line2On();
+    const float dcwEnv1 = on1 ? dcwEnvelope1.getNextValue() : 0.0f;
+    const float dcwEnv2 = on2 ? dcwEnvelope2.getNextValue() : 0.0f;
+    lanes.dcwEnv[0][lane] = dcwEnv1;
+    lanes.dcwEnv[1][lane] = dcwEnv2;
+    lanes.dcaEnv[0][lane] = on1 ? dcaEnvelope1.getNextValue() : 0.0f;
+    lanes.dcaEnv[1][lane] = on2 ? dcaEnvelope2.getNextValue() : 0.0f;
+    lanes.pitchEnv[0][lane] = pitchEnvelope1.getCurrentValue();
+    lanes.pitchEnv[1][lane] = pitchEnvelope2.getCurrentValue();
+    
+    // LFO (vibrato accumulates in the log2 pitch offset)
+    float pitchOffset = 0.0f;
     float wheelVib = smoothedMatrix.wheelToVibrato.getNextValue();
     float atVib = smoothedMatrix.atToVibrato.getNextValue();
     float totalVibDepth = vibratoDepth + (modWheel * wheelVib) + (aftertouch * atVib);
@@ -360,20 +433,17 @@ void Voice::calculateLFOAndVibrato() noexcept
     }
 
     if (totalVibDepth > 0.001f) {
-        vibratoMod = deterministicExp2(lfoModule.getNextValue() * totalVibDepth); 
+        pitchOffset = lfoModule.getNextValue() * totalVibDepth; 
     }
-}
-
-void Voice::calculateDCWModulation() noexcept
-{
+    
     // DCW Key Tracking & Modulation
     float ktOffset = 0.0f;
     float ktDcw = smoothedMatrix.keyTrackDcw.getNextValue();
     if (matrix.kfDcw != 0) // FIX or VAR
     {
         // Use authentic hardware curve
-        // Pass current DCW env value (average of both lines for now) to affect curvature
-        float avgEnv = (dcwVal1 + dcwVal2) * 0.5f;
+        // Pass current DCW env value (average of the sounding lines) to affect curvature
+        float avgEnv = (on1 && on2) ? (dcwEnv1 + dcwEnv2) * 0.5f : dcwEnv1 + dcwEnv2;
         ktOffset = HardwareConstants::getAuthenticDCWKeytrack(currentNote, avgEnv) * ktDcw;
     }
     
@@ -382,85 +452,152 @@ void Voice::calculateDCWModulation() noexcept
     float atDcw = smoothedMatrix.atToDcw.getNextValue();
 
     float modDcw = (currentVelocity * veloDcw) + (modWheel * wheelDcw) + (aftertouch * atDcw);
-    // Apply Velocity Sensitivity to DCW Envelope Output
-    dcwVal1 = juce::jlimit(0.0f, 0.99f, (dcwVal1 * velModDcw) + ktOffset + modDcw);
-    dcwVal2 = juce::jlimit(0.0f, 0.99f, (dcwVal2 * velModDcw) + ktOffset + modDcw);
-}
+    // Velocity Sensitivity scales the DCW Envelope Output
+    lanes.dcwScale[lane] = velModDcw;
+    lanes.dcwOffset[lane] = ktOffset + modDcw;
 
-void Voice::calculateDCAModulation() noexcept
-{
     // DCA Velocity Sensitivity & Key Follow
-    if (matrix.kfDca != 0)
-    {
-        // Key Follow for DCA shortens decay on high notes (simulated as slight level reduction here)
-        float kfDcaOffset = (currentNote - 60) * HardwareConstants::KEYTRACK_DCA_OFFSET;
-        dcaVal1 = juce::jlimit(0.0f, 1.0f, dcaVal1 + kfDcaOffset);
-        dcaVal2 = juce::jlimit(0.0f, 1.0f, dcaVal2 + kfDcaOffset);
-    }
-
+    // Key Follow for DCA shortens decay on high notes (simulated as slight level reduction here)
+    lanes.dcaOffset[lane] = (matrix.kfDca != 0) ? (currentNote - 60) * HardwareConstants::KEYTRACK_DCA_OFFSET : 0.0f;
+    
     float vDca = smoothedMatrix.veloToDca.getNextValue();
     // matrix.veloToDca: 0 = fixed level, 1 = full velocity range
-    float veloDca = 1.0f - vDca + (currentVelocity * vDca);
-    dcaVal1 *= veloDca;
-    dcaVal2 *= veloDca;
-}
-
-void Voice::calculatePitchModulation() noexcept
-{    
-    float pEnvVal1 = pitchEnvelope1.getCurrentValue();
-    float pEnvVal2 = pitchEnvelope2.getCurrentValue();
-    
-    // Pitch mod (±12 semitones) - Deterministic cross-platform
-    pitchMod1 = deterministicExp2((pEnvVal1 - 0.5f) * 2.0f); 
-    pitchMod2 = deterministicExp2((pEnvVal2 - 0.5f) * 2.0f);
+    lanes.dcaScale[lane] = 1.0f - vDca + (currentVelocity * vDca);
 
-     // Custom Key Tracking for Pitch (DCO Key Follow)
-    float pitchKT = 1.0f;
+    // Custom Key Tracking for Pitch (DCO Key Follow), in octaves
     float ktPitch = smoothedMatrix.keyTrackPitch.getNextValue();
     if (matrix.kfDco != 0) // FIX or VAR
     {
          if (std::abs(ktPitch - 1.0f) > 0.001f) {
             float dist = (currentNote - 60) / 12.0f;
-            pitchKT = std::exp2(dist * (ktPitch - 1.0f));
+            pitchOffset += dist * (ktPitch - 1.0f);
         }
     }
     else
     {
         // OFF mode: Pitch is fixed at center note? 
         // Real hardware "OFF" for DCO usually means 0 tracking (fixed pitch).
-        float dist = (60 - currentNote) / 12.0f;
-        pitchKT = std::exp2(dist); // Cancels out the currentNote tracking
+        pitchOffset += (60 - currentNote) / 12.0f; // Cancels out the currentNote tracking
     }
-
-    // Cache static factors (Master Tune, Pitch Bend)
-    float globalMod = pitchBendFactor * masterTuneFactor * pitchKT;
     
-    // Target Frequencies (Control Rate)
+    // Glide (Control Rate)
     if (glideTime > 0.001f && currentFrequency != targetFrequency) {
-        float currentLog = std::log2(currentFrequency);
-        float targetLog = std::log2(targetFrequency);
+        float currentLog = Utils::FastMath::log2(currentFrequency);
+        float targetLog = Utils::FastMath::log2(targetFrequency);
         float diffLog = targetLog - currentLog;
-        float step = (8.0f / (float)sampleRate) / (glideTime + 0.001f);
+        float step = (static_cast<float>(controlDivider) / (float)sampleRate) / (glideTime + 0.001f);
         
         if (std::abs(diffLog) <= step) {
             currentFrequency = targetFrequency;
         } else {
             currentLog += (diffLog > 0 ? step : -step);
-            currentFrequency = std::exp2(currentLog);
+            currentFrequency = Utils::FastMath::exp2(currentLog);
         }
     } else {
         currentFrequency = targetFrequency;
     }
 
-    cachedFreq1 = currentFrequency * pitchMod1 * vibratoMod * globalMod * velModPitch;
-    cachedFreq2 = currentFrequency * pitchMod2 * vibratoMod * globalMod * velModPitch * currentDetuneFactor.getNextValue();
+    // Static factors (Master Tune, Pitch Bend)
+    lanes.pitchOffset[lane] = pitchOffset;
+    lanes.baseFrequency[lane] = currentFrequency * pitchBendFactor * masterTuneFactor * velModPitch;
+    lanes.detune[lane] = currentDetuneFactor.getNextValue();
+    
+    // Filter cutoffs as f / fs (looked up to TPT gains in process())
+    const float invSampleRate = 1.0f / static_cast<float>(sampleRate);
+    lanes.lpfCutoff[lane] = lpfCutoff * invSampleRate;
+    lanes.hpfCutoff[lane] = hpfCutoff * invSampleRate;
+}
+
+void Voice::applyControlOutputs(const ControlRateLanes& lanes, int lane) noexcept
+{
+    // DCW/DCA ramp linearly from where they are to the new targets over one control
+    // period instead of stepping, so the audio-rate kernels never see a zipper edge
+    const float invDivider = 1.0f / static_cast<float>(controlDivider);
+    const float retire = trackSilence(lanes.dca[0][lane], lanes.dca[1][lane]);
+    dcwStep1 = (lanes.dcw[0][lane] - dcwVal1) * invDivider;
+    dcwStep2 = (lanes.dcw[1][lane] - dcwVal2) * invDivider;
+    dcaStep1 = (lanes.dca[0][lane] * retire - dcaVal1) * invDivider;
+    dcaStep2 = (lanes.dca[1][lane] * retire - dcaVal2) * invDivider;
+
+    cachedFreq1 = lanes.frequency[0][lane];
+    cachedFreq2 = lanes.frequency[1][lane];
+    
+    const DSP::SVFTargets filterTargets { lanes.lowG[lane], lpfK, lanes.highG[lane] };
+    if (filterPrimed)
+    {
+        filter.setTargets(filterTargets, controlDivider);
+    }
+    else
+    {
+        filter.snapTo(filterTargets);
+        filterPrimed = true;
+    }
+}
+
+float Voice::trackSilence(float dca1, float dca2) noexcept
+{
+    if (retiring)
+    {
+        // The previous control period ramped the DCA to zero: the voice is done
+        if (retireGain <= 0.0f)
+        {
+            finishRetirement();
+            return 0.0f;
+        }
+        
+        retireGain = std::max(0.0f, retireGain - retireGainStep);
+        return retireGain;
+    }
+    
+    // Only released voices: CZ envelopes may dip to zero and rise again before the sustain point
+    if (silenceFloorGain <= 0.0f || !isReleasing())
+    {
+        silentTicks = 0;
+        return 1.0f;
+    }
+    
+    // Peak output estimate: full-scale oscillators through the same gain staging as the audio
+    // path (the soft clip and line mix are linear this far down)
+    const float lines = (line1On() ? std::abs(dca1) * osc1Level.getTargetValue() : 0.0f)
+                      + (line2On() ? std::abs(dca2) * osc2Level.getTargetValue() : 0.0f);
+    const float peak = lines * velModAmp * HardwareConstants::SOFT_CLIP_DRIVE * currentVelocity
+                     * masterVolume.getTargetValue() * HardwareConstants::MASTER_HEADROOM_GAIN;
+    
+    silentTicks = (peak < silenceFloorGain) ? silentTicks + 1 : 0;
+    if (silentTicks < silenceHoldTicks)
+        return 1.0f;
+    
+    // Short fade rather than a cut, in case the floor is set high enough to hear
+    retiring = true;
+    retireGainStep = 1.0f / std::max(1.0f, std::round(HardwareConstants::SILENCE_FADE_SECONDS
+                                                      * static_cast<float>(sampleRate) / static_cast<float>(controlDivider)));
+    retireGain = 1.0f - retireGainStep;
+    return retireGain;
+}
+
+void Voice::finishRetirement() noexcept
+{
+    // Ending the DCA envelopes is what makes isActive() false
+    dcaEnvelope1.reset();
+    dcaEnvelope2.reset();
+    dcaVal1 = dcaVal2 = 0.0f;
+    
+    retiring = false;
+    retireGain = 1.0f;
+    silentTicks = 0;
+    silenceRetired = true;
 }
 
 float Voice::renderOscillators() noexcept
 {
-    // Phase 5.1: Oversampling Implementation
-    // If oversamplingFactor > 1, we render multiple sub-samples and average them
-    // This reduces aliasing at the cost of CPU
+    if (oversamplingFactor <= 1 && isSingleLine())
+    {
+        auto line = soloLine();
+        line.osc.setFrequency(line.frequency);
+        const float sample = line.osc.renderNextSample(line.dcw);
+        advanceDcwRamps(1);
+        return mixSoloLine(line, sample);
+    }
     
     if (oversamplingFactor <= 1)
     {
@@ -472,72 +609,209 @@ float Voice::renderOscillators() noexcept
         float osc1Sample = osc1.renderNextSample(dcwVal1, &osc1Wrapped);
         if (isHardSyncEnabled && osc1Wrapped) osc2.reset();
         float osc2Sample = osc2.renderNextSample(dcwVal2);
+        advanceDcwRamps(1);
         
-        if (isRingModEnabled) {
-            osc2Sample = osc1Sample * osc2Sample;
-        } else if (isNoiseModEnabled) {
-             // Authentic CZ-101 Noise Mod: It's technically Phase Modulation of Noise? 
-             // Or simply Noise replaces the carrier?
-             // "Noise Mod" on CZ modulates the *phase* of the noise source by Osc 1?
-             // Or modulates Osc 1 Amplitude by Noise?
-             // Multiplicative (AM) of Noise * Osc1 creates sidebands.
-             // If Osc2 Level is 0 in patch, we hear nothing. 
-             // The user says "doesn't sound right".
-             // Let's implement a safe audible noise mix for now:
-             // Mix Noise with Osc 1, or modulate Osc 2 phase with Noise.
-             // Simplest "Good Sounding" fix: Ring Modulate Noise with Osc 1 (AM).
-             float noise = (noiseGen.nextFloat() * 2.0f - 1.0f);
-             osc2Sample = osc1Sample * noise + noise * 0.5f; // Add some raw noise to ensure output
-        }
-        
-        float out1 = osc1Sample * osc1Level.getNextValue() * dcaVal1 * velModAmp;
-        float out2 = osc2Sample * osc2Level.getNextValue() * dcaVal2 * velModAmp;
-        
-        return HardwareConstants::mixLines(out1, out2);
+        return mixOscillatorOutputs(osc1Sample, osc2Sample);
     }
-    else
+    
+    float result = 0.0f;
+    renderOversampledSegment(&result, 1);
+    return result;
+}
+
+void Voice::setOversamplingFactor(int factor) noexcept
+{
+    factor = (factor >= 4) ? 4 : (factor >= 2 ? 2 : 1);
+    if (factor == oversamplingFactor) return;
+    
+    oversamplingFactor = factor;
+    decimator.setFactor(factor);
+    osc1.setSampleRate(sampleRate * factor);
+    osc2.setSampleRate(sampleRate * factor);
+}
+
+void Voice::renderOversampledSegment(float* rawOut, int numSamples) noexcept
+{
+    // Phase 5.1: Oversampled path (2x or 4x)
+    // Both lines and the line mixer (tanh) run at factor * sampleRate; levels and the DCA
+    // ramp step once per output sample, as in the 1x path. The half-band chain then removes
+    // everything above the base Nyquist before dropping back to the base rate.
+    const int hiSamples = numSamples * oversamplingFactor;
+    const float invFactor = 1.0f / static_cast<float>(oversamplingFactor);
+    
+    if (isSingleLine())
     {
-        // Oversampled path (2x or 4x)
-        osc1.setFrequency(cachedFreq1);
-        osc2.setFrequency(cachedFreq2);
-        
-        float accumulator = 0.0f;
+        auto line = soloLine();
+        line.osc.setFrequency(line.frequency);
+        line.osc.renderBlock(osc1Hi.data(), hiSamples, line.dcw, line.dcwStep * invFactor);
+        advanceDcwRamps(numSamples);
         
-        // Render N sub-samples
-        for (int i = 0; i < oversamplingFactor; ++i)
+        for (int i = 0; i < numSamples; ++i)
         {
-            bool osc1Wrapped = false;
-            float osc1Sample = osc1.renderNextSample(dcwVal1, &osc1Wrapped);
-            if (isHardSyncEnabled && osc1Wrapped) osc2.reset();
-            float osc2Sample = osc2.renderNextSample(dcwVal2);
+            const float gain = line.level.getNextValue() * line.dca * velModAmp;
+            line.dca += line.dcaStep;
             
-            if (isRingModEnabled) {
-                osc2Sample = osc1Sample * osc2Sample;
-            } else if (isNoiseModEnabled) {
-                 float noise = (noiseGen.nextFloat() * 2.0f - 1.0f);
-                 osc2Sample = osc1Sample * noise; 
-            }
-            
-            // Note: We use the same envelope/level values for all sub-samples
-            // This is a simplification but works well for anti-aliasing
-            float out1 = osc1Sample * osc1Level.getCurrentValue() * dcaVal1 * velModAmp;
-            float out2 = osc2Sample * osc2Level.getCurrentValue() * dcaVal2 * velModAmp;
-            
-            accumulator += HardwareConstants::mixLines(out1, out2);
+            for (int k = i * oversamplingFactor; k < (i + 1) * oversamplingFactor; ++k)
+                mixHi[(size_t)k] = HardwareConstants::mixLines(osc1Hi[(size_t)k] * gain, 0.0f);
         }
         
-        // Average (boxcar filter / decimation)
-        float result = accumulator / (float)oversamplingFactor;
-        
-        // Advance smoothed values once per output sample
-        osc1Level.getNextValue();
-        osc2Level.getNextValue();
+        decimator.process(mixHi.data(), rawOut, numSamples);
+        return;
+    }
+    
+    osc1.setFrequency(cachedFreq1);
+    osc2.setFrequency(cachedFreq2);
+    osc1.renderBlock(osc1Hi.data(), hiSamples, dcwVal1, dcwStep1 * invFactor, nullptr, syncHi.data());
+    osc2.renderBlock(osc2Hi.data(), hiSamples, dcwVal2, dcwStep2 * invFactor, isHardSyncEnabled ? syncHi.data() : nullptr, nullptr);
+    advanceDcwRamps(numSamples);
+    
+    for (int i = 0; i < numSamples; ++i)
+    {
+        const float gain1 = osc1Level.getNextValue() * dcaVal1 * velModAmp;
+        const float gain2 = osc2Level.getNextValue() * dcaVal2 * velModAmp;
+        dcaVal1 += dcaStep1;
+        dcaVal2 += dcaStep2;
         
-        return result;
+        for (int k = i * oversamplingFactor; k < (i + 1) * oversamplingFactor; ++k)
+        {
+            const float osc1Sample = osc1Hi[(size_t)k];
+            const float osc2Sample = modulateLine2(osc1Sample, osc2Hi[(size_t)k]);
+            mixHi[(size_t)k] = HardwareConstants::mixLines(osc1Sample * gain1, osc2Sample * gain2);
+        }
     }
+    
+    decimator.process(mixHi.data(), rawOut, numSamples);
+}
+
+float Voice::modulateLine2(float osc1Sample, float osc2Sample) noexcept
+{
+    if (isRingModEnabled) {
+        osc2Sample = osc1Sample * osc2Sample;
+    } else if (isNoiseModEnabled) {
+         // Authentic CZ-101 Noise Mod: It's technically Phase Modulation of Noise? 
+         // Or simply Noise replaces the carrier?
+         // "Noise Mod" on CZ modulates the *phase* of the noise source by Osc 1?
+         // Or modulates Osc 1 Amplitude by Noise?
+         // Multiplicative (AM) of Noise * Osc1 creates sidebands.
+         // If Osc2 Level is 0 in patch, we hear nothing. 
+         // The user says "doesn't sound right".
+         // Let's implement a safe audible noise mix for now:
+         // Mix Noise with Osc 1, or modulate Osc 2 phase with Noise.
+         // Simplest "Good Sounding" fix: Ring Modulate Noise with Osc 1 (AM).
+         float noise = (noiseGen.nextFloat() * 2.0f - 1.0f);
+         osc2Sample = osc1Sample * noise + noise * 0.5f; // Add some raw noise to ensure output
+    }
+    return osc2Sample;
+}
+
+float Voice::mixOscillatorOutputs(float osc1Sample, float osc2Sample) noexcept
+{
+    osc2Sample = modulateLine2(osc1Sample, osc2Sample);
+    
+    float out1 = osc1Sample * osc1Level.getNextValue() * dcaVal1 * velModAmp;
+    float out2 = osc2Sample * osc2Level.getNextValue() * dcaVal2 * velModAmp;
+    dcaVal1 += dcaStep1;
+    dcaVal2 += dcaStep2;
+    
+    return HardwareConstants::mixLines(out1, out2);
+}
+
+Voice::SoloLine Voice::soloLine() noexcept
+{
+    if (lineSelect == LineSelect::Line2)
+        return { osc2, cachedFreq2, dcwVal2, dcwStep2, dcaVal2, dcaStep2, osc2Level };
+    return { osc1, cachedFreq1, dcwVal1, dcwStep1, dcaVal1, dcaStep1, osc1Level };
+}
+
+float Voice::mixSoloLine(SoloLine line, float sample) noexcept
+{
+    // Same gain staging and summing-amp saturation as the two-line mix, with the other line silent
+    const float out = sample * line.level.getNextValue() * line.dca * velModAmp;
+    line.dca += line.dcaStep;
+    return HardwareConstants::mixLines(out, 0.0f);
+}
+
+void Voice::beginBankSegment(DSP::OscLineParams& line1, DSP::OscLineParams& line2) noexcept
+{
+    // Same clamp as PhaseDistOscillator::setFrequency
+    const float invSampleRate = 1.0f / static_cast<float>(sampleRate);
+    
+    if (isSingleLine())
+    {
+        const auto line = soloLine();
+        line1.phase = line.osc.getPhase();
+        line1.phaseIncrement = std::clamp(line.frequency, 20.0f, 20000.0f) * invSampleRate;
+        line1.dcw = line.dcw;
+        line1.dcwStep = line.dcwStep;
+        line1.first = line.osc.getFirstWaveform();
+        line1.second = line.osc.getSecondWaveform();
+        line1.syncToLine1 = false;
+        line2.syncToLine1 = false;
+        return;
+    }
+    
+    line1.phase = osc1.getPhase();
+    line1.phaseIncrement = std::clamp(cachedFreq1, 20.0f, 20000.0f) * invSampleRate;
+    line1.dcw = dcwVal1;
+    line1.dcwStep = dcwStep1;
+    line1.first = osc1.getFirstWaveform();
+    line1.second = osc1.getSecondWaveform();
+    line1.syncToLine1 = false;
+    
+    line2.phase = osc2.getPhase();
+    line2.phaseIncrement = std::clamp(cachedFreq2, 20.0f, 20000.0f) * invSampleRate;
+    line2.dcw = dcwVal2;
+    line2.dcwStep = dcwStep2;
+    line2.first = osc2.getFirstWaveform();
+    line2.second = osc2.getSecondWaveform();
+    line2.syncToLine1 = isHardSyncEnabled;
+}
+
+void Voice::storeBankPhases(float phase1, float phase2) noexcept
+{
+    if (isSingleLine())
+    {
+        soloLine().osc.setPhase(phase1); // The bank rendered Line 1 only
+        return;
+    }
+    
+    osc1.setPhase(phase1);
+    osc2.setPhase(phase2);
+}
+
+void Voice::renderBankSegment(const float* osc1Out, const float* osc2Out, int oscStride,
+                              float* filterIn, int filterStride, int numSamples) noexcept
+{
+    advanceDcwRamps(numSamples); // The bank applied the ramp to its own DCW lanes
+    
+    if (isSingleLine())
+    {
+        const auto line = soloLine();
+        for (int i = 0; i < numSamples; ++i)
+            filterIn[i * filterStride] = applyPreFilter(mixSoloLine(line, osc1Out[i * oscStride]));
+    }
+    else
+    {
+        for (int i = 0; i < numSamples; ++i)
+            filterIn[i * filterStride] = applyPreFilter(mixOscillatorOutputs(osc1Out[i * oscStride], osc2Out[i * oscStride]));
+    }
+    
+    sampleCounter += static_cast<uint32_t>(numSamples);
+}
+
+void Voice::finishBankSegment(const float* filtered, int filterStride, float* out, int numSamples) noexcept
+{
+    for (int i = 0; i < numSamples; ++i)
+        out[i] = applyOutputGain(filtered[i * filterStride]);
 }
 
 float Voice::applyPostProcessing(float rawMix) noexcept
+{
+    // Modern Filter Processing (Phase 7)
+    return applyOutputGain(filter.processSample(applyPreFilter(rawMix)));
+}
+
+float Voice::applyPreFilter(float rawMix) noexcept
 {
     // Phase 9: Authentic Hardware Noise
     if (hardwareNoiseEnabled) {
@@ -548,13 +822,12 @@ float Voice::applyPostProcessing(float rawMix) noexcept
          rawMix += getAuthenticNoise(currentNote, dcwMix);
     }
 
-    // Optimization: Fast Tanh
-    float softClipped = fastTanh(rawMix * HardwareConstants::SOFT_CLIP_DRIVE);
-    
-    // Modern Filter Processing (Phase 7)
-    float filtered = lpf.processSample(softClipped);
-    filtered = hpf.processSample(filtered);
+    // Optimization: Fast Tanh (Utils::FastMath, saturates cleanly for any drive)
+    return Utils::FastMath::tanh(rawMix * HardwareConstants::SOFT_CLIP_DRIVE);
+}
 
+float Voice::applyOutputGain(float filtered) noexcept
+{
     float output = filtered * currentVelocity * masterVolume.getNextValue();
     
     // Phase 9: 12-bit DAC Compression Simulation
@@ -572,7 +845,7 @@ float Voice::applyPostProcessing(float rawMix) noexcept
 float Voice::midiNoteToFrequency(int midiNote) const noexcept
 {
     midiNote = juce::jlimit(0, 127, midiNote); 
-    return 440.0f * std::exp2((static_cast<float>(midiNote) - 69.0f) * 0.083333333f); // slightly faster than /12.0f
+    return 440.0f * Utils::FastMath::semitonesToRatio(static_cast<float>(midiNote) - 69.0f);
 }
 
 void Voice::setModulationMatrix(const ModulationMatrix& m) noexcept
@@ -614,72 +887,82 @@ float Voice::getAuthenticNoise(int note, float dcwLevel) noexcept
     return dacNoise + keyClick;
 }
 
-void Voice::applySnapshot(const ParameterSnapshot* s) noexcept
+void Voice::applySnapshot(const ParameterSnapshot* s, uint32_t sections) noexcept
 {
     if (!s) return;
     
     // Optimized Parameter Updates from Snapshot
-    // Only update smoothed targets, avoiding complex logic
+    // Only update smoothed targets, avoiding complex logic; sections that did not change are skipped
     
     // Oscillators
-    osc1.setWaveforms(static_cast<DSP::PhaseDistOscillator::CzWaveform>(s->dco1.wave1),
-                      static_cast<DSP::PhaseDistOscillator::CzWaveform>(s->dco1.wave2));
-    osc2.setWaveforms(static_cast<DSP::PhaseDistOscillator::CzWaveform>(s->dco2.wave1),
-                      static_cast<DSP::PhaseDistOscillator::CzWaveform>(s->dco2.wave2));
-                      
-    osc1Level.setTargetValue(s->dco1.level);
-    osc2Level.setTargetValue(s->dco2.level);
-    setOsc2DetuneHardware(s->dco2.octave, s->dco2.coarse, s->dco2.fine);
-    
-    // Flags
-    setHardSync(s->mod.detune == 1); 
-    setRingMod(s->lineMod.ring);
-    setNoiseMod(s->lineMod.noise);
+    if (sections & ParameterSnapshot::Oscillators)
+    {
+        osc1.setWaveforms(static_cast<DSP::PhaseDistOscillator::CzWaveform>(s->dco1.wave1),
+                          static_cast<DSP::PhaseDistOscillator::CzWaveform>(s->dco1.wave2));
+        osc2.setWaveforms(static_cast<DSP::PhaseDistOscillator::CzWaveform>(s->dco2.wave1),
+                          static_cast<DSP::PhaseDistOscillator::CzWaveform>(s->dco2.wave2));
+                          
+        osc1Level.setTargetValue(s->dco1.level);
+        osc2Level.setTargetValue(s->dco2.level);
+        setLineSelect(s->lineSelect);
+        setOsc2DetuneHardware(s->dco2.octave, s->dco2.coarse, s->dco2.fine);
+        
+        // Flags
+        setRingMod(s->lineMod.ring);
+        setNoiseMod(s->lineMod.noise);
+    }
     
     // Filter / DCW
     // Note: DCW/DCA Envelopes are usually triggered, but key follow/sustains are state.
 
-    // System
-    masterVolume.setTargetValue(s->system.masterVol);
-    masterTuneFactor = std::pow(2.0f, s->system.masterTune / 12.0f);
-    pitchBendFactor = std::pow(2.0f, (s->system.bendRange / 12.0f) * modWheel); // simplified
+    // System (master volume, LFO rate and depth arrive through setters: they follow host automation per block)
+    if (sections & ParameterSnapshot::System)
+    {
+        masterTuneFactor = Utils::FastMath::semitonesToRatio(s->system.masterTune);
+        pitchBendFactor = Utils::FastMath::semitonesToRatio(s->system.bendRange * modWheel); // simplified
+        hardwareNoiseEnabled = s->system.hardwareNoise;
+    }
     
     // Matrix
-    smoothedMatrix.veloToDcw.setTargetValue(s->mod.veloDcw);
-    smoothedMatrix.veloToDca.setTargetValue(s->mod.veloAmp);
-    smoothedMatrix.wheelToDcw.setTargetValue(s->mod.wheelToDcw);
-    smoothedMatrix.wheelToLfoRate.setTargetValue(s->mod.wheelToLfoRate);
-    smoothedMatrix.wheelToVibrato.setTargetValue(s->mod.wheelToVibrato);
-    smoothedMatrix.atToDcw.setTargetValue(s->mod.atToDcw);
-    smoothedMatrix.atToVibrato.setTargetValue(s->mod.atToVibrato);
-    
-    // Audit Fix [PITCH_FIX]: Correctly interpret Key Follow modes
-    // Modes: 0=OFF, 1=FIX, 2=VAR
-    matrix.kfDcw = s->mod.keyFollowDcw;
-    matrix.kfDca = s->mod.keyFollowAmp;
-    matrix.kfDco = s->mod.keyFollowDco;
-    
-    // amounts (Wait, were these amounts in snapshot?)
-    // Snapshot doesn't have explicit amounts for KF yet, assuming 1.0 (Standard Tracking) if ON.
-    smoothedMatrix.keyTrackDcw.setTargetValue(matrix.kfDcw > 0 ? 1.0f : 0.0f);
-    smoothedMatrix.keyTrackPitch.setTargetValue(matrix.kfDco > 0 ? 1.0f : 0.0f);
-
-    hardwareNoiseEnabled = s->system.hardwareNoise;
+    if (sections & ParameterSnapshot::Modulation)
+    {
+        setHardSync(s->mod.detune == 1); 
+        
+        smoothedMatrix.veloToDcw.setTargetValue(s->mod.veloDcw);
+        smoothedMatrix.veloToDca.setTargetValue(s->mod.veloAmp);
+        smoothedMatrix.wheelToDcw.setTargetValue(s->mod.wheelToDcw);
+        smoothedMatrix.wheelToLfoRate.setTargetValue(s->mod.wheelToLfoRate);
+        smoothedMatrix.wheelToVibrato.setTargetValue(s->mod.wheelToVibrato);
+        smoothedMatrix.atToDcw.setTargetValue(s->mod.atToDcw);
+        smoothedMatrix.atToVibrato.setTargetValue(s->mod.atToVibrato);
+        
+        // Audit Fix [PITCH_FIX]: Correctly interpret Key Follow modes
+        // Modes: 0=OFF, 1=FIX, 2=VAR
+        matrix.kfDcw = s->mod.keyFollowDcw;
+        matrix.kfDca = s->mod.keyFollowAmp;
+        matrix.kfDco = s->mod.keyFollowDco;
+        
+        // amounts (Wait, were these amounts in snapshot?)
+        // Snapshot doesn't have explicit amounts for KF yet, assuming 1.0 (Standard Tracking) if ON.
+        smoothedMatrix.keyTrackDcw.setTargetValue(matrix.kfDcw > 0 ? 1.0f : 0.0f);
+        smoothedMatrix.keyTrackPitch.setTargetValue(matrix.kfDco > 0 ? 1.0f : 0.0f);
+    }
     
     // LFO
-    lfoModule.setFrequency(s->lfo.rate);
-    lfoModule.setWaveform(static_cast<DSP::LFO::Waveform>(s->lfo.waveform));
-    vibratoDepth = s->lfo.depth;
-    lfoModule.setDelay(s->lfo.delay);
+    if (sections & ParameterSnapshot::Lfo)
+    {
+        lfoModule.setWaveform(static_cast<DSP::LFO::Waveform>(s->lfo.waveform));
+        lfoModule.setDelay(s->lfo.delay);
+    }
 
-    // Envelopes (Restoration)
+    // Envelopes (Restoration): 6 x 8 stages per voice, the bulk of this function when everything is applied
     auto applyEnv = [](DSP::MultiStageEnvelope& env, const Core::ParameterSnapshot::EnvParam& src) {
         for(int i=0; i<8; ++i) env.setStage(i, src.rates[i], src.levels[i]);
         env.setSustainPoint(src.sustain);
         env.setEndPoint(src.end);
     };
     
-    if (s->envelopes.dca1.sustain != -2) { // Check sentinel? Or just apply.
+    if ((sections & ParameterSnapshot::Envelopes) && s->envelopes.dca1.sustain != -2) { // Check sentinel? Or just apply.
         applyEnv(dcwEnvelope1, s->envelopes.dcw1);
         applyEnv(dcwEnvelope2, s->envelopes.dcw2);
         applyEnv(dcaEnvelope1, s->envelopes.dca1);
@@ -1,10 +1,14 @@
 #pragma once
 
 #include "../DSP/Oscillators/PhaseDistOsc.h"
+#include "../DSP/Oscillators/PhaseDistOscBank.h"
 #include "../DSP/Envelopes/MultiStageEnv.h"
 #include "../DSP/Modulation/LFO.h"
 #include "../DSP/VelocitySensitivityCurves.h" // [NEW]
-#include "../DSP/Filters/ResonantFilter.h" // [NEW]
+#include "../DSP/Filters/SVFFilter.h"
+#include "../DSP/Filters/HalfBandDecimator.h"
+#include "HardwareConstants.h"
+#include "../Utils/FastMath.h"
 #include <array>
 #include <cstdint>
 
@@ -13,6 +17,7 @@ namespace CZ101 {
 namespace Core {
 
 struct ParameterSnapshot; // Forward declaration (Correct Namespace)
+struct ControlRateLanes;
 
 /**
  * @brief Voice - Complete synthesizer voice
@@ -26,9 +31,41 @@ public:
     Voice();
     
     // Phase 7: Snapshot System
-    void applySnapshot(const ParameterSnapshot* snapshot) noexcept;
+    /** Apply the given ParameterSnapshot::Section bits only (default: everything) */
+    void applySnapshot(const ParameterSnapshot* snapshot, uint32_t sections = ~0u) noexcept;
     
     void setSampleRate(double sampleRate) noexcept;
+    
+    /**
+     * @brief Samples per control tick (power of two, 1..MAX_CONTROL_RATE_DIVIDER)
+     * Envelope, LFO and smoothing times do not depend on it; DCW/DCA are ramped between ticks.
+     */
+    void setControlRateDivider(int divider) noexcept;
+    int getControlRateDivider() const noexcept { return controlDivider; }
+    
+    /** CZ Line Select (patch PFLAG bits 0-1) */
+    enum class LineSelect { Line1 = 0, Line2 = 1, Line1Plus1 = 2, Line1Plus2 = 3 };
+    
+    /**
+     * @brief Choose which lines sound (0 = 1, 1 = 2, 2 = 1+1', 3 = 1+2')
+     * Single-line modes render one DCO/DCW/DCA chain only; the other line's
+     * oscillator, envelopes and mix are skipped entirely.
+     */
+    void setLineSelect(int index) noexcept;
+    LineSelect getLineSelect() const noexcept { return lineSelect; }
+    bool isSingleLine() const noexcept { return isSingleLine(lineSelect); }
+    static constexpr bool isSingleLine(LineSelect s) noexcept { return s == LineSelect::Line1 || s == LineSelect::Line2; }
+
+    /**
+     * @brief Silent-voice retirement (see HardwareConstants::SILENCE_FLOOR_DB)
+     * Once released, a voice whose estimated DCA output stays below floorDb (dBFS) for
+     * holdTicks consecutive control ticks fades out over SILENCE_FADE_SECONDS and ends.
+     * floorDb <= SILENCE_FLOOR_OFF_DB disables it.
+     */
+    void setSilenceRetirement(float floorDb, int holdTicks) noexcept;
+    
+    /** True if the voice ended through silence retirement since the last call (clears the flag) */
+    bool consumeSilenceRetired() noexcept { const bool r = silenceRetired; silenceRetired = false; return r; }
 
     // Audit Fix [2.2]: Model Selection
     void setModel(DSP::MultiStageEnvelope::Model newModel) noexcept;
@@ -83,9 +120,10 @@ public:
     void setMasterVolume(float level) noexcept;
 
     // --- Modern Filter (Phase 7) ---
-    void setFilterCutoff(float frequency) noexcept { lpf.setCutoff(frequency); }
-    void setFilterResonance(float reso) noexcept { lpf.setResonance(reso); }
-    void setHPF(float frequency) noexcept { hpf.setCutoff(frequency); }
+    // Targets only: coefficients follow at the next control tick (see DSP::SVFVoiceFilter)
+    void setFilterCutoff(float frequency) noexcept { lpfCutoff = std::clamp(frequency, 20.0f, 20000.0f); }
+    void setFilterResonance(float reso) noexcept { lpfK = 1.0f / std::clamp(reso, 0.1f, 10.0f); }
+    void setHPF(float frequency) noexcept { hpfCutoff = std::clamp(frequency, 20.0f, 20000.0f); }
     
     // --- Modulation Sources ---
     void setModWheel(float value) noexcept { modWheel = value; }
@@ -107,8 +145,9 @@ public:
     };
     void setModulationMatrix(const ModulationMatrix& m) noexcept;
     
-    // Phase 5.1: Oversampling
-    void setOversamplingFactor(int factor) noexcept { oversamplingFactor = juce::jlimit(1, 4, factor); }
+    // Phase 5.1: Oversampling (1x, 2x or 4x; oscillators run at the raised rate, half-band decimation back down)
+    void setOversamplingFactor(int factor) noexcept;
+    int getOversamplingFactor() const noexcept { return oversamplingFactor; }
     
     // Phase 9
     void setHardwareNoiseEnabled(bool enabled) noexcept { hardwareNoiseEnabled = enabled; }
@@ -158,8 +197,53 @@ public:
     // Rendering
     float renderNextSample() noexcept;
     
-    bool isActive() const noexcept { return dcaEnvelope1.isActive() || dcaEnvelope2.isActive(); }
-    bool isReleasing() const noexcept { return dcaEnvelope1.isReleased() || dcaEnvelope2.isReleased(); }
+    /**
+     * @brief Render a whole block for this voice (overwrites out[0..numSamples))
+     * 
+     * The control-rate tick is driven by the persistent sampleCounter, so the
+     * control divider grid stays phase-correct across block boundaries.
+     * Samples after the voice goes silent are zero-filled.
+     */
+    void renderBlock(float* out, int numSamples) noexcept;
+    
+    /** Put this voice's control tick on the manager's shared grid (before noteOn) */
+    void alignControlGrid(uint32_t sharedCounter) noexcept { sampleCounter = sharedCounter; }
+    
+    // --- Batched control rate (driven by VoiceManager, see ControlRateLanes) ---
+    /** @param isControlTick True on the shared control divider grid (a fresh note ticks immediately) */
+    bool needsControlTick(bool isControlTick) const noexcept { return isControlTick || controlTickPending; }
+    
+    /** Advance envelopes, LFO, smoothers and glide by one tick and write this voice's inputs into lane */
+    void gatherControlInputs(const ControlRateLanes& lanes, int lane) noexcept;
+    
+    /** Take the lane's evaluated targets: DCW/DCA ramp towards them over the next control period */
+    void applyControlOutputs(const ControlRateLanes& lanes, int lane) noexcept;
+    
+    // --- SoA Oscillator Bank path (driven by VoiceManager, see DSP::PhaseDistOscBank) ---
+    /**
+     * @brief Export both lines' oscillator state for the next segment (control tick already applied)
+     * Single-line: the sounding line goes in line1 and line2 is left unused.
+     */
+    void beginBankSegment(DSP::OscLineParams& line1, DSP::OscLineParams& line2) noexcept;
+    
+    /**
+     * @brief Mix bank oscillator output up to the filter input (overwrites filterIn, numSamples samples)
+     * @param osc1 Line 1 samples, oscStride apart
+     * @param osc2 Line 2 samples, oscStride apart
+     */
+    void renderBankSegment(const float* osc1, const float* osc2, int oscStride, float* filterIn, int filterStride, int numSamples) noexcept;
+    
+    /** Take back the phases the bank advanced to, so either path can render the next segment */
+    void storeBankPhases(float phase1, float phase2) noexcept;
+    
+    /** Output gain stage on the filter bank's result (overwrites out[0..numSamples)) */
+    void finishBankSegment(const float* filtered, int filterStride, float* out, int numSamples) noexcept;
+    
+    /** Filter coefficients, ramps and integrators (loaded into / stored from DSP::SVFFilterBank) */
+    DSP::SVFVoiceFilter::State& getFilterState() noexcept { return filter.getState(); }
+    
+    bool isActive() const noexcept { return (line1On() && dcaEnvelope1.isActive()) || (line2On() && dcaEnvelope2.isActive()); }
+    bool isReleasing() const noexcept { return (line1On() && dcaEnvelope1.isReleased()) || (line2On() && dcaEnvelope2.isReleased()); }
     int getCurrentNote() const noexcept { return currentNote; }
     int64_t getLastNoteOnTime() const noexcept { return lastNoteOnTime; }
     
@@ -168,9 +252,12 @@ private:
     DSP::PhaseDistOscillator osc1;
     DSP::PhaseDistOscillator osc2;
     
-    // Modern Filters
-    DSP::ResonantFilter lpf;
-    DSP::ResonantFilter hpf;
+    // Modern Filters: LPF -> HPF, coefficients ramped between control ticks
+    DSP::SVFVoiceFilter filter;
+    float lpfCutoff = 1000.0f;
+    float lpfK = 1.0f / 0.7f;
+    float hpfCutoff = 1000.0f;
+    bool filterPrimed = false; // Snap (no ramp) on the first tick after a sample rate change
     
     // Envelopes
     DSP::MultiStageEnvelope dcwEnvelope1;  // Timbre Line 1
@@ -229,20 +316,41 @@ private:
     float getAuthenticNoise(int note, float dcwLevel) noexcept;
     juce::Random noiseGen;
 
-    void setMasterBend(float semitones) noexcept { pitchBendFactor = std::exp2(semitones / 12.0f); }
+    void setMasterBend(float semitones) noexcept { pitchBendFactor = Utils::FastMath::semitonesToRatio(semitones); }
 
     int64_t lastNoteOnTime = 0; // [NEW] For Voice Stealing
     
     // Rendering Helpers (Refactoring Phase 8)
     void processControlRate() noexcept;
-    void calculateEnvelopeValues() noexcept;
-    void calculateLFOAndVibrato() noexcept;
-    void calculateDCWModulation() noexcept;
-    void calculateDCAModulation() noexcept;
-    void calculatePitchModulation() noexcept;
+    void updateControlRateTiming() noexcept;
+    void advanceDcwRamps(int numSamples) noexcept { dcwVal1 += dcwStep1 * numSamples; dcwVal2 += dcwStep2 * numSamples; }
+    
+    // Line Select
+    LineSelect lineSelect = LineSelect::Line1Plus1;
+    bool line1On() const noexcept { return lineSelect != LineSelect::Line2; }
+    bool line2On() const noexcept { return lineSelect != LineSelect::Line1; }
+    
+    // The sounding line of a single-line patch
+    struct SoloLine
+    {
+        DSP::PhaseDistOscillator& osc;
+        float frequency;
+        float& dcw;
+        float dcwStep;
+        float& dca;
+        float dcaStep;
+        juce::LinearSmoothedValue<float>& level;
+    };
+    SoloLine soloLine() noexcept;
+    float mixSoloLine(SoloLine line, float sample) noexcept;
 
     float renderOscillators() noexcept;
-    float applyPostProcessing(float rawMix) noexcept;
+    void renderOversampledSegment(float* rawOut, int numSamples) noexcept;
+    float modulateLine2(float osc1Sample, float osc2Sample) noexcept;
+    float mixOscillatorOutputs(float osc1Sample, float osc2Sample) noexcept;
+    float applyPostProcessing(float rawMix) noexcept; // applyPreFilter -> filter -> applyOutputGain
+    float applyPreFilter(float rawMix) noexcept;
+    float applyOutputGain(float filtered) noexcept;
 
     // Helper
     float midiNoteToFrequency(int midiNote) const noexcept;
@@ -252,6 +360,7 @@ private:
     
     // Phase 5.1: Oversampling
     int oversamplingFactor = 1; // 1x, 2x, or 4x
+    DSP::OversamplingDecimator decimator;
 
 private:
     // ===== ADSR STATE (NEW) =====
@@ -275,12 +384,33 @@ private:
     
     // === OPTIMIZATION STATE ===
     uint32_t sampleCounter = 0;
+    int controlDivider = HardwareConstants::CONTROL_RATE_DIVIDER;
+    bool controlTickPending = false; // Bank path: force a tick on the first segment after noteOn
+    
+    // Per-segment scratch for the waveform-specialised oscillator kernels (segments never exceed one control period)
+    static constexpr int MAX_SEGMENT = HardwareConstants::MAX_CONTROL_RATE_DIVIDER;
+    std::array<float, MAX_SEGMENT> osc1Segment {}, osc2Segment {}, syncSegment {};
+    
+    // Same, at the oversampled rate (mixHi is the decimator input)
+    static constexpr int MAX_SEGMENT_HI = MAX_SEGMENT * DSP::OversamplingDecimator::MAX_FACTOR;
+    std::array<float, MAX_SEGMENT_HI> osc1Hi {}, osc2Hi {}, syncHi {}, mixHi {};
     float cachedFreq1 = 440.0f;
     float cachedFreq2 = 440.0f;
     float dcwVal1 = 0.0f, dcaVal1 = 0.0f;
     float dcwVal2 = 0.0f, dcaVal2 = 0.0f;
-    float pitchMod1 = 1.0f, pitchMod2 = 1.0f;
-    float vibratoMod = 1.0f;
+    float dcwStep1 = 0.0f, dcaStep1 = 0.0f; // Per-sample ramp towards the last tick's targets
+    float dcwStep2 = 0.0f, dcaStep2 = 0.0f;
+    
+    // Silent-voice retirement (control rate)
+    float silenceFloorGain = 0.0f;   // Linear, from the dBFS floor (0 = off)
+    int silenceHoldTicks = HardwareConstants::SILENCE_HOLD_TICKS;
+    int silentTicks = 0;
+    bool retiring = false;
+    float retireGain = 1.0f;         // Fades to 0 over SILENCE_FADE_SECONDS once retiring
+    float retireGainStep = 1.0f;     // Per control tick
+    bool silenceRetired = false;
+    float trackSilence(float dca1, float dca2) noexcept;
+    void finishRetirement() noexcept;
 
     struct SmoothedModulationMatrix {
         juce::LinearSmoothedValue<float> veloToDcw { 0.0f };
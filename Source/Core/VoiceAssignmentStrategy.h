@@ -1,6 +1,7 @@
 #pragma once
 
 #include "Voice.h"
+#include <cstdint>
 #include <vector>
 #include <limits>
 
@@ -18,11 +19,12 @@ public:
     /**
      * @brief Finds the best voice to steal based on the strategy.
      * @param voices Pointer to voice array.
-     * @param numVoices Total capacity of voice array.
+     * @param activeIndices Indices of the live voices (VoiceManager's active set); only these are visited.
+     * @param numActive Number of entries in activeIndices.
      * @param maxActiveVoices Current polyphony limit.
      * @return Index of the voice to steal, or -1.
      */
-    virtual int findVoiceToSteal(const Voice* voices, int numVoices, int maxActiveVoices) = 0;
+    virtual int findVoiceToSteal(const Voice* voices, const int16_t* activeIndices, int numActive, int maxActiveVoices) = 0;
     
     // Optional hooks
     virtual void noteOn(int voiceIndex, int midiNote) {}
@@ -35,24 +37,19 @@ public:
 class OldestVoiceStrategy : public VoiceAssignmentStrategy
 {
 public:
-    int findVoiceToSteal(const Voice* voices, int numVoices, int maxActiveVoices) override
+    int findVoiceToSteal(const Voice* voices, const int16_t* activeIndices, int numActive, int /*maxActiveVoices*/) override
     {
         int oldestIndex = -1;
         int64_t oldestTime = std::numeric_limits<int64_t>::max();
         
-        // Scan only up to maxActiveVoices (assuming they are packed 0..max-1?)
-        // Wait, VoiceManager does NOT pack voices. It uses index 0..maxActiveVoices as the pool?
-        // VoiceManager::findFreeVoice scans 0..maxActiveVoices.
-        // So we should scan 0..maxActiveVoices.
-        
-        int limit = std::min(numVoices, maxActiveVoices);
-
-        for (int i = 0; i < limit; ++i)
+        // Live voices only: the active set holds indices below maxActiveVoices
+        for (int i = 0; i < numActive; ++i)
         {
-            if (voices[i].getLastNoteOnTime() < oldestTime)
+            const int v = activeIndices[i];
+            if (voices[v].getLastNoteOnTime() < oldestTime)
             {
-                oldestTime = voices[i].getLastNoteOnTime();
-                oldestIndex = i;
+                oldestTime = voices[v].getLastNoteOnTime();
+                oldestIndex = v;
             }
         }
 
@@ -0,0 +1,72 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <juce_core/juce_core.h>
+
+namespace CZ101 {
+namespace Core {
+
+/**
+ * @brief Fixed-capacity set of voice indices with O(1) insert, remove and lookup.
+ *
+ * Dense array of members plus a reverse position table (swap-remove), so
+ * VoiceManager can keep its active and free voices without scanning the pool.
+ * Iteration order is insertion order until a removal swaps the last member in.
+ */
+template <int Capacity>
+class VoiceIndexSet
+{
+public:
+    VoiceIndexSet() noexcept { clear(); }
+
+    void clear() noexcept
+    {
+        count = 0;
+        position.fill(-1);
+    }
+
+    bool contains(int index) const noexcept { return position[(size_t)index] >= 0; }
+
+    void add(int index) noexcept
+    {
+        jassert(index >= 0 && index < Capacity);
+        if (contains(index)) return;
+        position[(size_t)index] = (int16_t)count;
+        members[(size_t)count++] = (int16_t)index;
+    }
+
+    void remove(int index) noexcept
+    {
+        jassert(index >= 0 && index < Capacity);
+        const int pos = position[(size_t)index];
+        if (pos < 0) return;
+
+        const int last = members[(size_t)--count];
+        members[(size_t)pos] = (int16_t)last;
+        position[(size_t)last] = (int16_t)pos;
+        position[(size_t)index] = -1;
+    }
+
+    /** Removes and returns the most recently added member, or -1 if empty. */
+    int pop() noexcept
+    {
+        if (count == 0) return -1;
+        const int index = members[(size_t)(count - 1)];
+        remove(index);
+        return index;
+    }
+
+    int size() const noexcept { return count; }
+    bool isEmpty() const noexcept { return count == 0; }
+    int operator[](int i) const noexcept { return members[(size_t)i]; }
+    const int16_t* data() const noexcept { return members.data(); } // size() members, iteration order
+
+private:
+    std::array<int16_t, Capacity> members {};
+    std::array<int16_t, Capacity> position {};
+    int count = 0;
+};
+
+} // namespace Core
+} // namespace CZ101
@@ -1,22 +1,26 @@
 #include "VoiceManager.h"
 #include "CZ5000VoiceStrategy.h"
 #include "AudioThreadSnapshot.h" // Required for parameter snapshot definition
+#include "HardwareConstants.h"
 #include "../DSP/Modulation/LFO.h"
 #include <algorithm>
 
 namespace CZ101 {
 namespace Core {
 
-VoiceManager::VoiceManager()
+template <int MaxVoices>
+BasicVoiceManager<MaxVoices>::BasicVoiceManager()
 {
     // voices array is fixed size now
     // Default Strategy
     updateStrategy();
+    rebuildVoiceTracking();
 }
 
 #include "CZ5000VoiceStrategy.h" // [NEW]
 
-void VoiceManager::updateStrategy()
+template <int MaxVoices>
+void BasicVoiceManager<MaxVoices>::updateStrategy()
 {
     // [NEW] Phase 4.3: Initialize Strategy
     // Initialize with default (Oldest)
@@ -24,7 +28,8 @@ void VoiceManager::updateStrategy()
 }
 
 // Audit Fix [2.2]: Hardware Model Selection
-void VoiceManager::setSynthModel(DSP::MultiStageEnvelope::Model model) noexcept
+template <int MaxVoices>
+void BasicVoiceManager<MaxVoices>::setSynthModel(DSP::MultiStageEnvelope::Model model) noexcept
 {
     applyToAllVoices([model](Voice& v) { v.setModel(model); });
     
@@ -74,123 +79,308 @@ void VoiceManager::setSynthModel(DSP::MultiStageEnvelope::Model model) noexcept
     // But they have different polyphony.
     // We need to support `setVoiceLimit(int)` and call it from PluginProcessor.
     
-    if (model == DSP::MultiStageEnvelope::Model::CZ101) maxActiveVoices = 4;
-    else maxActiveVoices = 8; // Default for CZ-5000 hardware
+    if (model == DSP::MultiStageEnvelope::Model::CZ101) setActiveVoiceLimit(4);
+    else setActiveVoiceLimit(8); // Default for CZ-5000 hardware
 }
 
 // [NEW] Helper for PluginProcessor to override limit (e.g. for Modern Mode)
-void VoiceManager::setVoiceLimit(int limit) noexcept
+template <int MaxVoices>
+void BasicVoiceManager<MaxVoices>::setVoiceLimit(int limit) noexcept
 {
-    maxActiveVoices = std::min(limit, (int)MAX_VOICES);
+    setActiveVoiceLimit(limit);
 }
 
-void VoiceManager::setSampleRate(double sampleRate) noexcept
+template <int MaxVoices>
+void BasicVoiceManager<MaxVoices>::setActiveVoiceLimit(int limit) noexcept
 {
-    applyToAllVoices([sampleRate](Voice& v) { v.setSampleRate(sampleRate); });
-    referenceVoice.setSampleRate(sampleRate); // Audit Fix: Initialize reference voice to prevent div-by-zero
+    requestedVoiceLimit = limit;
+    limit = juce::jlimit(1, (int)MAX_VOICES, singleLineMode ? limit * 2 : limit);
+    if (limit == maxActiveVoices) return;
+    
+    maxActiveVoices = limit;
+    rebuildVoiceTracking();
+}
+
+// Rare path (polyphony change / construction): rescan once so every event afterwards is O(1)
+template <int MaxVoices>
+void BasicVoiceManager<MaxVoices>::rebuildVoiceTracking() noexcept
+{
+    activeVoices.clear();
+    freeVoices.clear();
+    noteToVoice.fill(-1);
+    
+    // Push in reverse so pop() hands out the lowest index first
+    for (int i = maxActiveVoices - 1; i >= 0; --i)
+    {
+        if (voices[i].isActive()) continue;
+        freeVoices.add(i);
+    }
+    
+    for (int i = 0; i < maxActiveVoices; ++i)
+    {
+        if (!voices[i].isActive()) continue;
+        activeVoices.add(i);
+        const int note = voices[i].getCurrentNote();
+        if (note >= 0 && note < NUM_MIDI_NOTES) noteToVoice[note] = (int16_t)i;
+    }
+}
+
+template <int MaxVoices>
+void BasicVoiceManager<MaxVoices>::assignVoice(int voiceIndex, int midiNote) noexcept
+{
+    // Stolen voice: drop its previous note mapping
+    const int previousNote = voices[voiceIndex].getCurrentNote();
+    if (previousNote >= 0 && previousNote < NUM_MIDI_NOTES && noteToVoice[previousNote] == voiceIndex)
+        noteToVoice[previousNote] = -1;
+    
+    freeVoices.remove(voiceIndex);
+    activeVoices.add(voiceIndex);
+    if (midiNote >= 0 && midiNote < NUM_MIDI_NOTES) noteToVoice[midiNote] = (int16_t)voiceIndex;
 }
 
-void VoiceManager::setOsc1Waveforms(int fIdx, int sIdx) noexcept
+// Voices end on their own (DCA envelope finished); move them back to the free list after rendering
+template <int MaxVoices>
+void BasicVoiceManager<MaxVoices>::retireFinishedVoices() noexcept
+{
+    for (int i = activeVoices.size() - 1; i >= 0; --i)
+    {
+        const int v = activeVoices[i];
+        if (voices[v].isActive()) continue;
+        
+        if (voices[v].consumeSilenceRetired())
+            ++silenceRetiredCount;
+        
+        activeVoices.remove(v);
+        freeVoices.add(v);
+        // noteToVoice is kept: a retrigger of the same note reuses this voice (see findVoicePlayingNote)
+    }
+}
+
+template <int MaxVoices>
+void BasicVoiceManager<MaxVoices>::setSampleRate(double sampleRate) noexcept
+{
+    baseSampleRate = sampleRate;
+    voiceSampleRate = isMixBusOversampling() ? sampleRate * oversamplingFactor : sampleRate;
+    applyToAllVoices([rate = voiceSampleRate](Voice& v) { v.setSampleRate(rate); });
+    referenceVoice.setSampleRate(voiceSampleRate); // Audit Fix: Initialize reference voice to prevent div-by-zero
+    arpeggiator.setSampleRate(sampleRate);
+    mixBusDecimator.reset();
+}
+
+template <int MaxVoices>
+void BasicVoiceManager<MaxVoices>::setControlRateDivider(int divider) noexcept
+{
+    applyToAllVoices([divider](Voice& v) { v.setControlRateDivider(divider); });
+    controlDivider = referenceVoice.getControlRateDivider(); // Voice normalises to a power of two
+}
+
+template <int MaxVoices>
+void BasicVoiceManager<MaxVoices>::setOsc1Waveforms(int fIdx, int sIdx) noexcept
 {
     auto f = static_cast<DSP::PhaseDistOscillator::CzWaveform>(fIdx);
     auto s = static_cast<DSP::PhaseDistOscillator::CzWaveform>(sIdx);
     applyToAllVoices([f, s](Voice& v) { v.setOsc1Waveforms(f, s); });
 }
 
-void VoiceManager::setOsc1Level(float level) noexcept
+template <int MaxVoices>
+void BasicVoiceManager<MaxVoices>::setOsc1Level(float level) noexcept
 {
     applyToAllVoices([level](Voice& v) { v.setOsc1Level(level); });
 }
 
-void VoiceManager::setOsc2Waveforms(int fIdx, int sIdx) noexcept
+template <int MaxVoices>
+void BasicVoiceManager<MaxVoices>::setOsc2Waveforms(int fIdx, int sIdx) noexcept
 {
     auto f = static_cast<DSP::PhaseDistOscillator::CzWaveform>(fIdx);
     auto s = static_cast<DSP::PhaseDistOscillator::CzWaveform>(sIdx);
     applyToAllVoices([f, s](Voice& v) { v.setOsc2Waveforms(f, s); });
 }
 
-void VoiceManager::setOsc2Level(float level) noexcept
+template <int MaxVoices>
+void BasicVoiceManager<MaxVoices>::setOsc2Level(float level) noexcept
 {
     applyToAllVoices([level](Voice& v) { v.setOsc2Level(level); });
 }
 
-void VoiceManager::setOsc2Detune(float cents) noexcept { applyToAllVoices([cents](Voice& v) { v.setOsc2Detune(cents); }); }
+template <int MaxVoices>
+void BasicVoiceManager<MaxVoices>::setOsc2Detune(float cents) noexcept { applyToAllVoices([cents](Voice& v) { v.setOsc2Detune(cents); }); }
 
-void VoiceManager::setOsc2DetuneHardware(int oct, int coarse, int fineCents) noexcept 
+template <int MaxVoices>
+void BasicVoiceManager<MaxVoices>::setOsc2DetuneHardware(int oct, int coarse, int fineCents) noexcept 
 { 
     applyToAllVoices([oct, coarse, fineCents](Voice& v) { v.setOsc2DetuneHardware(oct, coarse, fineCents); }); 
 }
 
-void VoiceManager::setDCWAttack(float s) noexcept { applyToAllVoices([s](Voice& v){ v.setDCWAttack(s); }); }
-void VoiceManager::setDCWDecay(float s) noexcept { applyToAllVoices([s](Voice& v){ v.setDCWDecay(s); }); }
-void VoiceManager::setDCWSustain(float l) noexcept { applyToAllVoices([l](Voice& v){ v.setDCWSustain(l); }); }
-void VoiceManager::setDCWRelease(float s) noexcept { applyToAllVoices([s](Voice& v){ v.setDCWRelease(s); }); }
-
-void VoiceManager::setDCAAttack(float s) noexcept { applyToAllVoices([s](Voice& v){ v.setDCAAttack(s); }); }
-void VoiceManager::setDCADecay(float s) noexcept { applyToAllVoices([s](Voice& v){ v.setDCADecay(s); }); }
-void VoiceManager::setDCASustain(float l) noexcept { applyToAllVoices([l](Voice& v){ v.setDCASustain(l); }); }
-void VoiceManager::setDCARelease(float s) noexcept { applyToAllVoices([s](Voice& v){ v.setDCARelease(s); }); }
+template <int MaxVoices>
+void BasicVoiceManager<MaxVoices>::setDCWAttack(float s) noexcept { applyToAllVoices([s](Voice& v){ v.setDCWAttack(s); }); }
+template <int MaxVoices>
+void BasicVoiceManager<MaxVoices>::setDCWDecay(float s) noexcept { applyToAllVoices([s](Voice& v){ v.setDCWDecay(s); }); }
+template <int MaxVoices>
+void BasicVoiceManager<MaxVoices>::setDCWSustain(float l) noexcept { applyToAllVoices([l](Voice& v){ v.setDCWSustain(l); }); }
+template <int MaxVoices>
+void BasicVoiceManager<MaxVoices>::setDCWRelease(float s) noexcept { applyToAllVoices([s](Voice& v){ v.setDCWRelease(s); }); }
+
+template <int MaxVoices>
+void BasicVoiceManager<MaxVoices>::setDCAAttack(float s) noexcept { applyToAllVoices([s](Voice& v){ v.setDCAAttack(s); }); }
+template <int MaxVoices>
+void BasicVoiceManager<MaxVoices>::setDCADecay(float s) noexcept { applyToAllVoices([s](Voice& v){ v.setDCADecay(s); }); }
+template <int MaxVoices>
+void BasicVoiceManager<MaxVoices>::setDCASustain(float l) noexcept { applyToAllVoices([l](Voice& v){ v.setDCASustain(l); }); }
+template <int MaxVoices>
+void BasicVoiceManager<MaxVoices>::setDCARelease(float s) noexcept { applyToAllVoices([s](Voice& v){ v.setDCARelease(s); }); }
 
 // 8-Stage Control
-void VoiceManager::setDCWStage(int line, int idx, float r, float l) noexcept { applyToAllVoices([=](Voice& v){ v.setDCWStage(line, idx, r, l); }); }
-void VoiceManager::setDCWSustainPoint(int line, int idx) noexcept { applyToAllVoices([=](Voice& v){ v.setDCWSustainPoint(line, idx); }); }
-void VoiceManager::setDCWEndPoint(int line, int idx) noexcept { applyToAllVoices([=](Voice& v){ v.setDCWEndPoint(line, idx); }); }
+template <int MaxVoices>
+void BasicVoiceManager<MaxVoices>::setDCWStage(int line, int idx, float r, float l) noexcept { applyToAllVoices([=](Voice& v){ v.setDCWStage(line, idx, r, l); }); }
+template <int MaxVoices>
+void BasicVoiceManager<MaxVoices>::setDCWSustainPoint(int line, int idx) noexcept { applyToAllVoices([=](Voice& v){ v.setDCWSustainPoint(line, idx); }); }
+template <int MaxVoices>
+void BasicVoiceManager<MaxVoices>::setDCWEndPoint(int line, int idx) noexcept { applyToAllVoices([=](Voice& v){ v.setDCWEndPoint(line, idx); }); }
+
+template <int MaxVoices>
+void BasicVoiceManager<MaxVoices>::setDCAStage(int line, int idx, float r, float l) noexcept { applyToAllVoices([=](Voice& v){ v.setDCAStage(line, idx, r, l); }); }
+template <int MaxVoices>
+void BasicVoiceManager<MaxVoices>::setDCASustainPoint(int line, int idx) noexcept { applyToAllVoices([=](Voice& v){ v.setDCASustainPoint(line, idx); }); }
+template <int MaxVoices>
+void BasicVoiceManager<MaxVoices>::setDCAEndPoint(int line, int idx) noexcept { applyToAllVoices([=](Voice& v){ v.setDCAEndPoint(line, idx); }); }
+
+template <int MaxVoices>
+void BasicVoiceManager<MaxVoices>::setPitchStage(int line, int idx, float r, float l) noexcept { applyToAllVoices([=](Voice& v){ v.setPitchStage(line, idx, r, l); }); }
+template <int MaxVoices>
+void BasicVoiceManager<MaxVoices>::setPitchSustainPoint(int line, int idx) noexcept { applyToAllVoices([=](Voice& v){ v.setPitchSustainPoint(line, idx); }); }
+template <int MaxVoices>
+void BasicVoiceManager<MaxVoices>::setPitchEndPoint(int line, int idx) noexcept { applyToAllVoices([=](Voice& v){ v.setPitchEndPoint(line, idx); }); }
 
-void VoiceManager::setDCAStage(int line, int idx, float r, float l) noexcept { applyToAllVoices([=](Voice& v){ v.setDCAStage(line, idx, r, l); }); }
-void VoiceManager::setDCASustainPoint(int line, int idx) noexcept { applyToAllVoices([=](Voice& v){ v.setDCASustainPoint(line, idx); }); }
-void VoiceManager::setDCAEndPoint(int line, int idx) noexcept { applyToAllVoices([=](Voice& v){ v.setDCAEndPoint(line, idx); }); }
+// Getters 
+template <int MaxVoices>
+void BasicVoiceManager<MaxVoices>::getDCWStage(int line, int idx, float& r, float& l) const noexcept { referenceVoice.getDCWStage(line, idx, r, l); }
+template <int MaxVoices>
+int BasicVoiceManager<MaxVoices>::getDCWSustainPoint(int line) const noexcept { return referenceVoice.getDCWSustainPoint(line); }
+template <int MaxVoices>
+int BasicVoiceManager<MaxVoices>::getDCWEndPoint(int line) const noexcept { return referenceVoice.getDCWEndPoint(line); }
+
+template <int MaxVoices>
+void BasicVoiceManager<MaxVoices>::getDCAStage(int line, int idx, float& r, float& l) const noexcept { referenceVoice.getDCAStage(line, idx, r, l); }
+template <int MaxVoices>
+int BasicVoiceManager<MaxVoices>::getDCASustainPoint(int line) const noexcept { return referenceVoice.getDCASustainPoint(line); }
+template <int MaxVoices>
+int BasicVoiceManager<MaxVoices>::getDCAEndPoint(int line) const noexcept { return referenceVoice.getDCAEndPoint(line); }
+
+template <int MaxVoices>
+void BasicVoiceManager<MaxVoices>::getPitchStage(int line, int idx, float& r, float& l) const noexcept { referenceVoice.getPitchStage(line, idx, r, l); }
+template <int MaxVoices>
+int BasicVoiceManager<MaxVoices>::getPitchSustainPoint(int line) const noexcept { return referenceVoice.getPitchSustainPoint(line); }
+template <int MaxVoices>
+int BasicVoiceManager<MaxVoices>::getPitchEndPoint(int line) const noexcept { return referenceVoice.getPitchEndPoint(line); }
+
+template <int MaxVoices>
+void BasicVoiceManager<MaxVoices>::setSilenceRetirement(float floorDb, int holdTicks) noexcept
+{
+    applyToAllVoices([floorDb, holdTicks](Voice& v) { v.setSilenceRetirement(floorDb, holdTicks); });
+}
 
-void VoiceManager::setPitchStage(int line, int idx, float r, float l) noexcept { applyToAllVoices([=](Voice& v){ v.setPitchStage(line, idx, r, l); }); }
-void VoiceManager::setPitchSustainPoint(int line, int idx) noexcept { applyToAllVoices([=](Voice& v){ v.setPitchSustainPoint(line, idx); }); }
-void VoiceManager::setPitchEndPoint(int line, int idx) noexcept { applyToAllVoices([=](Voice& v){ v.setPitchEndPoint(line, idx); }); }
+template <int MaxVoices>
+void BasicVoiceManager<MaxVoices>::setLineSelect(int index) noexcept
+{
+    applyToAllVoices([index](Voice& v) { v.setLineSelect(index); });
+    singleLineMode = referenceVoice.isSingleLine();
+    setActiveVoiceLimit(requestedVoiceLimit);
+}
 
-// Getters 
-void VoiceManager::getDCWStage(int line, int idx, float& r, float& l) const noexcept { referenceVoice.getDCWStage(line, idx, r, l); }
-int VoiceManager::getDCWSustainPoint(int line) const noexcept { return referenceVoice.getDCWSustainPoint(line); }
-int VoiceManager::getDCWEndPoint(int line) const noexcept { return referenceVoice.getDCWEndPoint(line); }
-
-void VoiceManager::getDCAStage(int line, int idx, float& r, float& l) const noexcept { referenceVoice.getDCAStage(line, idx, r, l); }
-int VoiceManager::getDCASustainPoint(int line) const noexcept { return referenceVoice.getDCASustainPoint(line); }
-int VoiceManager::getDCAEndPoint(int line) const noexcept { return referenceVoice.getDCAEndPoint(line); }
-
-void VoiceManager::getPitchStage(int line, int idx, float& r, float& l) const noexcept { referenceVoice.getPitchStage(line, idx, r, l); }
-int VoiceManager::getPitchSustainPoint(int line) const noexcept { return referenceVoice.getPitchSustainPoint(line); }
-int VoiceManager::getPitchEndPoint(int line) const noexcept { return referenceVoice.getPitchEndPoint(line); }
-
-void VoiceManager::setHardSync(bool e) noexcept { applyToAllVoices([e](Voice& v){ v.setHardSync(e); }); }
-void VoiceManager::setRingMod(bool e) noexcept { applyToAllVoices([e](Voice& v){ v.setRingMod(e); }); }
-void VoiceManager::setGlideTime(float s) noexcept { applyToAllVoices([s](Voice& v){ v.setGlideTime(s); }); }
-void VoiceManager::setMasterTune(float s) noexcept { applyToAllVoices([s](Voice& v){ v.setMasterTune(s); }); }
-void VoiceManager::setMasterVolume(float l) noexcept { applyToAllVoices([l](Voice& v){ v.setMasterVolume(l); }); }
-void VoiceManager::setPitchBend(float s) noexcept { applyToAllVoices([s](Voice& v){ v.setPitchBend(s); }); }
-
-void VoiceManager::setFilterCutoff(float f) noexcept { applyToAllVoices([f](Voice& v){ v.setFilterCutoff(f); }); }
-void VoiceManager::setFilterResonance(float r) noexcept { applyToAllVoices([r](Voice& v){ v.setFilterResonance(r); }); }
-void VoiceManager::setHPF(float f) noexcept { applyToAllVoices([f](Voice& v){ v.setHPF(f); }); }
-
-void VoiceManager::setModWheel(float value) noexcept { applyToAllVoices([value](Voice& v){ v.setModWheel(value); }); }
-void VoiceManager::setAftertouch(float value) noexcept { applyToAllVoices([value](Voice& v){ v.setAftertouch(value); }); }
-void VoiceManager::setModulationMatrix(const Voice::ModulationMatrix& matrix) noexcept { applyToAllVoices([&matrix](Voice& v){ v.setModulationMatrix(matrix); }); }
-
-void VoiceManager::setVibratoDepth(float s) noexcept { applyToAllVoices([s](Voice& v){ v.setVibratoDepth(s); }); }
-void VoiceManager::setLFOFrequency(float hz) noexcept { applyToAllVoices([hz](Voice& v){ v.setLFOFrequency(hz); }); }
-void VoiceManager::setLFOWaveform(DSP::LFO::Waveform w) noexcept { applyToAllVoices([w](Voice& v){ v.setLFOWaveform(w); }); }
-void VoiceManager::setLFODelay(float s) noexcept { applyToAllVoices([s](Voice& v){ v.setLFODelay(s); }); }
+template <int MaxVoices>
+void BasicVoiceManager<MaxVoices>::setHardSync(bool e) noexcept { applyToAllVoices([e](Voice& v){ v.setHardSync(e); }); }
+template <int MaxVoices>
+void BasicVoiceManager<MaxVoices>::setRingMod(bool e) noexcept { applyToAllVoices([e](Voice& v){ v.setRingMod(e); }); }
+template <int MaxVoices>
+void BasicVoiceManager<MaxVoices>::setGlideTime(float s) noexcept { applyToAllVoices([s](Voice& v){ v.setGlideTime(s); }); }
+template <int MaxVoices>
+void BasicVoiceManager<MaxVoices>::setMasterTune(float s) noexcept { applyToAllVoices([s](Voice& v){ v.setMasterTune(s); }); }
+template <int MaxVoices>
+void BasicVoiceManager<MaxVoices>::setMasterVolume(float l) noexcept { applyToAllVoices([l](Voice& v){ v.setMasterVolume(l); }); }
+template <int MaxVoices>
+void BasicVoiceManager<MaxVoices>::setPitchBend(float s) noexcept { applyToAllVoices([s](Voice& v){ v.setPitchBend(s); }); }
+
+template <int MaxVoices>
+void BasicVoiceManager<MaxVoices>::setFilterCutoff(float f) noexcept { applyToAllVoices([f](Voice& v){ v.setFilterCutoff(f); }); }
+template <int MaxVoices>
+void BasicVoiceManager<MaxVoices>::setFilterResonance(float r) noexcept { applyToAllVoices([r](Voice& v){ v.setFilterResonance(r); }); }
+template <int MaxVoices>
+void BasicVoiceManager<MaxVoices>::setHPF(float f) noexcept { applyToAllVoices([f](Voice& v){ v.setHPF(f); }); }
+
+template <int MaxVoices>
+void BasicVoiceManager<MaxVoices>::setModWheel(float value) noexcept { applyToAllVoices([value](Voice& v){ v.setModWheel(value); }); }
+template <int MaxVoices>
+void BasicVoiceManager<MaxVoices>::setAftertouch(float value) noexcept { applyToAllVoices([value](Voice& v){ v.setAftertouch(value); }); }
+template <int MaxVoices>
+void BasicVoiceManager<MaxVoices>::setModulationMatrix(const Voice::ModulationMatrix& matrix) noexcept { applyToAllVoices([&matrix](Voice& v){ v.setModulationMatrix(matrix); }); }
+
+template <int MaxVoices>
+void BasicVoiceManager<MaxVoices>::setVibratoDepth(float s) noexcept { applyToAllVoices([s](Voice& v){ v.setVibratoDepth(s); }); }
+template <int MaxVoices>
+void BasicVoiceManager<MaxVoices>::setLFOFrequency(float hz) noexcept { applyToAllVoices([hz](Voice& v){ v.setLFOFrequency(hz); }); }
+template <int MaxVoices>
+void BasicVoiceManager<MaxVoices>::setLFOWaveform(DSP::LFO::Waveform w) noexcept { applyToAllVoices([w](Voice& v){ v.setLFOWaveform(w); }); }
+template <int MaxVoices>
+void BasicVoiceManager<MaxVoices>::setLFODelay(float s) noexcept { applyToAllVoices([s](Voice& v){ v.setLFODelay(s); }); }
 
 // Phase 5.1: Oversampling
-void VoiceManager::setOversamplingFactor(int factor) noexcept { applyToAllVoices([factor](Voice& v){ v.setOversamplingFactor(factor); }); }
+template <int MaxVoices>
+void BasicVoiceManager<MaxVoices>::setOversamplingFactor(int factor) noexcept 
+{ 
+    factor = (factor >= 4) ? 4 : (factor >= 2 ? 2 : 1);
+    if (factor == oversamplingFactor) return;
+    
+    oversamplingFactor = factor;
+    applyOversamplingToVoices();
+}
+
+template <int MaxVoices>
+void BasicVoiceManager<MaxVoices>::setOversamplingMode(OversamplingMode mode) noexcept
+{
+    if (mode == oversamplingMode) return;
+    
+    oversamplingMode = mode;
+    applyOversamplingToVoices();
+}
+
+template <int MaxVoices>
+void BasicVoiceManager<MaxVoices>::applyOversamplingToVoices() noexcept
+{
+    // MixBus: voices believe the raised rate is their sample rate and do no decimation themselves
+    const bool mixBus = isMixBusOversampling();
+    const int voiceFactor = mixBus ? 1 : oversamplingFactor;
+    const double rate = mixBus ? baseSampleRate * oversamplingFactor : baseSampleRate;
+    
+    applyToAllVoices([voiceFactor](Voice& v) { v.setOversamplingFactor(voiceFactor); });
+    
+    // Only touched on an actual rate change: Voice::setSampleRate also resets its smoothers
+    if (rate != voiceSampleRate)
+    {
+        voiceSampleRate = rate;
+        applyToAllVoices([rate](Voice& v) { v.setSampleRate(rate); });
+    }
+    
+    mixBusDecimator.setFactor(mixBus ? oversamplingFactor : 1);
+}
 
 // Renamed internal helper
-void VoiceManager::startInternalVoice(int midiNote, float velocity) noexcept
+template <int MaxVoices>
+void BasicVoiceManager<MaxVoices>::startInternalVoice(int midiNote, float velocity) noexcept
 {
     lastMidiNote = midiNote;
     int voiceIndex = findVoicePlayingNote(midiNote);
     if (voiceIndex < 0) voiceIndex = findFreeVoice();
     if (voiceIndex < 0) voiceIndex = findVoiceToSteal();
-    if (voiceIndex >= 0) voices[voiceIndex].noteOn(midiNote, velocity);
+    if (voiceIndex >= 0)
+    {
+        assignVoice(voiceIndex, midiNote);
+        voices[voiceIndex].alignControlGrid(controlCounter);
+        voices[voiceIndex].noteOn(midiNote, velocity);
+    }
 }
 
-void VoiceManager::noteOn(int midiNote, float velocity) noexcept
+template <int MaxVoices>
+void BasicVoiceManager<MaxVoices>::noteOn(int midiNote, float velocity) noexcept
 {
     if (arpeggiator.isEnabled()) {
         arpeggiator.noteOn(midiNote, velocity);
@@ -200,15 +390,18 @@ void VoiceManager::noteOn(int midiNote, float velocity) noexcept
 }
 
 // Renamed internal helper
-void VoiceManager::stopInternalVoice(int midiNote) noexcept
+template <int MaxVoices>
+void BasicVoiceManager<MaxVoices>::stopInternalVoice(int midiNote) noexcept
 {
-    // Fix: Only stop voices within the active range?
-    for (int i = 0; i < maxActiveVoices; ++i)
-        if (voices[i].isActive() && voices[i].getCurrentNote() == midiNote)
-            voices[i].noteOff();
+    if (midiNote < 0 || midiNote >= NUM_MIDI_NOTES) return;
+    
+    const int v = noteToVoice[midiNote];
+    if (v >= 0 && voices[v].isActive() && voices[v].getCurrentNote() == midiNote)
+        voices[v].noteOff();
 }
 
-void VoiceManager::noteOff(int midiNote) noexcept
+template <int MaxVoices>
+void BasicVoiceManager<MaxVoices>::noteOff(int midiNote) noexcept
 {
     if (arpeggiator.isEnabled()) {
         arpeggiator.noteOff(midiNote);
@@ -217,102 +410,312 @@ void VoiceManager::noteOff(int midiNote) noexcept
     }
 }
 
-void VoiceManager::allNotesOff() noexcept { for (auto& voice : voices) voice.noteOff(); }
+template <int MaxVoices>
+void BasicVoiceManager<MaxVoices>::allNotesOff() noexcept { for (auto& voice : voices) voice.noteOff(); }
 
-void VoiceManager::renderNextBlock(float* outputL, float* outputR, int numSamples) noexcept
+template <int MaxVoices>
+void BasicVoiceManager<MaxVoices>::renderNextBlock(float* outputL, float* outputR, int numSamples) noexcept
 {
-    // Arpeggiator Processing
-    if (arpeggiator.isEnabled()) {
-        // Static buffer to reuse memory
-        // Thread safety: This is only called from Audio Thread
-        static std::vector<DSP::Arpeggiator::ArpEvent> events;
-        events.clear();
-        arpeggiator.process(numSamples, events);
-        
-        for (const auto& evt : events) {
+    // Arpeggiator Processing: steps land on their own sample, so the block is rendered in
+    // segments split at the event offsets (also runs while disabled to release its last note)
+    arpEvents.clear();
+    arpeggiator.process(numSamples, arpEvents);
+    
+    int position = 0;
+    int nextEvent = 0;
+    while (position < numSamples)
+    {
+        for (; nextEvent < arpEvents.size() && arpEvents[nextEvent].sampleOffset <= position; ++nextEvent)
+        {
+            const auto& evt = arpEvents[nextEvent];
             if (evt.isNoteOn) startInternalVoice(evt.note, evt.velocity);
             else stopInternalVoice(evt.note);
         }
+        
+        const int end = nextEvent < arpEvents.size() ? std::min(numSamples, arpEvents[nextEvent].sampleOffset) : numSamples;
+        renderSegment(outputL + position, end - position);
+        position = end;
+    }
+    
+    juce::FloatVectorOperations::copy(outputR, outputL, numSamples);
+}
+
+template <int MaxVoices>
+void BasicVoiceManager<MaxVoices>::renderSegment(float* output, int numSamples) noexcept
+{
+    juce::FloatVectorOperations::clear(output, numSamples);
+    
+    if (isMixBusOversampling())
+    {
+        // Every voice renders straight into the raised-rate bus (so the SIMD bank and the worker
+        // pool both apply), and the sum is decimated once instead of once per voice
+        const int maxChunk = RENDER_CHUNK_SIZE / oversamplingFactor;
+        for (int offset = 0; offset < numSamples; offset += maxChunk)
+        {
+            const int chunk = std::min(maxChunk, numSamples - offset);
+            const int hiChunk = chunk * oversamplingFactor;
+            
+            juce::FloatVectorOperations::clear(mixBusBuffer.data(), hiChunk);
+            renderVoices(mixBusBuffer.data(), hiChunk);
+            mixBusDecimator.process(mixBusBuffer.data(), output + offset, chunk);
+        }
+    }
+    else
+    {
+        renderVoices(output, numSamples);
+    }
+    
+    retireFinishedVoices(); // Voices freed here are available to the next segment's events
+}
+
+template <int MaxVoices>
+void BasicVoiceManager<MaxVoices>::renderVoices(float* output, int numSamples) noexcept
+{
+    // Every path shares one oscillator state (voice phases) and one control grid (controlCounter,
+    // which each voice's own counter was aligned to at noteOn), so switching paths as the voice
+    // count crosses PARALLEL_MIN_VOICES is seamless
+    if (renderPool.isRunning() && activeVoices.size() >= PARALLEL_MIN_VOICES)
+    {
+        renderVoicesParallel(output, numSamples);
+        controlCounter += static_cast<uint32_t>(numSamples);
+        return;
+    }
+    
+    // Voices themselves render at 1x in MixBus mode, so the bank covers that case too
+    if (oscBankEnabled && (oversamplingFactor == 1 || isMixBusOversampling()))
+    {
+        renderVoicesWithOscBank(output, numSamples);
+        return;
+    }
+    
+    // Voice-outer loop: each voice renders its whole chunk while its state is hot in cache
+    for (int offset = 0; offset < numSamples; offset += RENDER_CHUNK_SIZE)
+    {
+        const int chunk = std::min(RENDER_CHUNK_SIZE, numSamples - offset);
+        
+        // Only live voices are visited
+        for (int i = 0; i < activeVoices.size(); ++i)
+        {
+            const int v = activeVoices[i];
+            voices[v].renderBlock(voiceScratch.data(), chunk);
+            juce::FloatVectorOperations::add(output + offset, voiceScratch.data(), chunk);
+        }
     }
+    
+    controlCounter += static_cast<uint32_t>(numSamples);
+}
 
-    for (int i = 0; i < numSamples; ++i)
+template <int MaxVoices>
+void BasicVoiceManager<MaxVoices>::renderVoicesWithOscBank(float* output, int numSamples) noexcept
+{
+    std::array<int, MAX_VOICES> liveVoices;
+    int pos = 0;
+    
+    while (pos < numSamples)
     {
-        float sample = 0.0f;
-        // Limit processing to maxActiveVoices
-        for (int v = 0; v < maxActiveVoices; ++v)
-            if (voices[v].isActive())
-                sample += voices[v].renderNextSample();
+        // Segments end on the shared control grid so every voice ticks together
+        const int phaseInTick = static_cast<int>(controlCounter & static_cast<uint32_t>(controlDivider - 1));
+        const int segment = std::min(numSamples - pos, controlDivider - phaseInTick);
+        const bool isControlTick = (phaseInTick == 0);
+        
+        // Lanes are voice indices: the banks only run up to the highest live one (rounded up
+        // to their SIMD blocks), not the whole voice limit
+        int numLive = 0, lanesInUse = 0;
+        for (int i = 0; i < activeVoices.size(); ++i)
+        {
+            const int v = activeVoices[i];
+            if (!voices[v].isActive()) continue; // Finished earlier in this block
+            liveVoices[numLive++] = v;
+            lanesInUse = std::max(lanesInUse, v + 1);
+        }
+        
+        // Control tick: per-voice state advances into the lanes, then the DCW/DCA/pitch
+        // combine and exp2 run once over every ticking voice
+        const auto& lanes = controlLanes.lanes();
+        std::array<int, MAX_VOICES> tickVoices;
+        int numTick = 0;
+        for (int i = 0; i < numLive; ++i)
+        {
+            const int v = liveVoices[i];
+            if (!voices[v].needsControlTick(isControlTick)) continue;
+            voices[v].gatherControlInputs(lanes, numTick);
+            tickVoices[numTick++] = v;
+        }
+        
+        if (numTick > 0)
+        {
+            lanes.process(numTick);
+            for (int lane = 0; lane < numTick; ++lane)
+                voices[tickVoices[lane]].applyControlOutputs(lanes, lane);
+        }
+        
+        for (int i = 0; i < numLive; ++i)
+        {
+            const int v = liveVoices[i];
+            DSP::OscLineParams line1, line2;
+            voices[v].beginBankSegment(line1, line2);
+            oscBank.setVoice(v, line1, line2);
+        }
+        
+        if (numLive > 0)
+        {
+            oscBank.render(segment, lanesInUse, singleLineMode ? 1 : 2);
+            
+            // Mix up to the filter input, filter every voice at once, then the output gain stage
+            for (int i = 0; i < numLive; ++i)
+            {
+                const int v = liveVoices[i];
+                voices[v].storeBankPhases(oscBank.getPhase(0, v), oscBank.getPhase(1, v));
+                voices[v].renderBankSegment(oscBank.getOutput(0, v), oscBank.getOutput(1, v), oscBank.getStride(),
+                                            filterBank.getInput(v), filterBank.getStride(), segment);
+                filterBank.load(v, voices[v].getFilterState());
+            }
+            
+            filterBank.process(segment, lanesInUse);
+            
+            for (int i = 0; i < numLive; ++i)
+            {
+                const int v = liveVoices[i];
+                filterBank.store(v, voices[v].getFilterState());
+                voices[v].finishBankSegment(filterBank.getOutput(v), filterBank.getStride(), voiceScratch.data(), segment);
+                juce::FloatVectorOperations::add(output + pos, voiceScratch.data(), segment);
+            }
+        }
         
-        outputL[i] = sample;
-        outputR[i] = sample;
+        controlCounter += static_cast<uint32_t>(segment);
+        pos += segment;
     }
 }
 
-int VoiceManager::getActiveVoiceCount() const noexcept
+template <int MaxVoices>
+void BasicVoiceManager<MaxVoices>::setParallelRendering(int numWorkers)
 {
-    int count = 0;
-    for (int i = 0; i < maxActiveVoices; ++i) 
-        if (voices[i].isActive()) ++count;
-    return count;
+    if (numWorkers == renderPool.getNumWorkers()) return;
+    renderPool.start(numWorkers);
+}
+
+template <int MaxVoices>
+void BasicVoiceManager<MaxVoices>::renderVoiceTask(void* context, int taskIndex) noexcept
+{
+    auto& self = *static_cast<BasicVoiceManager*>(context);
+    const int v = self.activeVoices[taskIndex];
+    self.voices[v].renderBlock(self.parallelVoiceBuffers[(size_t)taskIndex].data(), self.parallelChunkSize);
+}
+
+template <int MaxVoices>
+void BasicVoiceManager<MaxVoices>::renderVoicesParallel(float* output, int numSamples) noexcept
+{
+    // The active list is not modified while tasks run; voices only touch their own state
+    for (int offset = 0; offset < numSamples; offset += RENDER_CHUNK_SIZE)
+    {
+        parallelChunkSize = std::min(RENDER_CHUNK_SIZE, numSamples - offset);
+        const int numTasks = activeVoices.size();
+        
+        renderPool.run(&BasicVoiceManager::renderVoiceTask, this, numTasks);
+        
+        // Deterministic sum: fixed active-list order regardless of which thread rendered what
+        for (int i = 0; i < numTasks; ++i)
+            juce::FloatVectorOperations::add(output + offset, parallelVoiceBuffers[(size_t)i].data(), parallelChunkSize);
+    }
 }
 
-int VoiceManager::findFreeVoice() const noexcept
+template <int MaxVoices>
+int BasicVoiceManager<MaxVoices>::findFreeVoice() noexcept
 {
-    for (int i = 0; i < maxActiveVoices; ++i) 
-        if (!voices[i].isActive()) return i;
-    return -1;
+    return freeVoices.pop();
 }
 
-int VoiceManager::findVoiceToSteal() const noexcept
+template <int MaxVoices>
+int BasicVoiceManager<MaxVoices>::findVoiceToSteal() const noexcept
 {
-    // 1. First Pass: Try to find a releasing voice
-    for (int i = 0; i < maxActiveVoices; ++i) 
-        if (voices[i].isReleasing()) return i;
+    // 1. First Pass: Try to find a releasing voice (live voices only)
+    for (int i = 0; i < activeVoices.size(); ++i) 
+        if (voices[activeVoices[i]].isReleasing()) return activeVoices[i];
 
     // 2. Second Pass: Use Strategy (e.g. Oldest)
     if (strategy)
     {
-        return strategy->findVoiceToSteal(voices.data(), (int)voices.size(), maxActiveVoices);
+        return strategy->findVoiceToSteal(voices.data(), activeVoices.data(), activeVoices.size(), maxActiveVoices);
     }
     
     // Fallback if no strategy (should not happen if initialized)
-    for (int i = 0; i < maxActiveVoices; ++i) 
-        if (voices[i].isActive()) return i;
+    for (int i = 0; i < activeVoices.size(); ++i) 
+        if (voices[activeVoices[i]].isActive()) return activeVoices[i];
         
     return 0;
 }
 
-int VoiceManager::findVoicePlayingNote(int midiNote) const noexcept
+template <int MaxVoices>
+int BasicVoiceManager<MaxVoices>::findVoicePlayingNote(int midiNote) const noexcept
 {
-    for (int i = 0; i < maxActiveVoices; ++i) 
-        if (voices[i].getCurrentNote() == midiNote) return i;
-    return -1;
+    if (midiNote < 0 || midiNote >= NUM_MIDI_NOTES) return -1;
+    
+    const int v = noteToVoice[midiNote];
+    return (v >= 0 && v < maxActiveVoices && voices[v].getCurrentNote() == midiNote) ? v : -1;
 }
 
 // Phase 7: Snapshot System
-void VoiceManager::applySnapshot(const ParameterSnapshot* snapshot) noexcept
+template <int MaxVoices>
+void BasicVoiceManager<MaxVoices>::applySnapshot(const ParameterSnapshot* snapshot) noexcept
 {
     if (!snapshot) return;
     
+    // Same snapshot as last block: nothing to do unless the voice limit grew past the voices it reached
+    const bool unchanged = snapshot == appliedSnapshot && snapshot->version == appliedVersion;
+    if (unchanged && maxActiveVoices <= voicesWithSnapshot) return;
+    
+    // Dirty bits are relative to the previous version; if the audio thread missed one, apply everything
+    uint32_t sections = ParameterSnapshot::AllSections;
+    if (unchanged) sections = 0;
+    else if (appliedSnapshot != nullptr && snapshot->version == appliedVersion + 1) sections = snapshot->dirtySections;
+    
+    appliedSnapshot = snapshot;
+    appliedVersion = snapshot->version;
+    
     // Global parameters affecting logic
-    maxActiveVoices = snapshot->system.voiceLimit;
+    if (sections & (ParameterSnapshot::Oscillators | ParameterSnapshot::System))
+    {
+        singleLineMode = Voice::isSingleLine(static_cast<Voice::LineSelect>(snapshot->lineSelect));
+        setActiveVoiceLimit(snapshot->system.voiceLimit);
+    }
+    if (sections & ParameterSnapshot::System)
+    {
+        setOversamplingFactor(snapshot->system.oversampling);
+        setOversamplingMode(snapshot->system.oversamplingMixBus ? OversamplingMode::MixBus : OversamplingMode::PerVoice);
+    }
     
-    // Propagate to all voices
-    applyToAllVoices([snapshot](Voice& v) { 
-        v.applySnapshot(snapshot); 
-    });
+    // Propagate to the voices in use only: the rest are refreshed in full here once the limit grows
+    const int upToDate = std::min(voicesWithSnapshot, maxActiveVoices);
+    if (sections != 0)
+    {
+        for (int i = 0; i < upToDate; ++i)
+            voices[i].applySnapshot(snapshot, sections);
+        referenceVoice.applySnapshot(snapshot, sections);
+    }
+    for (int i = upToDate; i < maxActiveVoices; ++i)
+        voices[i].applySnapshot(snapshot);
+    voicesWithSnapshot = maxActiveVoices;
     
     // Audit Fix [2.4]: Apply Arpeggiator Snapshot
-    auto& arp = getArpeggiator();
-    arp.setEnabled(snapshot->arp.enabled);
-    arp.setLatch(snapshot->arp.latch);
-    arp.setRate(static_cast<DSP::Arpeggiator::Rate>(snapshot->arp.rate));
-    arp.setPattern(static_cast<DSP::Arpeggiator::Pattern>(snapshot->arp.pattern));
-    arp.setOctaveRange(snapshot->arp.octave);
-    arp.setGateTime(snapshot->arp.gate);
-    arp.setSwing(snapshot->arp.swing);
-    arp.setSwingMode(static_cast<DSP::Arpeggiator::SwingMode>(snapshot->arp.swingMode));
+    if (sections & ParameterSnapshot::Arp)
+    {
+        auto& arp = getArpeggiator();
+        arp.setEnabled(snapshot->arp.enabled);
+        arp.setLatch(snapshot->arp.latch);
+        arp.setRate(static_cast<DSP::Arpeggiator::Rate>(snapshot->arp.rate));
+        arp.setPattern(static_cast<DSP::Arpeggiator::Pattern>(snapshot->arp.pattern));
+        arp.setOctaveRange(snapshot->arp.octave);
+        arp.setGateTime(snapshot->arp.gate);
+        arp.setSwing(snapshot->arp.swing);
+        arp.setSwingMode(static_cast<DSP::Arpeggiator::SwingMode>(snapshot->arp.swingMode));
+    }
 }
 
+template class BasicVoiceManager<4>;
+template class BasicVoiceManager<8>;
+template class BasicVoiceManager<16>;
+template class BasicVoiceManager<64>;
+template class BasicVoiceManager<128>;
+
 } // namespace Core
 } // namespace CZ101
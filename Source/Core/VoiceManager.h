@@ -4,6 +4,10 @@
 #include "Voice.h"
 #include "../DSP/Arpeggiator.h"
 #include "VoiceAssignmentStrategy.h"
+#include "VoiceIndexSet.h"
+#include "VoiceRenderPool.h"
+#include "ControlRateModulation.h"
+#include "../DSP/Filters/SVFFilterBank.h"
 #include <vector>
 #include <memory>
 
@@ -16,14 +20,26 @@ struct ParameterSnapshot;
 
 namespace Core {
 
-class VoiceManager
+/**
+ * @brief Polyphonic voice engine with a compile-time voice capacity.
+ *
+ * Explicitly instantiated for 4, 8, 16, 64 and 128 voices (VoiceManager.cpp).
+ * Everything per-voice (Voice pool, SIMD oscillator lanes, index sets, render
+ * buffers) is sized by MaxVoices, so small hardware models stay cache-resident,
+ * and per-block work scales with the active voice limit rather than the capacity.
+ */
+template <int MaxVoices>
+class BasicVoiceManager
 {
 public:
-    VoiceManager();
+    static_assert(MaxVoices == 4 || MaxVoices == 8 || MaxVoices == 16 || MaxVoices == 64 || MaxVoices == 128,
+                  "Supported voice capacities: 4, 8, 16, 64, 128");
+    
+    BasicVoiceManager();
     
     // Phase 7: Snapshot System
     void applySnapshot(const ParameterSnapshot* snapshot) noexcept;
-    static constexpr int MAX_VOICES = 16; // 8 notes * 2 lines (or 16 notes single line mode?)
+    static constexpr int MAX_VOICES = MaxVoices;
     
     enum VoiceStealingMode
     {
@@ -33,9 +49,6 @@ public:
         RELEASE_PHASE
     };
     
-    // Constructor handled above at line 22
-    // VoiceManager(); // removed duplicate
-    
     // Audit Fix [2.2]
     void setSynthModel(DSP::MultiStageEnvelope::Model model) noexcept;
     
@@ -43,8 +56,17 @@ public:
     void setVoiceLimit(int limit) noexcept;
 
     void setSampleRate(double sampleRate) noexcept;
+    
+    /** Samples per modulation tick for every voice (power of two, clamped to 1..MAX_CONTROL_RATE_DIVIDER) */
+    void setControlRateDivider(int divider) noexcept;
+    int getControlRateDivider() const noexcept { return controlDivider; }
     void setVoiceStealingMode(VoiceStealingMode mode) noexcept { stealingMode = mode; }
     
+    /** Silent-voice retirement for every voice (see Voice::setSilenceRetirement) */
+    void setSilenceRetirement(float floorDb, int holdTicks) noexcept;
+    /** Voices ended early by silence retirement since construction (audio thread counter) */
+    int getSilenceRetiredCount() const noexcept { return silenceRetiredCount; }
+    
     // Parameter Control (Proxy to all voices)
     // Oscillator 1
     // Oscillator 1
@@ -96,6 +118,11 @@ public:
     void setPitchSustainPoint(int line, int index) noexcept;
     void setPitchEndPoint(int line, int index) noexcept;
 
+    // Line Select (0 = 1, 1 = 2, 2 = 1+1', 3 = 1+2'): single-line patches use half the
+    // lines per note, so the voice limit doubles (up to MAX_VOICES), as on the hardware
+    void setLineSelect(int index) noexcept;
+    bool isSingleLineMode() const noexcept { return singleLineMode; }
+
     // Hard Sync
     void setHardSync(bool enabled) noexcept;
 
@@ -125,7 +152,29 @@ public:
     void setLFODelay(float seconds) noexcept;
     
     // Phase 5.1: Oversampling
+    enum class OversamplingMode
+    {
+        PerVoice, // Each voice runs its DCOs at the raised rate and decimates its own output
+        MixBus    // Whole voices run at the raised rate into one bus, decimated once after summation
+    };
+    
     void setOversamplingFactor(int factor) noexcept;
+    int getOversamplingFactor() const noexcept { return oversamplingFactor; }
+    void setOversamplingMode(OversamplingMode mode) noexcept;
+    OversamplingMode getOversamplingMode() const noexcept { return oversamplingMode; }
+    /** Decimator group delay at the base rate for the current factor (report via setLatencySamples). */
+    float getLatencySamples() const noexcept { return DSP::OversamplingDecimator::getLatencySamples(oversamplingFactor); }
+    
+    // SoA SIMD oscillator bank (voices rendering at 1x, which includes MixBus oversampling; PerVoice uses the scalar path)
+    void setOscillatorBankEnabled(bool enabled) noexcept { oscBankEnabled = enabled; }
+    bool isOscillatorBankEnabled() const noexcept { return oscBankEnabled; }
+    
+    /**
+     * @brief Parallel voice rendering across a worker pool (high-polyphony modes)
+     * @param numWorkers Worker threads in addition to the audio thread (0 = off). Message thread only.
+     */
+    void setParallelRendering(int numWorkers);
+    bool isParallelRenderingEnabled() const noexcept { return renderPool.isRunning(); }
 
     void noteOn(int midiNote, float velocity) noexcept;
     void noteOff(int midiNote) noexcept;
@@ -133,9 +182,10 @@ public:
     
     // Audio Processing
     // LFO is now internal to Voices
+    // Each active voice renders a whole block into voiceScratch which is then summed.
     void renderNextBlock(float* outputL, float* outputR, int numSamples) noexcept;
     
-    int getActiveVoiceCount() const noexcept;
+    int getActiveVoiceCount() const noexcept { return activeVoices.size(); }
     int getCurrentNote() const noexcept { return lastMidiNote; }
 
     DSP::Arpeggiator& getArpeggiator() { return arpeggiator; } // [NEW]
@@ -145,19 +195,73 @@ private:
     void stopInternalVoice(int note) noexcept;
 
     std::array<Voice, MAX_VOICES> voices; // Audit Fix 6.1: Fixed size array for memory stability
+    
+    // Block rendering: host buffers are processed in chunks of this size (no audio-thread allocation)
+    static constexpr int RENDER_CHUNK_SIZE = 256;
+    alignas(16) std::array<float, RENDER_CHUNK_SIZE> voiceScratch {};
+    
+    // SoA oscillator bank: all voices' DCOs rendered per control segment
+    DSP::PhaseDistOscBank<MAX_VOICES> oscBank;
+    DSP::SVFFilterBank<MAX_VOICES> filterBank; // Same segments: voice filters run lane-parallel
+    bool oscBankEnabled = true;
+    int oversamplingFactor = 1;
+    OversamplingMode oversamplingMode = OversamplingMode::PerVoice;
+    double baseSampleRate = 44100.0;
+    double voiceSampleRate = 44100.0; // baseSampleRate * oversamplingFactor in MixBus mode
+    void applyOversamplingToVoices() noexcept;
+    
+    // Mix-bus oversampling: one raised-rate bus for all voices and a single decimator
+    alignas(16) std::array<float, RENDER_CHUNK_SIZE> mixBusBuffer {};
+    DSP::OversamplingDecimator mixBusDecimator;
+    bool isMixBusOversampling() const noexcept { return oversamplingMode == OversamplingMode::MixBus && oversamplingFactor > 1; }
+    
+    void renderSegment(float* output, int numSamples) noexcept; // Clears output and renders every voice into it
+    void renderVoices(float* output, int numSamples) noexcept; // Adds all live voices into output
+    uint32_t controlCounter = 0; // Shared control-rate grid (every render path advances it)
+    int controlDivider = HardwareConstants::CONTROL_RATE_DIVIDER;
+    ControlRateBuffers<MAX_VOICES> controlLanes; // Bank path: one lane per voice ticking this segment
+    void renderVoicesWithOscBank(float* output, int numSamples) noexcept;
+    
+    // Parallel rendering: one task per live voice, each into its own buffer, summed in active-list order
+    static constexpr int PARALLEL_MIN_VOICES = 8; // Below this the handoff costs more than it saves
+    VoiceRenderPool renderPool;
+    alignas(16) std::array<std::array<float, RENDER_CHUNK_SIZE>, MAX_VOICES> parallelVoiceBuffers {};
+    int parallelChunkSize = 0;
+    void renderVoicesParallel(float* output, int numSamples) noexcept;
+    static void renderVoiceTask(void* context, int taskIndex) noexcept;
     Voice referenceVoice;      // Audit Fix 1.5: Reference voice for stable parameter reading
     DSP::Arpeggiator arpeggiator; // [NEW]
+    DSP::Arpeggiator::EventBuffer arpEvents; // Filled per block, rendered between at their sample offsets
     
     // Audit Fix [2.3]: Dynamic Voice Count
     int maxActiveVoices = MAX_VOICES; 
+    int requestedVoiceLimit = MAX_VOICES; // Two-line voices; doubled in single-line mode
+    bool singleLineMode = false;
+    
+    // Phase 7: last applied snapshot, and how many voices (from 0) have it in full
+    const ParameterSnapshot* appliedSnapshot = nullptr;
+    uint64_t appliedVersion = 0;
+    int voicesWithSnapshot = 0;
     
     VoiceStealingMode stealingMode = RELEASE_PHASE;
     int lastMidiNote = -1;
     
-    int findFreeVoice() const noexcept;
+    int findFreeVoice() noexcept;
     int findVoiceToSteal() const noexcept;
     int findVoicePlayingNote(int midiNote) const noexcept;
     
+    // O(1) voice allocation: live voices, free voices (within maxActiveVoices) and note -> voice map
+    static constexpr int NUM_MIDI_NOTES = 128;
+    VoiceIndexSet<MAX_VOICES> activeVoices;
+    VoiceIndexSet<MAX_VOICES> freeVoices;
+    std::array<int16_t, NUM_MIDI_NOTES> noteToVoice;
+    
+    void setActiveVoiceLimit(int limit) noexcept;
+    void rebuildVoiceTracking() noexcept;
+    void assignVoice(int voiceIndex, int midiNote) noexcept;
+    void retireFinishedVoices() noexcept;
+    int silenceRetiredCount = 0;
+    
     // Helper to reduce repetition
     template <typename Func>
     void applyToAllVoices(Func&& func)
@@ -171,5 +275,23 @@ private:
     void updateStrategy();
 };
 
+// Build-time voice capacity for the plugin (CMake: -DCZ101_MAX_VOICES=4|8|16|64|128)
+#ifndef CZ101_MAX_VOICES
+ #define CZ101_MAX_VOICES 16
+#endif
+
+extern template class BasicVoiceManager<4>;
+extern template class BasicVoiceManager<8>;
+extern template class BasicVoiceManager<16>;
+extern template class BasicVoiceManager<64>;
+extern template class BasicVoiceManager<128>;
+
+/** The plugin's voice engine (a class rather than an alias so it can be forward-declared). */
+class VoiceManager final : public BasicVoiceManager<CZ101_MAX_VOICES>
+{
+public:
+    VoiceManager() = default;
+};
+
 } // namespace Core
 } // namespace CZ101
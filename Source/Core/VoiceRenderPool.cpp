@@ -0,0 +1,117 @@
+#include "VoiceRenderPool.h"
+#include <thread>
+
+namespace CZ101 {
+namespace Core {
+
+void VoiceRenderPool::start(int numWorkers)
+{
+    stop();
+
+    numWorkers = juce::jlimit(0, MAX_WORKERS, numWorkers);
+    for (int i = 0; i < numWorkers; ++i)
+    {
+        // The audio thread waits on these, so they must be scheduled like it. Without
+        // real-time scheduling the pool stays off and voices render inline.
+        workers[(size_t)i] = std::make_unique<Worker>(*this, i);
+        if (!workers[(size_t)i]->startRealtimeThread(juce::Thread::RealtimeOptions{}))
+        {
+            workers[(size_t)i].reset();
+            stop();
+            return;
+        }
+    }
+    numActiveWorkers = numWorkers;
+}
+
+void VoiceRenderPool::stop()
+{
+    for (auto& w : workers)
+        if (w) w->signalThreadShouldExit();
+
+    for (auto& w : workers)
+    {
+        if (!w) continue;
+        w->stopThread(1000);
+        w.reset();
+    }
+    numActiveWorkers = 0;
+}
+
+void VoiceRenderPool::run(TaskFunction task, void* context, int numTasks) noexcept
+{
+    if (numTasks <= 0) return;
+
+    jassert(numTasks <= (int)INDEX_MASK);
+
+    // Inline when there is nobody to share with
+    if (numActiveWorkers == 0 || numTasks == 1)
+    {
+        for (int i = 0; i < numTasks; ++i) task(context, i);
+        return;
+    }
+
+    currentTask.store(task, std::memory_order_relaxed);
+    currentContext.store(context, std::memory_order_relaxed);
+    completedTasks.store(0, std::memory_order_relaxed);
+
+    ++generation;
+    jobWord.store(((uint64_t)generation << GENERATION_SHIFT) | ((uint64_t)numTasks << COUNT_SHIFT),
+                  std::memory_order_release);
+
+    drainTasks();
+
+    // Spin-wait for tasks claimed by workers
+    while (completedTasks.load(std::memory_order_acquire) < numTasks)
+        std::this_thread::yield();
+}
+
+bool VoiceRenderPool::drainTasks() noexcept
+{
+    bool didWork = false;
+
+    for (;;)
+    {
+        const uint64_t word = jobWord.load(std::memory_order_acquire);
+        const int count = (int)((word >> COUNT_SHIFT) & INDEX_MASK);
+        if ((int)(word & INDEX_MASK) >= count) return didWork;
+
+        // Claim one index; the returned word tells which job it belongs to
+        const uint64_t claimed = jobWord.fetch_add(1, std::memory_order_acq_rel);
+        const int index = (int)(claimed & INDEX_MASK);
+        const int claimedCount = (int)((claimed >> COUNT_SHIFT) & INDEX_MASK);
+        if (index >= claimedCount) return didWork;
+
+        // The job cannot be replaced while this task is outstanding
+        currentTask.load(std::memory_order_relaxed)(currentContext.load(std::memory_order_relaxed), index);
+        completedTasks.fetch_add(1, std::memory_order_release);
+        didWork = true;
+    }
+}
+
+void VoiceRenderPool::Worker::run()
+{
+    // Spin briefly after each job (jobs arrive every block), then back off so idle workers don't burn a core
+    constexpr int SPIN_ITERATIONS = 4096;
+    constexpr int YIELD_ITERATIONS = 2048;
+    int idle = 0;
+
+    while (!threadShouldExit())
+    {
+        if (pool.drainTasks())
+        {
+            idle = 0;
+            continue;
+        }
+
+        ++idle;
+        if (idle < SPIN_ITERATIONS) continue;
+        if (idle < SPIN_ITERATIONS + YIELD_ITERATIONS) { juce::Thread::yield(); continue; }
+
+        // Parked: the audio thread renders any tasks we miss while asleep
+        wait(1);
+    }
+}
+
+} // namespace Core
+} // namespace CZ101
@@ -0,0 +1,83 @@
+#pragma once
+
+#include <juce_core/juce_core.h>
+#include <array>
+#include <atomic>
+#include <memory>
+#include <cstdint>
+
+namespace CZ101 {
+namespace Core {
+
+/**
+ * @brief Fixed pool of real-time worker threads for parallel voice rendering.
+ *
+ * The audio thread publishes a job (task function + context + task count)
+ * with a single atomic store; workers and the audio thread itself then claim
+ * task indices from one packed atomic word (generation | count | next index),
+ * so a worker that wakes late can never run a task of a newer job.
+ * The audio thread always participates, so a parked worker costs parallelism,
+ * never correctness, and run() returns after spin-waiting on the completion count.
+ *
+ * No locks or allocation on the audio thread. start()/stop() are message-thread only
+ * (prepareToPlay / releaseResources).
+ */
+class VoiceRenderPool
+{
+public:
+    using TaskFunction = void (*)(void* context, int taskIndex) noexcept;
+
+    static constexpr int MAX_WORKERS = 15; // + audio thread = 16 cores
+
+    VoiceRenderPool() = default;
+    ~VoiceRenderPool() { stop(); }
+
+    /**
+     * Spawns numWorkers real-time threads (clamped to MAX_WORKERS). 0 disables the pool,
+     * as does a worker the OS refuses real-time scheduling (check isRunning()).
+     */
+    void start(int numWorkers);
+    void stop();
+
+    int getNumWorkers() const noexcept { return numActiveWorkers; }
+    bool isRunning() const noexcept { return numActiveWorkers > 0; }
+
+    /**
+     * @brief Runs task(context, i) for i in [0, numTasks) across the pool and the calling thread.
+     * Returns when every task has completed. Audio thread only.
+     */
+    void run(TaskFunction task, void* context, int numTasks) noexcept;
+
+private:
+    class Worker : public juce::Thread
+    {
+    public:
+        Worker(VoiceRenderPool& p, int i) : juce::Thread("CZ101 Voice Worker " + juce::String(i)), pool(p) {}
+        void run() override;
+
+    private:
+        VoiceRenderPool& pool;
+    };
+
+    // Packed job word: [63..32] generation, [31..16] task count, [15..0] next task index
+    static constexpr uint64_t INDEX_MASK = 0xFFFFu;
+    static constexpr int COUNT_SHIFT = 16;
+    static constexpr int GENERATION_SHIFT = 32;
+
+    // Claims and runs tasks of the current job; returns false if the job was already drained
+    bool drainTasks() noexcept;
+
+    std::array<std::unique_ptr<Worker>, MAX_WORKERS> workers;
+    int numActiveWorkers = 0;
+
+    alignas(64) std::atomic<uint64_t> jobWord { 0 };
+    alignas(64) std::atomic<int> completedTasks { 0 };
+    std::atomic<TaskFunction> currentTask { nullptr };
+    std::atomic<void*> currentContext { nullptr };
+    uint32_t generation = 0; // Audio thread only
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(VoiceRenderPool)
+};
+
+} // namespace Core
+} // namespace CZ101
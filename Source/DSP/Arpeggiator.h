@@ -1,14 +1,28 @@
 #pragma once
 
 #include <juce_core/juce_core.h>
-#include <vector>
+#include <array>
 #include <algorithm>
-#include <set>
-#include <mutex>
+#include <cmath>
+#include <cstdint>
 
 namespace CZ101 {
 namespace DSP {
 
+/**
+ * @brief Tempo-synced arpeggiator (audio thread only)
+ *
+ * All state lives in fixed-size tables: noteOn/noteOff and the setters take no
+ * lock and never allocate, and each finishes in a bounded number of steps.
+ * process() places every step and gate-off at its exact sample within the block
+ * and writes them, offset-tagged, into a caller-owned EventBuffer.
+ *
+ * Clock: while the host transport plays (syncToHost() at each host block),
+ * step n sits at PPQ n * stepLength and its sample offset is solved from the
+ * block's PPQ and tempo, so nothing accumulates across blocks, tempo changes or
+ * loop jumps. Otherwise the arp free-runs at the last known tempo, counting in
+ * fractional samples.
+ */
 class Arpeggiator
 {
 public:
@@ -16,195 +30,264 @@ public:
     enum class Rate { _1_4, _1_8, _1_16, _1_32 };
     enum class SwingMode { Off, _1_8, _1_16 };
 
-    Arpeggiator() {}
+    static constexpr int NUM_MIDI_NOTES = 128;
+    static constexpr int MAX_OCTAVES = 4;
 
-    void setSampleRate(double sr) noexcept { sampleRate = sr; updatePhaseIncrement(); }
-    void setTempo(double bpm) noexcept { currentBpm = bpm; updatePhaseIncrement(); }
-    void setEnabled(bool shouldBeEnabled) noexcept { enabled = shouldBeEnabled; if (!enabled) allNotesOff(); }
+    struct ArpEvent {
+        int note;
+        float velocity;
+        bool isNoteOn;
+        int sampleOffset; // Position within the processed block, 0..numSamples-1
+    };
+
+    /** Fixed-capacity event list, in time order */
+    class EventBuffer
+    {
+    public:
+        static constexpr int CAPACITY = 64; // 1/32 steps at 300 BPM emit ~16 events per 8192-sample block
+
+        void clear() noexcept { count = 0; }
+        int size() const noexcept { return count; }
+        bool hasRoomFor(int numEvents) const noexcept { return count + numEvents <= CAPACITY; }
+        void add(const ArpEvent& e) noexcept { jassert(count < CAPACITY); if (count < CAPACITY) events[static_cast<size_t>(count++)] = e; }
+        const ArpEvent& operator[](int i) const noexcept { return events[static_cast<size_t>(i)]; }
+        const ArpEvent* begin() const noexcept { return events.data(); }
+        const ArpEvent* end() const noexcept { return events.data() + count; }
+
+    private:
+        std::array<ArpEvent, CAPACITY> events {};
+        int count = 0;
+    };
+
+    Arpeggiator() { heldVelocity.fill(0.0f); keyDown.fill(false); }
+
+    void setSampleRate(double sr) noexcept { sampleRate = sr; }
+    void setTempo(double bpm) noexcept { currentBpm = std::max(1.0, bpm); }
+    double getTempo() const noexcept { return currentBpm; }
+    void setEnabled(bool shouldBeEnabled) noexcept
+    {
+        if (shouldBeEnabled == enabled) return;
+        enabled = shouldBeEnabled;
+        if (!enabled) allNotesOff(); // The sounding step is released by the next process()
+    }
     bool isEnabled() const noexcept { return enabled; }
 
-    void setPattern(Pattern p) noexcept { currentPattern = p; reorderBuffer(); }
-    void setRate(Rate r) noexcept { currentRate = r; updatePhaseIncrement(); }
-    void setOctaveRange(int range) noexcept { octaveRange = std::clamp(range, 1, 4); }
-    void setLatch(bool shouldLatch) noexcept { latch = shouldLatch; }
+    void setPattern(Pattern p) noexcept { if (p != currentPattern) { currentPattern = p; rebuildActiveBuffer(); } }
+    void setRate(Rate r) noexcept { currentRate = r; }
+    void setOctaveRange(int range) noexcept
+    {
+        range = std::clamp(range, 1, MAX_OCTAVES);
+        if (range != octaveRange) { octaveRange = range; rebuildActiveBuffer(); }
+    }
+    void setLatch(bool shouldLatch) noexcept
+    {
+        if (shouldLatch == latch) return;
+        latch = shouldLatch;
+        if (!latch)
+        {
+            // Drop the latched notes whose keys are already up
+            for (int i = numHeld - 1; i >= 0; --i)
+                if (!keyDown[static_cast<size_t>(heldOrder[static_cast<size_t>(i)])])
+                    removeHeld(heldOrder[static_cast<size_t>(i)]);
+            rebuildActiveBuffer();
+        }
+    }
     void setGateTime(float g) noexcept { gateTime = std::clamp(g, 0.05f, 1.0f); }
     void setSwing(float s) noexcept { swingAmount = std::clamp(s, 0.0f, 1.0f); }
     void setJitter(float j) noexcept { jitterAmount = std::clamp(j, 0.0f, 1.0f); }
     void setSwingMode(SwingMode m) noexcept { currentSwingMode = m; }
 
     // Incoming Event Processing (Audio Thread)
-    void noteOn(int note, float velocity)
+    void noteOn(int note, float velocity) noexcept
     {
-        juce::ScopedLock sl(lock);
-        heldNotes.insert(note);
-        lastVelocities[note] = velocity;
-        
-        if (heldNotes.size() == 1 && latch && activeNotes.empty()) {
-            activeNotes.clear(); // Reset for new chord in latch mode?
-            phase = 1.0f; // Reset phase to trigger immediately
-        }
-        
+        if (note < 0 || note >= NUM_MIDI_NOTES) return;
+
+        // Latch: the first key after all keys were released starts a new chord
+        if (latch && numKeysDown == 0)
+            clearHeld();
+
+        if (!keyDown[static_cast<size_t>(note)]) { keyDown[static_cast<size_t>(note)] = true; ++numKeysDown; }
+        if (heldVelocity[static_cast<size_t>(note)] <= 0.0f)
+            heldOrder[static_cast<size_t>(numHeld++)] = note;
+        heldVelocity[static_cast<size_t>(note)] = std::max(velocity, MIN_VELOCITY);
+
         rebuildActiveBuffer();
     }
 
-    void noteOff(int note)
+    void noteOff(int note) noexcept
     {
-        juce::ScopedLock sl(lock);
-        heldNotes.erase(note);
-        if (!latch && heldNotes.empty()) {
-            activeNotes.clear();
-        } else if (!latch) {
+        if (note < 0 || note >= NUM_MIDI_NOTES || !keyDown[static_cast<size_t>(note)]) return;
+
+        keyDown[static_cast<size_t>(note)] = false;
+        --numKeysDown;
+
+        if (!latch)
+        {
+            removeHeld(note);
             rebuildActiveBuffer();
         }
     }
 
-    // Called per sample block
-    // Returns a generic "Event" struct or just callbacks?
-    // Let's use a simple struct for generated events
-    struct ArpEvent {
-        int note;
-        float velocity;
-        bool isNoteOn;
-    };
-
-    void process(int numSamples, std::vector<ArpEvent>& outEvents)
+    /**
+     * Advances numSamples and appends the step note-ons and gate note-offs that
+     * fall inside this block, each with its sample offset. If events runs out of
+     * room, the remaining ones are emitted at the start of the next block.
+     */
+    void process(int numSamples, EventBuffer& events) noexcept
     {
-        if (!enabled) return;
-
-        // Audit Fix: Ensure stuck notes are killed if Arp has no active notes
-        if (activeNotes.empty() && heldNotes.empty()) {
-            if (currentPlayingNote != -1) {
-                outEvents.push_back({ currentPlayingNote, 0.0f, false });
+        if (!enabled || numActive == 0)
+        {
+            // Audit Fix: Ensure stuck notes are killed if Arp has no active notes
+            if (currentPlayingNote != -1 && events.hasRoomFor(1))
+            {
+                events.add({ currentPlayingNote, 0.0f, false, 0 });
                 currentPlayingNote = -1;
             }
+            running = false;
+            if (hostPositionValid) advanceHostPosition(numSamples);
             return;
         }
 
-        // Tempo sync logic
-        float samplesPerBeat = (60.0f / currentBpm) * sampleRate;
-        float samplesPerStep = samplesPerBeat * getRateMultiplier();
-        
-        // Professional Swing Logic
-        float swingFactor = 1.0f;
-        if (currentSwingMode != SwingMode::Off)
+        if (hostPositionValid && host.isPlaying)
         {
-            // Determine if this is an "off-beat" step for the selected swing mode
-            bool isSwingStep = false;
-            
-            // For 1/8 swing: steps are relative to quarter notes.
-            // For 1/16 swing: steps are relative to quarter notes.
-            // Rate determines the step size.
-            // Professional swing usually delays the even subdivisions.
-            
-            // We need to know where we are in the beat.
-            // currentStep is the index in the activeNotes buffer, not necessarily the timing position.
-            // Let's use a timing counter. 
-            
-            // SIMPLIFIED PROFESSIONAL SWING:
-            // If currentSwingMode is 1/16, we delay every even 1/16th note.
-            // If currentSwingMode is 1/8, we delay every even 1/8th note.
-            
-            // We calculate the position in PPQ (4.0 = one whole note).
-            // But we use sample counting here. Let's track absolute step count.
-            
-            int timingStep = absoluteStepCount;
-            
-            // Map timingStep to the grid defined by currentRate.
-            float multiplier = getRateMultiplier(); // 1/4=1, 1/8=0.5, 1/16=0.25
-            double stepInQuarters = absoluteStepCount * multiplier;
-            
-            if (currentSwingMode == SwingMode::_1_8) {
-                // Swing on 0.5, 1.5, 2.5...
-                double remainder = fmod(stepInQuarters, 1.0);
-                if (std::abs(remainder - 0.5) < 0.01) isSwingStep = true;
-            } else if (currentSwingMode == SwingMode::_1_16) {
-                // Swing on 0.25, 0.75, 1.25, 1.75...
-                double remainder = fmod(stepInQuarters, 0.5);
-                if (std::abs(remainder - 0.25) < 0.01) isSwingStep = true;
-            }
-            
-            if (isSwingStep) swingFactor = 1.0f + (swingAmount * 0.66f); // Max 66% delay (triplet feel)
-            // Note: In a sample-based trigger system, delaying one step automatically shortens the gap to the next if the next is on time.
-            // Complex compensation not needed for basic swing in this architecture.
-        }
-
-        float currentStepDuration = samplesPerStep * swingFactor;
-        
-        // Phase 8: Microtiming Jitter (Humanization)
-        if (jitterAmount > 0.001f) {
-             // Jitter up to ±20ms (approx 880 samples at 44.1k) scaled by amount
-             float jitterSamples = (rng.nextFloat() * 2.0f - 1.0f) * (sampleRate * 0.02f) * jitterAmount;
-             currentStepDuration += jitterSamples;
-             // Ensure we don't go negative or too small
-             if (currentStepDuration < 100.0f) currentStepDuration = 100.0f;
+            processHostSynced(numSamples, events);
+            host.ppqPosition = hostPpqEnd;
+            return;
         }
 
-        // Gate Logic (Note Off)
-        // If gateTime < 1.0, we emit a Note Off at gateTime * currentStepDuration
-        if (currentPlayingNote != -1) {
-            stepsSinceNoteOn += numSamples;
-            float gateSamples = currentStepDuration * gateTime;
-            
-            // Only send note off if we haven't already, and if gate is expired 
-            // AND we aren't fully legato (gate >= 1.0 skips this, relies on next noteOn to stop prev)
-            if (gateTime < 0.99f && stepsSinceNoteOn >= gateSamples) {
-                 // But wait, we need to ensure we don't spam NoteOff. 
-                 // We don't track "noteOffSent" clearly. 
-                 // Simplification: We just use triggerNextStep to kill prev note if !legato
-                 // But for true staccato we need intermediate NoteOff.
-                 
-                 // Better: Retrigger logic handles NoteOff. 
-                 // Here we just handle early NoteOff for staccato.
-                 // We need a flag? Or just use currentPlayingNote value check?
-                 // Let's assume external voiceManager handles idempotent NoteOff.
-                 outEvents.push_back({ currentPlayingNote, 0.0f, false });
-                 currentPlayingNote = -1; 
+        if (!running || followingHost)
+        {
+            if (running)
+            {
+                // Transport stopped: free-run on from the next grid step
+                nextStepTime = std::max(0.0, std::ceil((nextStepPpq - hostPpqEnd) * samplesPerQuarter() - 1.0e-6));
+                gateOffTime = (gateOffPpq - hostPpqEnd) * samplesPerQuarter();
+                stepDisplacement = 0.0;
             }
+            else
+            {
+                // The pattern starts on the first note rather than one step later
+                resetPattern();
+                nextStepTime = 0.0;
+                stepDisplacement = 0.0;
+            }
+            running = true;
+            followingHost = false;
         }
 
-        phase += numSamples; // Advance phase
-
-        if (phase >= currentStepDuration)
+        const double blockLength = static_cast<double>(numSamples);
+        for (;;)
         {
-            phase -= currentStepDuration;
-            stepsSinceNoteOn = 0; // Reset gate timer
-            triggerNextStep(outEvents);
+            const bool gatePending = currentPlayingNote != -1 && gateTime < 0.99f; // Legato steps end at the next note-on
+            const bool gateFirst = gatePending && gateOffTime <= nextStepTime;
+            const double at = gateFirst ? gateOffTime : nextStepTime;
+            if (at >= blockLength || !events.hasRoomFor(2))
+                break;
+
+            const int offset = std::clamp(static_cast<int>(at), 0, numSamples - 1);
+            if (gateFirst)
+            {
+                events.add({ currentPlayingNote, 0.0f, false, offset });
+                currentPlayingNote = -1;
+            }
+            else
+            {
+                const double duration = nextStepDuration();
+                triggerNextStep(offset, events);
+                gateOffTime = nextStepTime + duration * gateTime;
+                nextStepTime += duration;
+            }
         }
+
+        // Times are block-relative; anything overdue fires at offset 0 next block
+        nextStepTime -= blockLength;
+        gateOffTime -= blockLength;
     }
-    
-    // For manual sync (e.g. from DAW PPQ)
-    void syncToHost(double ppqPosition) {
-        // Advanced: implementation left for future
+
+    /** Host transport at the first sample of a block (from juce::AudioPlayHead) */
+    struct HostPosition
+    {
+        double bpm = 120.0;
+        double ppqPosition = 0.0;
+        bool isPlaying = false;
+        bool isLooping = false;
+        double loopStartPpq = 0.0;
+        double loopEndPpq = 0.0;
+    };
+
+    /**
+     * Position at the start of the next process(). Consecutive process() calls (sub-blocks
+     * of one host block) continue from where the previous one ended, until the next call.
+     */
+    void syncToHost(const HostPosition& position) noexcept
+    {
+        setTempo(position.bpm);
+        host = position;
+        hostPositionValid = true;
     }
 
+    /** No host position for this block: free-run at the last tempo */
+    void clearHostSync() noexcept { hostPositionValid = false; }
+
 private:
+    static constexpr float MIN_VELOCITY = 1.0e-3f; // heldVelocity 0 marks "not held"
+
     double sampleRate = 44100.0;
     double currentBpm = 120.0;
     bool enabled = false;
     bool latch = false;
-    
+
     Pattern currentPattern = Pattern::Up;
     Rate currentRate = Rate::_1_8;
     int octaveRange = 1;
-    
-    float phase = 0.0f; // Sample counter for timing
+
     float gateTime = 0.5f; // 0..1
     float swingAmount = 0.0f; // 0..1 (0.5 = normal swing)
     SwingMode currentSwingMode = SwingMode::Off;
-    
-    std::set<int> heldNotes; // Raw physical keys held
-    std::vector<int> activeNotes; // Expanded buffer (sorted/rng + octaves)
-    int currentStep = 0;
+
+    // Held chord: velocity per note (0 = not held) plus press order for AsPlayed
+    std::array<float, NUM_MIDI_NOTES> heldVelocity;
+    std::array<int, NUM_MIDI_NOTES> heldOrder {};
+    int numHeld = 0;
+    std::array<bool, NUM_MIDI_NOTES> keyDown; // Physical keys (differs from the chord while latched)
+    int numKeysDown = 0;
+
+    // Expanded buffer (pattern order + octaves)
+    struct ActiveNote { int note; float velocity; };
+    std::array<ActiveNote, NUM_MIDI_NOTES * MAX_OCTAVES> activeNotes {};
+    int numActive = 0;
+
+    // Timing, in samples relative to the start of the block being processed
+    bool running = false;
+    double nextStepTime = 0.0;
+    double gateOffTime = 0.0;
+    double stepDisplacement = 0.0; // Swing + jitter offset of the current step from the straight grid
+    int currentStep = -1;
+    bool goingUp = true;
     int absoluteStepCount = 0;
     int currentPlayingNote = -1; // Currently sounding note (to send noteOff)
-    int stepsSinceNoteOn = 0;
-    
+
+    // Host clock: PPQ of the next step onset and pending gate-off, and where the last block ended
+    HostPosition host;
+    bool hostPositionValid = false;
+    bool followingHost = false;
+    int64_t nextStepIndex = 0;
+    double nextStepPpq = 0.0;
+    double gateOffPpq = 0.0;
+    double hostPpqEnd = 0.0;
+
     // Phase 8
     float jitterAmount = 0.0f;
     juce::Random rng;
-    
-    std::map<int, float> lastVelocities;
-    juce::CriticalSection lock;
+
+    double samplesPerQuarter() const noexcept { return (60.0 / currentBpm) * sampleRate; }
+
+    void resetPattern() noexcept
+    {
+        currentStep = -1;
+        goingUp = true;
+        absoluteStepCount = 0;
+    }
 
     float getRateMultiplier() const {
         switch (currentRate) {
@@ -216,89 +299,227 @@ private:
         }
     }
 
-    void updatePhaseIncrement() {
-        // No pre-calc needed for sample counting method
+    void allNotesOff() noexcept
+    {
+        clearHeld();
+        keyDown.fill(false);
+        numKeysDown = 0;
+        numActive = 0;
+        absoluteStepCount = 0;
     }
 
-    void allNotesOff() {
-        heldNotes.clear();
-        activeNotes.clear();
-        currentPlayingNote = -1;
-        absoluteStepCount = 0;
+    void clearHeld() noexcept
+    {
+        for (int i = 0; i < numHeld; ++i)
+            heldVelocity[static_cast<size_t>(heldOrder[static_cast<size_t>(i)])] = 0.0f;
+        numHeld = 0;
     }
 
-    void rebuildActiveBuffer()
+    void removeHeld(int note) noexcept
     {
-        // Don't clear immediately if using "Add" mode, but for simple ARP:
-        activeNotes.clear();
-        if (heldNotes.empty()) {
+        if (heldVelocity[static_cast<size_t>(note)] <= 0.0f) return;
+        heldVelocity[static_cast<size_t>(note)] = 0.0f;
+
+        auto* first = heldOrder.data();
+        auto* last = std::remove(first, first + numHeld, note);
+        numHeld = static_cast<int>(last - first);
+    }
+
+    // Bounded (128 x octaves) and allocation-free; runs on every chord or pattern change
+    void rebuildActiveBuffer() noexcept
+    {
+        numActive = 0;
+        if (numHeld == 0) {
             absoluteStepCount = 0;
             return;
         }
 
-        std::vector<int> baseNotes(heldNotes.begin(), heldNotes.end()); // Already sorted (set)
-        
-        // AsPlayed logic requires tracking insertion order, Set loses it.
-        // For Up/Down/UpDn/Random, Set is fine.
-        
-        for (int oct = 0; oct < octaveRange; ++oct) {
-            for (int note : baseNotes) {
-                int mapped = note + (oct * 12);
-                if (mapped < 128) activeNotes.push_back(mapped);
+        auto add = [this](int mapped, int base) {
+            activeNotes[static_cast<size_t>(numActive++)] = { mapped, heldVelocity[static_cast<size_t>(base)] };
+        };
+
+        if (currentPattern == Pattern::AsPlayed)
+        {
+            for (int oct = 0; oct < octaveRange; ++oct)
+                for (int i = 0; i < numHeld; ++i)
+                {
+                    const int base = heldOrder[static_cast<size_t>(i)];
+                    if (base + oct * 12 < NUM_MIDI_NOTES) add(base + oct * 12, base);
+                }
+            return;
+        }
+
+        // Ascending pitch across all octave copies (a note can appear twice, e.g. C3 up one octave and C4)
+        for (int mapped = 0; mapped < NUM_MIDI_NOTES; ++mapped)
+            for (int oct = 0; oct < octaveRange; ++oct)
+            {
+                const int base = mapped - oct * 12;
+                if (base >= 0 && heldVelocity[static_cast<size_t>(base)] > 0.0f) add(mapped, base);
             }
+
+        // Random picks an index per step; UpDown ping-pongs over the ascending order
+        if (currentPattern == Pattern::Down)
+            std::reverse(activeNotes.begin(), activeNotes.begin() + numActive);
+    }
+
+    // Professional Swing Logic: the off-beat subdivision of the swing grid is delayed
+    bool isSwingStep(int step) const noexcept
+    {
+        if (currentSwingMode == SwingMode::Off) return false;
+
+        const double stepInQuarters = step * static_cast<double>(getRateMultiplier());
+        const double period = currentSwingMode == SwingMode::_1_8 ? 1.0 : 0.5;
+        return std::abs(std::fmod(stepInQuarters, period) - period * 0.5) < 0.01;
+    }
+
+    /**
+     * Host-synced block: the block is split where the host loop wraps, and each
+     * part maps samples to PPQ from its own start. A part that does not continue
+     * where the previous one ended (loop wrap, relocation, transport start)
+     * releases the sounding step and re-enters the grid at the next step.
+     */
+    void processHostSynced(int numSamples, EventBuffer& events) noexcept
+    {
+        const double quartersPerSample = 1.0 / samplesPerQuarter();
+        const double blockEndPpq = host.ppqPosition + numSamples * quartersPerSample;
+
+        int wrapSample = numSamples;
+        const double loopLength = host.loopEndPpq - host.loopStartPpq;
+        if (host.isLooping && loopLength > 0.0 && host.ppqPosition < host.loopEndPpq && blockEndPpq > host.loopEndPpq)
+            wrapSample = std::clamp(static_cast<int>(std::ceil((host.loopEndPpq - host.ppqPosition) / quartersPerSample)), 0, numSamples);
+
+        if (wrapSample == numSamples)
+        {
+            processHostSegment(0, numSamples, host.ppqPosition, blockEndPpq, quartersPerSample, events);
+            return;
         }
-        
-        reorderBuffer();
+
+        // Steps at the loop end belong to the loop start
+        processHostSegment(0, wrapSample, host.ppqPosition, host.loopEndPpq, quartersPerSample, events);
+        const double wrappedPpq = host.ppqPosition + wrapSample * quartersPerSample - loopLength;
+        processHostSegment(wrapSample, numSamples - wrapSample, wrappedPpq, blockEndPpq - loopLength, quartersPerSample, events);
     }
-    
-    void reorderBuffer()
+
+    void advanceHostPosition(int numSamples) noexcept
     {
-        if (activeNotes.empty()) return;
+        host.ppqPosition += numSamples / samplesPerQuarter();
+        const double loopLength = host.loopEndPpq - host.loopStartPpq;
+        if (host.isLooping && loopLength > 0.0 && host.ppqPosition >= host.loopEndPpq)
+            host.ppqPosition -= loopLength;
+    }
 
-        switch (currentPattern) {
-            case Pattern::Up:
-                std::sort(activeNotes.begin(), activeNotes.end());
-                break;
-            case Pattern::Down:
-                std::sort(activeNotes.begin(), activeNotes.end(), std::greater<int>());
-                break;
-            case Pattern::UpDown:
-                // Construct bounce? Or just index ping-pong?
-                // Let's implement Index Ping-Pong in trigger step instead for efficiency
-                std::sort(activeNotes.begin(), activeNotes.end());
-                break;
-            case Pattern::Random:
-                // Shuffle handled at trigger time or here?
-                // Real random picks randomly each step
-                break;
-            case Pattern::AsPlayed:
-                // Not supported with std::set base implementation yet
+    void processHostSegment(int startSample, int length, double startPpq, double endPpq, double quartersPerSample, EventBuffer& events) noexcept
+    {
+        if (length <= 0) return;
+
+        const double stepQuarters = getRateMultiplier();
+
+        // Tempo changes between blocks move the PPQ by far less than this; anything larger is a jump
+        constexpr double jumpTolerance = 1.0e-3;
+        const bool jumped = startPpq < hostPpqEnd - jumpTolerance || startPpq > hostPpqEnd + stepQuarters;
+        if (!running || !followingHost || jumped)
+        {
+            if (currentPlayingNote != -1 && events.hasRoomFor(1))
+            {
+                events.add({ currentPlayingNote, 0.0f, false, startSample });
+                currentPlayingNote = -1;
+            }
+            if (!running) resetPattern();
+            running = followingHost = true;
+
+            // The first sample also covers the PPQ span just before it (a loop start falls there)
+            nextStepIndex = static_cast<int64_t>(std::ceil((startPpq - quartersPerSample) / stepQuarters - 1.0e-9));
+            nextStepPpq = stepOnsetPpq(nextStepIndex);
+        }
+
+        for (;;)
+        {
+            const bool gatePending = currentPlayingNote != -1 && gateTime < 0.99f;
+            const bool gateFirst = gatePending && gateOffPpq <= nextStepPpq;
+            const double at = gateFirst ? gateOffPpq : nextStepPpq;
+
+            // First sample at or after the event's PPQ (overdue events fire at once)
+            const int offset = startSample + std::max(0, static_cast<int>(std::ceil((at - startPpq) / quartersPerSample - 1.0e-9)));
+            if (at >= endPpq || offset >= startSample + length || !events.hasRoomFor(2))
                 break;
+
+            if (gateFirst)
+            {
+                events.add({ currentPlayingNote, 0.0f, false, offset });
+                currentPlayingNote = -1;
+            }
+            else
+            {
+                absoluteStepCount = static_cast<int>(nextStepIndex);
+                triggerNextStep(offset, events);
+
+                const double onset = nextStepPpq;
+                nextStepPpq = stepOnsetPpq(++nextStepIndex);
+                gateOffPpq = onset + (nextStepPpq - onset) * gateTime;
+            }
         }
+
+        hostPpqEnd = endPpq;
+    }
+
+    /** PPQ of grid step n, moved by swing and jitter (same limits as the free-running clock) */
+    double stepOnsetPpq(int64_t step) noexcept
+    {
+        const double stepQuarters = getRateMultiplier();
+
+        double displacement = 0.0;
+        if (isSwingStep(static_cast<int>(step)))
+            displacement += stepQuarters * swingAmount * 0.66;
+        if (jitterAmount > 0.001f)
+            displacement += (rng.nextFloat() * 2.0f - 1.0f) * 0.02 * jitterAmount * (currentBpm / 60.0);
+
+        displacement = std::clamp(displacement, -0.3 * stepQuarters, 0.7 * stepQuarters);
+        return static_cast<double>(step) * stepQuarters + displacement;
     }
 
-    void triggerNextStep(std::vector<ArpEvent>& events)
+    /**
+     * Length of the step about to start. Swing and jitter move each onset away from
+     * the straight grid without accumulating: the step before a delayed one grows by
+     * the delay and the delayed one shrinks by it.
+     */
+    double nextStepDuration() noexcept
     {
-        if (activeNotes.empty()) return;
+        const double samplesPerStep = samplesPerQuarter() * getRateMultiplier();
 
+        double displacement = 0.0;
+        if (isSwingStep(absoluteStepCount + 1))
+            displacement += samplesPerStep * swingAmount * 0.66; // Max 66% delay (triplet feel)
+
+        // Phase 8: Microtiming Jitter (Humanization), up to ±20ms scaled by amount
+        if (jitterAmount > 0.001f)
+            displacement += (rng.nextFloat() * 2.0f - 1.0f) * (sampleRate * 0.02) * jitterAmount;
+
+        // Keep every onset inside its own grid slot so steps never reorder
+        displacement = std::clamp(displacement, -0.3 * samplesPerStep, 0.7 * samplesPerStep);
+
+        const double duration = samplesPerStep + displacement - stepDisplacement;
+        stepDisplacement = displacement;
+        return std::max(1.0, duration);
+    }
+
+    void triggerNextStep(int sampleOffset, EventBuffer& events) noexcept
+    {
         // 1. Note Off previous
         if (currentPlayingNote != -1) {
-            events.push_back({ currentPlayingNote, 0.0f, false });
+            events.add({ currentPlayingNote, 0.0f, false, sampleOffset });
         }
 
         // 2. Select next note
         int noteIndex = 0;
-        
+
         if (currentPattern == Pattern::Random) {
-            static juce::Random rng;
-            noteIndex = rng.nextInt((int)activeNotes.size());
+            noteIndex = rng.nextInt(numActive);
         } else if (currentPattern == Pattern::UpDown) {
             // Ping pong logic
-            static bool goingUp = true;
             if (goingUp) {
                 currentStep++;
-                if (currentStep >= activeNotes.size()) {
-                    currentStep = (int)activeNotes.size() - 2;
+                if (currentStep >= numActive) {
+                    currentStep = numActive - 2;
                     goingUp = false;
                 }
             } else {
@@ -309,26 +530,20 @@ private:
                 }
             }
             // Clamp
-            currentStep = std::max(0, std::min(currentStep, (int)activeNotes.size() - 1));
+            currentStep = std::max(0, std::min(currentStep, numActive - 1));
             noteIndex = currentStep;
         } else {
-            // Up / Down (Buffers already sorted)
-            currentStep = (currentStep + 1) % activeNotes.size();
+            // Up / Down / AsPlayed (buffer already in pattern order)
+            currentStep = (currentStep + 1) % numActive;
             noteIndex = currentStep;
         }
 
         absoluteStepCount++;
-        int note = activeNotes[noteIndex];
-        // Find original velocity (modulo octave)
-        int originalNote = note % 12 + (note / 12 - (note/12)) * 12; // Crude...
-        // Better: find closest match in lastVelocities map? 
-        // Or just store velocity in activeNotes pair?
-        // Fallback to 0.8f for now
-        float velocity = 0.8f; 
-        
+        const auto& step = activeNotes[static_cast<size_t>(std::clamp(noteIndex, 0, numActive - 1))];
+
         // 3. Note On
-        currentPlayingNote = note;
-        events.push_back({ note, velocity, true });
+        currentPlayingNote = step.note;
+        events.add({ step.note, step.velocity, true, sampleOffset });
     }
 };
 
@@ -1,5 +1,6 @@
 #include <JuceHeader.h>
 #include "DriveEffect.h"
+#include "../../Utils/FastMath.h"
 #include <cmath>
 
 namespace CZ101 {
@@ -60,7 +61,7 @@ float DriveEffect::processSample(float input)
     float x = input * drive;
     
     // Tanh Saturation
-    float saturated = std::tanh(x);
+    float saturated = Utils::FastMath::tanh(x);
     
     // Make-up gain / Headroom
     return saturated * 0.8f; 
@@ -43,8 +43,11 @@ void EffectsChain::reset()
 
 void EffectsChain::process(juce::AudioBuffer<float>& buffer, const CZ101::Core::ParameterSnapshot& snapshot)
 {
-    const auto& eff = snapshot.effects;
-    int opMode = snapshot.system.opMode;
+    process(buffer, snapshot.effects, snapshot.system.opMode);
+}
+
+void EffectsChain::process(juce::AudioBuffer<float>& buffer, const CZ101::Core::ParameterSnapshot::EffectsParams& eff, int opMode)
+{
     bool isModern = (opMode == 2);
     bool isClassic5000 = (opMode == 1);
 
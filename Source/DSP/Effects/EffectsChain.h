@@ -6,8 +6,7 @@
 #include "StereoDelay.h"
 #include "Reverb.h"
 
-// Forward Declaration to avoid include issues
-namespace CZ101 { namespace Core { struct ParameterSnapshot; } }
+#include "../../Core/AudioThreadSnapshot.h"
 
 
 namespace CZ101 {
@@ -29,6 +28,9 @@ public:
      * @param snapshot Current parameter snapshot (must be valid)
      */
     void process(juce::AudioBuffer<float>& buffer, const CZ101::Core::ParameterSnapshot& snapshot);
+    
+    /** Same, with effect parameters supplied separately (automated values on top of the snapshot) */
+    void process(juce::AudioBuffer<float>& buffer, const CZ101::Core::ParameterSnapshot::EffectsParams& eff, int opMode);
 
 private:
     // Modern Filters
@@ -0,0 +1,154 @@
+#include "HalfBandDecimator.h"
+#include <juce_audio_basics/juce_audio_basics.h>
+#include <cmath>
+#include <algorithm>
+
+namespace CZ101 {
+namespace DSP {
+
+namespace
+{
+    // Zeroth-order modified Bessel function (Kaiser window)
+    double besselI0(double x) noexcept
+    {
+        double sum = 1.0, term = 1.0;
+        for (int k = 1; k < 50; ++k)
+        {
+            const double t = x / (2.0 * k);
+            term *= t * t;
+            sum += term;
+            if (term < 1.0e-12 * sum) break;
+        }
+        return sum;
+    }
+}
+
+HalfBandDecimator::HalfBandDecimator(int order, float kaiserBeta)
+    : halfOrder(order | 1), // Must be odd for the half-band zero pattern
+      oddDelay((halfOrder + 1) / 2)
+{
+    const int length = 2 * halfOrder + 1;
+    std::vector<double> h((size_t)length);
+    double sum = 0.0;
+
+    for (int i = 0; i < length; ++i)
+    {
+        const int n = i - halfOrder;
+        const double sinc = (n == 0) ? 0.5 : std::sin(juce::MathConstants<double>::pi * n * 0.5) / (juce::MathConstants<double>::pi * n);
+        const double r = 2.0 * i / (length - 1) - 1.0;
+        const double window = besselI0(kaiserBeta * std::sqrt(std::max(0.0, 1.0 - r * r))) / besselI0(kaiserBeta);
+        h[(size_t)i] = sinc * window;
+        sum += h[(size_t)i];
+    }
+
+    // Unity DC gain. Even taps feed the FIR branch; the odd taps are zero except the centre
+    centreTap = static_cast<float>(h[(size_t)halfOrder] / sum);
+    evenTaps.resize((size_t)halfOrder + 1);
+    for (int j = 0; j <= halfOrder; ++j)
+        evenTaps[(size_t)j] = static_cast<float>(h[(size_t)(2 * j)] / sum);
+
+    evenHistory.assign((size_t)(halfOrder + CHUNK), 0.0f);
+    oddHistory.assign((size_t)(oddDelay + CHUNK), 0.0f);
+}
+
+void HalfBandDecimator::reset() noexcept
+{
+    std::fill(evenHistory.begin(), evenHistory.end(), 0.0f);
+    std::fill(oddHistory.begin(), oddHistory.end(), 0.0f);
+}
+
+void HalfBandDecimator::process(const float* input, float* output, int numOutputSamples) noexcept
+{
+    for (int pos = 0; pos < numOutputSamples; pos += CHUNK)
+    {
+        const int n = std::min(CHUNK, numOutputSamples - pos);
+        processChunk(input + 2 * pos, output + pos, n);
+    }
+}
+
+void HalfBandDecimator::processChunk(const float* input, float* output, int numOut) noexcept
+{
+    float* even = evenHistory.data();
+    float* odd = oddHistory.data();
+
+    // Polyphase split (reads all input before any output is written, so in-place use is safe)
+    for (int i = 0; i < numOut; ++i)
+    {
+        even[halfOrder + i] = input[2 * i];
+        odd[oddDelay + i] = input[2 * i + 1];
+    }
+
+    // y[m] = centreTap * odd[m - oddDelay] + sum_j evenTaps[j] * even[m - j]
+    // Linear phase: evenTaps[j] == evenTaps[halfOrder - j], so taps are applied to pre-summed pairs.
+    // Accumulated in a local chunk with the tap loop outside: the inner loop is a plain
+    // multiply-add over consecutive outputs, which vectorises without a horizontal sum
+    // and without per-call overhead on the short (one control period) segments Voice feeds in.
+    float acc[CHUNK];
+    for (int i = 0; i < numOut; ++i)
+        acc[i] = centreTap * odd[i];
+
+    for (int j = 0; j < (halfOrder + 1) / 2; ++j)
+    {
+        const float tap = evenTaps[(size_t)j];
+        const float* newer = even + halfOrder - j;
+        const float* older = even + j;
+        for (int i = 0; i < numOut; ++i)
+            acc[i] += tap * (newer[i] + older[i]);
+    }
+
+    std::copy(acc, acc + numOut, output);
+
+    // Slide history
+    std::copy(even + numOut, even + numOut + halfOrder, even);
+    std::copy(odd + numOut, odd + numOut + oddDelay, odd);
+}
+
+//==============================================================================
+OversamplingDecimator::OversamplingDecimator()
+    : finalStage(FINAL_HALF_ORDER, 8.0f),
+      firstStage(FIRST_HALF_ORDER, 7.0f)
+{
+}
+
+void OversamplingDecimator::setFactor(int newFactor) noexcept
+{
+    newFactor = (newFactor >= 4) ? 4 : (newFactor >= 2 ? 2 : 1);
+    if (newFactor == factor) return;
+
+    factor = newFactor;
+    reset();
+}
+
+void OversamplingDecimator::reset() noexcept
+{
+    finalStage.reset();
+    firstStage.reset();
+}
+
+void OversamplingDecimator::process(float* input, float* output, int numOutputSamples) noexcept
+{
+    if (factor == 4)
+    {
+        firstStage.process(input, input, numOutputSamples * 2); // 4x -> 2x in place
+        finalStage.process(input, output, numOutputSamples);
+    }
+    else if (factor == 2)
+    {
+        finalStage.process(input, output, numOutputSamples);
+    }
+    else
+    {
+        std::copy(input, input + numOutputSamples, output);
+    }
+}
+
+float OversamplingDecimator::getLatencySamples(int factor) noexcept
+{
+    // Each stage delays by its halfOrder at its own input rate
+    if (factor >= 4) return FINAL_HALF_ORDER / 2.0f + FIRST_HALF_ORDER / 4.0f;
+    if (factor >= 2) return FINAL_HALF_ORDER / 2.0f;
+    return 0.0f;
+}
+
+} // namespace DSP
+} // namespace CZ101
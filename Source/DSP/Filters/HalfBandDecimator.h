@@ -0,0 +1,86 @@
+#pragma once
+
+#include <vector>
+
+namespace CZ101 {
+namespace DSP {
+
+/**
+ * @brief Polyphase half-band FIR decimator (2:1)
+ *
+ * Linear-phase Kaiser-windowed half-band of length 2*halfOrder + 1 (halfOrder odd).
+ * Every other tap is zero and the centre tap is 0.5, so the filter splits into
+ * an even-sample FIR of halfOrder + 1 taps and a pure delay on the odd samples.
+ * Only the even branch costs multiplies (halved again by tap symmetry), and it runs
+ * tap-major over a chunk of outputs so the compiler vectorises the inner loop.
+ *
+ * History is kept between calls (per-block state); any block length is accepted.
+ */
+class HalfBandDecimator
+{
+public:
+    /**
+     * @param halfOrder Centre index of the prototype, odd (filter length 2*halfOrder + 1)
+     * @param kaiserBeta Window shape (stopband attenuation vs transition width)
+     */
+    HalfBandDecimator(int halfOrder, float kaiserBeta);
+
+    void reset() noexcept;
+
+    /**
+     * @brief Decimate 2*numOutputSamples input samples into numOutputSamples
+     * output may equal input (each chunk is split into history before it is written).
+     */
+    void process(const float* input, float* output, int numOutputSamples) noexcept;
+
+    /** Group delay in input-rate samples (= halfOrder). */
+    int getLatencyInInputSamples() const noexcept { return halfOrder; }
+
+private:
+    static constexpr int CHUNK = 64; // Output samples per inner pass
+
+    int halfOrder;
+    int oddDelay;                    // (halfOrder + 1) / 2 output samples
+    float centreTap = 0.5f;
+    std::vector<float> evenTaps;     // h[2j], j = 0..halfOrder
+    std::vector<float> evenHistory;  // halfOrder history + CHUNK new
+    std::vector<float> oddHistory;   // oddDelay history + CHUNK new
+
+    void processChunk(const float* input, float* output, int numOut) noexcept;
+};
+
+/**
+ * @brief 2x / 4x decimation chain built from half-band stages
+ *
+ * 2x: one 63-tap stage. Flat to 0.2 fs_in (18 kHz at a 44.1 kHz base rate, 0.44 dB down at 20 kHz);
+ *     anything that would fold below that is at least 81 dB down.
+ * 4x: a short 23-tap stage 4x->2x (-73 dB over the bands folding into the audio range) followed by the 2x stage.
+ */
+class OversamplingDecimator
+{
+public:
+    static constexpr int MAX_FACTOR = 4;
+
+    OversamplingDecimator();
+
+    void setFactor(int factor) noexcept; // 1, 2 or 4; resets state on change
+    int getFactor() const noexcept { return factor; }
+    void reset() noexcept;
+
+    /** input holds numOutputSamples * factor samples; it is used as scratch by the 4x path. */
+    void process(float* input, float* output, int numOutputSamples) noexcept;
+
+    /** Group delay at the base sample rate. */
+    static float getLatencySamples(int factor) noexcept;
+
+private:
+    static constexpr int FINAL_HALF_ORDER = 31;
+    static constexpr int FIRST_HALF_ORDER = 11;
+
+    int factor = 1;
+    HalfBandDecimator finalStage;   // 2x -> 1x
+    HalfBandDecimator firstStage;   // 4x -> 2x
+};
+
+} // namespace DSP
+} // namespace CZ101
@@ -0,0 +1,57 @@
+#include "SVFFilter.h"
+#include <cmath>
+
+namespace CZ101 {
+namespace DSP {
+
+const std::array<float, SVFCutoffTable::SIZE + 1> SVFCutoffTable::table = []
+{
+    std::array<float, SIZE + 1> t {};
+    for (int i = 0; i <= SIZE; ++i)
+    {
+        // The last entry (tan(pi/2)) is never reached: lookups stop at MAX_NORMALIZED_CUTOFF
+        const double x = std::min(static_cast<double>(i) / SCALE, 0.4999);
+        t[static_cast<size_t>(i)] = static_cast<float>(std::tan(3.14159265358979323846 * x));
+    }
+    return t;
+}();
+
+void SVFVoiceFilter::reset() noexcept
+{
+    state.low1 = state.low2 = 0.0f;
+    state.high1 = state.high2 = 0.0f;
+}
+
+void SVFVoiceFilter::setTargets(const SVFTargets& target, int numSamples) noexcept
+{
+    const float invSamples = 1.0f / static_cast<float>(std::max(1, numSamples));
+    state.lowGStep = (target.lowG - state.lowG) * invSamples;
+    state.lowKStep = (target.lowK - state.lowK) * invSamples;
+    state.highGStep = (target.highG - state.highG) * invSamples;
+}
+
+void SVFVoiceFilter::snapTo(const SVFTargets& target) noexcept
+{
+    state.lowG = target.lowG;
+    state.lowK = target.lowK;
+    state.highG = target.highG;
+    state.lowGStep = state.lowKStep = state.highGStep = 0.0f;
+}
+
+float SVFVoiceFilter::processSample(float input) noexcept
+{
+    float band, low;
+    tick(input, state.lowG, state.lowK, state.low1, state.low2, band, low);
+
+    float highBand, highLow;
+    tick(low, state.highG, HIGHPASS_K, state.high1, state.high2, highBand, highLow);
+    const float high = low - HIGHPASS_K * highBand - highLow;
+
+    state.lowG += state.lowGStep;
+    state.lowK += state.lowKStep;
+    state.highG += state.highGStep;
+    return high;
+}
+
+} // namespace DSP
+} // namespace CZ101
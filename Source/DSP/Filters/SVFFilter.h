@@ -0,0 +1,104 @@
+#pragma once
+
+#include <array>
+#include <algorithm>
+
+namespace CZ101 {
+namespace DSP {
+
+/**
+ * @brief tan(pi * f / fs) lookup for the TPT integrator gain
+ *
+ * Linear interpolation over 1024 segments of [0, 0.5): relative error below 3e-5
+ * up to MAX_NORMALIZED_CUTOFF, so control-rate coefficient updates cost a table
+ * read instead of a tan() per voice.
+ */
+class SVFCutoffTable
+{
+public:
+    static constexpr float MAX_NORMALIZED_CUTOFF = 0.45f; // 19.8 kHz at 44.1 kHz
+
+    /** @param normalizedCutoff f / fs, clamped to [0, MAX_NORMALIZED_CUTOFF] */
+    static float gain(float normalizedCutoff) noexcept
+    {
+        const float x = std::min(std::max(normalizedCutoff, 0.0f), MAX_NORMALIZED_CUTOFF) * SCALE;
+        const int i = static_cast<int>(x);
+        const float frac = x - static_cast<float>(i);
+        return table[static_cast<size_t>(i)] + frac * (table[static_cast<size_t>(i) + 1] - table[static_cast<size_t>(i)]);
+    }
+
+    /** Block form: out[i] = gain(in[i]), in == out allowed */
+    static void gain(const float* in, float* out, int numValues) noexcept
+    {
+        for (int i = 0; i < numValues; ++i) out[i] = gain(in[i]);
+    }
+
+private:
+    static constexpr int SIZE = 1024;
+    static constexpr float SCALE = SIZE * 2.0f; // Table spans [0, 0.5)
+    static const std::array<float, SIZE + 1> table;
+};
+
+/** Control-rate targets for one voice's LPF -> HPF pair */
+struct SVFTargets
+{
+    float lowG = 0.0f;   // tan(pi * lpfCutoff / fs)
+    float lowK = 1.0f;   // 1 / Q
+    float highG = 0.0f;  // tan(pi * hpfCutoff / fs)
+};
+
+/**
+ * @brief Per-voice LPF -> HPF in TPT state-variable form (trapezoidal SVF)
+ *
+ * g and k ramp linearly per sample between control-rate targets and a1..a3 are
+ * derived from them every sample. Every intermediate (g, k) is a valid filter, so
+ * fast sweeps stay stable and zipper-free, which interpolated biquad coefficients
+ * do not guarantee. SVFFilterBank runs the same recursion across voices.
+ */
+class SVFVoiceFilter
+{
+public:
+    static constexpr float HIGHPASS_K = 1.0f / 0.7f; // Fixed Q of 0.7 (as the former biquad HPF)
+
+    /** Everything the bank needs to continue this voice's filter (coefficients, ramps, integrators) */
+    struct State
+    {
+        float lowG = 0.0f, lowK = 1.0f, highG = 0.0f;
+        float lowGStep = 0.0f, lowKStep = 0.0f, highGStep = 0.0f;
+        float low1 = 0.0f, low2 = 0.0f;   // LPF integrator states
+        float high1 = 0.0f, high2 = 0.0f; // HPF integrator states
+    };
+
+    /** Clears the integrators (coefficients are kept) */
+    void reset() noexcept;
+
+    /** Ramp from the current coefficients to target over numSamples */
+    void setTargets(const SVFTargets& target, int numSamples) noexcept;
+
+    /** Jump to target without a ramp (first tick after a sample rate change) */
+    void snapTo(const SVFTargets& target) noexcept;
+
+    float processSample(float input) noexcept;
+
+    State& getState() noexcept { return state; }
+    const State& getState() const noexcept { return state; }
+
+    /** One trapezoidal SVF step: returns the lowpass (v2) and band (v1) outputs and updates ic1/ic2 */
+    static inline void tick(float input, float g, float k, float& ic1, float& ic2, float& band, float& low) noexcept
+    {
+        const float a1 = 1.0f / (1.0f + g * (g + k));
+        const float a2 = g * a1;
+        const float a3 = g * a2;
+        const float v3 = input - ic2;
+        band = a1 * ic1 + a2 * v3;
+        low = ic2 + a2 * ic1 + a3 * v3;
+        ic1 = 2.0f * band - ic1;
+        ic2 = 2.0f * low - ic2;
+    }
+
+private:
+    State state;
+};
+
+} // namespace DSP
+} // namespace CZ101
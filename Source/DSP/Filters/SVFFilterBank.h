@@ -0,0 +1,124 @@
+#pragma once
+
+#include "SVFFilter.h"
+#include <juce_core/juce_core.h>
+#include <array>
+#include <algorithm>
+
+namespace CZ101 {
+namespace DSP {
+
+/**
+ * @brief Voice-parallel SVFVoiceFilter (LPF -> HPF) for one control segment
+ *
+ * Voices load their filter state into SoA lanes, write their pre-filter signal
+ * into the input, process() runs the recursion for all lanes and the voices
+ * store the state back. State lives in the voice, so a voice can move between
+ * this bank and its own scalar path (parallel rendering, per-voice oversampling)
+ * without a discontinuity.
+ *
+ * The recursion runs sample-outer over blocks of LANE_BLOCK voices held in local
+ * arrays; the lane loops are straight-line (the per-sample a1 divide included), so
+ * the compiler keeps each block in SIMD registers (4 voices per SSE/NEON register,
+ * 8 per AVX) with no intrinsics. Results match SVFVoiceFilter bit for bit when
+ * FP contraction is off.
+ *
+ * Buffer layout is [sample][voice], i.e. one voice reads its output with a
+ * stride of NUM_LANES.
+ */
+template <int NumVoices>
+class SVFFilterBank
+{
+public:
+    static constexpr int LANE_BLOCK = 8;
+    static constexpr int NUM_LANES = ((NumVoices + LANE_BLOCK - 1) / LANE_BLOCK) * LANE_BLOCK;
+    static constexpr int MAX_SEGMENT_SAMPLES = 32;
+
+    void load(int voice, const SVFVoiceFilter::State& s) noexcept
+    {
+        jassert(voice >= 0 && voice < NumVoices);
+        const auto v = static_cast<size_t>(voice);
+        lowG[v] = s.lowG;   lowK[v] = s.lowK;   highG[v] = s.highG;
+        lowGStep[v] = s.lowGStep; lowKStep[v] = s.lowKStep; highGStep[v] = s.highGStep;
+        low1[v] = s.low1;   low2[v] = s.low2;   high1[v] = s.high1; high2[v] = s.high2;
+    }
+
+    void store(int voice, SVFVoiceFilter::State& s) const noexcept
+    {
+        jassert(voice >= 0 && voice < NumVoices);
+        const auto v = static_cast<size_t>(voice);
+        s.lowG = lowG[v];   s.lowK = lowK[v];   s.highG = highG[v];
+        s.low1 = low1[v];   s.low2 = low2[v];   s.high1 = high1[v]; s.high2 = high2[v];
+    }
+
+    /** First input sample of a voice; successive samples are getStride() apart. */
+    float* getInput(int voice) noexcept { return &buffer[0][static_cast<size_t>(voice)]; }
+    /** Filtered output (in place of the input) */
+    const float* getOutput(int voice) const noexcept { return &buffer[0][static_cast<size_t>(voice)]; }
+    static constexpr int getStride() noexcept { return NUM_LANES; }
+
+    /** Filter numSamples for lanes [0, numVoicesInUse); lanes without a loaded voice run on stale but finite state. */
+    void process(int numSamples, int numVoicesInUse) noexcept
+    {
+        jassert(numSamples <= MAX_SEGMENT_SAMPLES);
+        numSamples = std::min(numSamples, MAX_SEGMENT_SAMPLES);
+        const int lanesInUse = std::min(NUM_LANES, ((numVoicesInUse + LANE_BLOCK - 1) / LANE_BLOCK) * LANE_BLOCK);
+
+        for (int lane = 0; lane < lanesInUse; lane += LANE_BLOCK)
+            processBlock(static_cast<size_t>(lane), numSamples);
+    }
+
+private:
+    using LaneArray = std::array<float, NUM_LANES>;
+
+    alignas(32) LaneArray lowG {}, lowK {}, highG {};
+    alignas(32) LaneArray lowGStep {}, lowKStep {}, highGStep {};
+    alignas(32) LaneArray low1 {}, low2 {}, high1 {}, high2 {};
+    alignas(32) std::array<LaneArray, MAX_SEGMENT_SAMPLES> buffer {};
+
+    void processBlock(size_t lane, int numSamples) noexcept
+    {
+        constexpr float highK = SVFVoiceFilter::HIGHPASS_K;
+        alignas(32) float gL[LANE_BLOCK], kL[LANE_BLOCK], gH[LANE_BLOCK];
+        alignas(32) float dgL[LANE_BLOCK], dkL[LANE_BLOCK], dgH[LANE_BLOCK];
+        alignas(32) float l1[LANE_BLOCK], l2[LANE_BLOCK], h1[LANE_BLOCK], h2[LANE_BLOCK];
+
+        for (int i = 0; i < LANE_BLOCK; ++i)
+        {
+            gL[i] = lowG[lane + i]; kL[i] = lowK[lane + i]; gH[i] = highG[lane + i];
+            dgL[i] = lowGStep[lane + i]; dkL[i] = lowKStep[lane + i]; dgH[i] = highGStep[lane + i];
+            l1[i] = low1[lane + i]; l2[i] = low2[lane + i]; h1[i] = high1[lane + i]; h2[i] = high2[lane + i];
+        }
+
+        for (int s = 0; s < numSamples; ++s)
+        {
+            float* io = buffer[static_cast<size_t>(s)].data() + lane;
+
+            for (int i = 0; i < LANE_BLOCK; ++i)
+            {
+                float band, low;
+                SVFVoiceFilter::tick(io[i], gL[i], kL[i], l1[i], l2[i], band, low);
+
+                float highBand, highLow;
+                SVFVoiceFilter::tick(low, gH[i], highK, h1[i], h2[i], highBand, highLow);
+                io[i] = low - highK * highBand - highLow;
+
+                gL[i] += dgL[i];
+                kL[i] += dkL[i];
+                gH[i] += dgH[i];
+            }
+        }
+
+        for (int i = 0; i < LANE_BLOCK; ++i)
+        {
+            lowG[lane + i] = gL[i]; lowK[lane + i] = kL[i]; highG[lane + i] = gH[i];
+            low1[lane + i] = l1[i]; low2[lane + i] = l2[i]; high1[lane + i] = h1[i]; high2[lane + i] = h2[i];
+            
+            // Ramps are reloaded with the voice every segment; lanes nobody loads stop drifting
+            lowGStep[lane + i] = lowKStep[lane + i] = highGStep[lane + i] = 0.0f;
+        }
+    }
+};
+
+} // namespace DSP
+} // namespace CZ101
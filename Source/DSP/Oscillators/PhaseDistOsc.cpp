@@ -1,5 +1,7 @@
 #include "PhaseDistOsc.h"
 #include <algorithm>
+#include <array>
+#include <utility>
 #include <cmath> // Audit Fix 5.1: M_PI compliance
 
 #ifndef M_PI
@@ -12,6 +14,7 @@ namespace DSP {
 PhaseDistOscillator::PhaseDistOscillator()
 {
     updatePhaseIncrement();
+    kernel = getKernel(firstWaveform, secondWaveformActive ? secondWaveform : NONE);
 }
 
 void PhaseDistOscillator::setSampleRate(double sr) noexcept
@@ -30,8 +33,10 @@ void PhaseDistOscillator::setWaveforms(CzWaveform first, CzWaveform second) noex
 {
     // Audit Fix 11.1: Explicit logic
     // If second is NONE or invalid, it is disabled.
+    firstWaveform = first;
     secondWaveform = second;
     secondWaveformActive = (second != NONE && second < NUM_CZ_WAVEFORMS); 
+    kernel = getKernel(first, secondWaveformActive ? second : NONE);
 }
 
 void PhaseDistOscillator::reset() noexcept
@@ -95,8 +100,8 @@ inline float PhaseDistOscillator::applyPhaseDistortion(float linearPhase, float
             float modFreq = (wave == RESONANCE_1) ? Constants::Resonance1Freq : (wave == RESONANCE_2 ? Constants::Resonance2Freq : Constants::Resonance3Freq);
             float maxMod = (wave == RESONANCE_1) ? Constants::Resonance1MaxMod : (wave == RESONANCE_2 ? Constants::Resonance2MaxMod : Constants::Resonance3MaxMod);
             
-            // Optimization: Use WaveTable for modulation sine instead of sin()
-            float sineMod = waveTable.getSine(linearPhase * modFreq);
+            // Optimization: Use the shared sine table for modulation instead of sin()
+            float sineMod = SineTable::lookup(linearPhase * modFreq);
             float distorted = linearPhase + sineMod * maxMod;
             distortedPhase = linearPhase + (distorted - linearPhase) * dcwValue;
             break;
@@ -150,7 +155,7 @@ float PhaseDistOscillator::renderNextSample(float dcwAmount, bool* outDidWrap) n
 
     // Apply PD to the selected (and potentially stretched) phase
     float distPhase = applyPhaseDistortion(stretchedPhase, dcwAmount, activeWave);
-    sample = waveTable.getSine(distPhase);
+    sample = SineTable::lookup(distPhase);
 
     // Apply BLEP (Anti-aliasing)
     // For stretched phase, we need adjusted dt
@@ -198,5 +203,160 @@ float PhaseDistOscillator::renderNextSample(float dcwAmount, bool* outDidWrap) n
     return sample;
 }
 
+//==============================================================================
+// Block kernels: one instantiation per (first, second) waveform pair.
+// The waveform is a template parameter, so the distortion shape and PolyBLEP
+// variant resolve at compile time and the per-sample selects compile to blends.
+
+namespace
+{
+    using W = PhaseDistOscillator::CzWaveform;
+
+    // Branch-free PolyBLEP (same polynomial as PhaseDistOscillator::polyBLEP)
+    inline float polyBlepSelect(float t, float dt, float invDt) noexcept
+    {
+        const float x = t * invDt;
+        const float lo = x + x - x * x - 1.0f;
+        const float y = (t - 1.0f) * invDt;
+        const float hi = y * y + y + y + 1.0f;
+        return (t < dt) ? lo : ((t > 1.0f - dt) ? hi : 0.0f);
+    }
+
+    inline float wrapShifted(float t) noexcept { return (t >= 1.0f) ? t - 1.0f : t; }
+
+    template <W Wave> struct WaveShape;
+
+    template <> struct WaveShape<W::SAWTOOTH>
+    {
+        static float distort(float t) noexcept { return (t < 0.5f) ? t * 2.0f : 1.0f; }
+        static float blep(float t, float dt, float invDt) noexcept { return -polyBlepSelect(t, dt, invDt); }
+    };
+
+    template <> struct WaveShape<W::SQUARE>
+    {
+        static float distort(float t) noexcept { return (t < 0.5f) ? 0.25f : 0.75f; }
+        static float blep(float t, float dt, float invDt) noexcept
+        {
+            return polyBlepSelect(t, dt, invDt) - polyBlepSelect(wrapShifted(t + 0.5f), dt, invDt);
+        }
+    };
+
+    template <> struct WaveShape<W::PULSE>
+    {
+        static float distort(float t) noexcept { return (t < 0.25f) ? 0.25f : 0.75f; }
+        static float blep(float t, float dt, float invDt) noexcept
+        {
+            return polyBlepSelect(t, dt, invDt) - polyBlepSelect(wrapShifted(t + 0.75f), dt, invDt);
+        }
+    };
+
+    template <> struct WaveShape<W::DOUBLE_SINE>
+    {
+        static float distort(float t) noexcept { return t * 2.0f; }
+        static float blep(float, float, float) noexcept { return 0.0f; }
+    };
+
+    template <> struct WaveShape<W::SAW_PULSE>
+    {
+        static float distort(float t) noexcept { return (t < 0.5f) ? t * 2.0f : 0.75f; }
+        static float blep(float t, float dt, float invDt) noexcept
+        {
+            return polyBlepSelect(t, dt, invDt) - polyBlepSelect(wrapShifted(t + 0.5f), dt, invDt);
+        }
+    };
+
+    template <int FreqTimes100, int DepthTimes100>
+    struct ResonanceShape
+    {
+        static float distort(float t) noexcept
+        {
+            return t + SineTable::lookup(t * (FreqTimes100 / 100.0f)) * (DepthTimes100 / 100.0f);
+        }
+        static float blep(float, float, float) noexcept { return 0.0f; }
+    };
+
+    template <> struct WaveShape<W::RESONANCE_1> : ResonanceShape<200, 15> {};
+    template <> struct WaveShape<W::RESONANCE_2> : ResonanceShape<400, 20> {};
+    template <> struct WaveShape<W::RESONANCE_3> : ResonanceShape<700, 25> {};
+
+    // NONE as a first waveform: undistorted sine (applyPhaseDistortion default case)
+    template <> struct WaveShape<W::NONE>
+    {
+        static float distort(float t) noexcept { return t; }
+        static float blep(float, float, float) noexcept { return 0.0f; }
+    };
+
+    template <W Wave>
+    inline float renderShape(float t, float dcw, float dt, float invDt) noexcept
+    {
+        float d = t + (WaveShape<Wave>::distort(t) - t) * dcw;
+        d = (d >= 1.0f) ? d - 1.0f : ((d < 0.0f) ? d + 1.0f : d);
+        return SineTable::lookup(d) + WaveShape<Wave>::blep(t, dt, invDt);
+    }
+}
+
+template <PhaseDistOscillator::CzWaveform First, PhaseDistOscillator::CzWaveform Second>
+void PhaseDistOscillator::renderKernel(PhaseDistOscillator& osc, float* out, int numSamples, float dcwAmount, float dcwStep,
+                                       const float* resetMask, float* wrapMask) noexcept
+{
+    constexpr bool split = (Second != NONE);
+    const float increment = osc.phaseIncrement;
+    const float dt = std::max(increment * (split ? 2.0f : 1.0f), 1.0e-7f);
+    const float invDt = 1.0f / dt;
+    float phase = osc.phase;
+    float dcw = dcwAmount;
+
+    for (int i = 0; i < numSamples; ++i)
+    {
+        if (resetMask != nullptr) phase *= (1.0f - resetMask[i]); // Hard Sync
+
+        if constexpr (split)
+        {
+            // Half-period switching: 0.0-0.5 is Wave 1, 0.5-1.0 is Wave 2
+            // Taken twice per period, so this stays well predicted; only one shape is evaluated
+            if (phase < 0.5f) out[i] = renderShape<First>(phase * 2.0f, dcw, dt, invDt);
+            else              out[i] = renderShape<Second>(phase * 2.0f - 1.0f, dcw, dt, invDt);
+        }
+        else
+        {
+            out[i] = renderShape<First>(phase, dcw, dt, invDt);
+        }
+        dcw += dcwStep;
+
+        // Increment < 0.5 (setFrequency clamps to 20 kHz), so one conditional wrap suffices
+        phase += increment;
+        const float wrapped = (phase >= 1.0f) ? 1.0f : 0.0f;
+        phase -= wrapped;
+        if (wrapMask != nullptr) wrapMask[i] = wrapped;
+    }
+
+    osc.phase = phase;
+}
+
+void PhaseDistOscillator::renderBlock(float* out, int numSamples, float dcwAmount, float dcwStep,
+                                      const float* resetMask, float* wrapMask) noexcept
+{
+    kernel(*this, out, numSamples, dcwAmount, dcwStep, resetMask, wrapMask);
+}
+
+template <int... Pairs>
+std::array<PhaseDistOscillator::BlockKernel, sizeof...(Pairs)>
+PhaseDistOscillator::buildKernelTable(std::integer_sequence<int, Pairs...>) noexcept
+{
+    // Row-major: index = first * NUM_CZ_WAVEFORMS + second
+    return { { &renderKernel<static_cast<CzWaveform>(Pairs / NUM_CZ_WAVEFORMS),
+                             static_cast<CzWaveform>(Pairs % NUM_CZ_WAVEFORMS)>... } };
+}
+
+PhaseDistOscillator::BlockKernel PhaseDistOscillator::getKernel(CzWaveform first, CzWaveform second) noexcept
+{
+    // 9x9 table built once; selection happens when the waveforms change, not per sample
+    static const auto table = buildKernelTable(std::make_integer_sequence<int, NUM_CZ_WAVEFORMS * NUM_CZ_WAVEFORMS> {});
+
+    const int f = std::clamp(static_cast<int>(first), 0, static_cast<int>(NONE));
+    const int s = std::clamp(static_cast<int>(second), 0, static_cast<int>(NONE));
+    return table[static_cast<size_t>(f * NUM_CZ_WAVEFORMS + s)];
+}
+
 } // namespace DSP
 } // namespace CZ101
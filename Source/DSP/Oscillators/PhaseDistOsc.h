@@ -1,6 +1,8 @@
 #pragma once
 
-#include "WaveTable.h"
+#include "SineTable.h"
+#include <array>
+#include <utility>
 #include <cmath>
 
 namespace CZ101 {
@@ -54,11 +56,18 @@ public:
      */
     void setWaveforms(CzWaveform first, CzWaveform second) noexcept;
     
+    CzWaveform getFirstWaveform() const noexcept { return firstWaveform; }
+    CzWaveform getSecondWaveform() const noexcept { return secondWaveformActive ? secondWaveform : NONE; }
+    
     /**
      * @brief Reset phase to zero
      */
     void reset() noexcept;
     
+    /** Current phase [0.0, 1.0), handed to and back from the SoA oscillator bank */
+    float getPhase() const noexcept { return phase; }
+    void setPhase(float newPhase) noexcept { phase = newPhase; }
+    
     /**
      * @brief Render next sample with Phase Distortion simulation
      * @param dcwAmount Timbre control [0.0 = Pure Sine, 1.0 = Full Waveform]
@@ -67,9 +76,37 @@ public:
      */
     float renderNextSample(float dcwAmount, bool* outDidWrap = nullptr) noexcept;
     
+    /**
+     * @brief Render a block through the kernel specialised for the current waveform pair
+     *
+     * Same output as numSamples calls to renderNextSample(), without per-sample
+     * waveform dispatch. The kernel is picked from a 9x9 table in setWaveforms().
+     *
+     * @param out Destination, numSamples floats
+     * @param dcwAmount Timbre control at the first sample
+     * @param dcwStep Per-sample DCW increment (linear ramp between control ticks)
+     * @param resetMask Per-sample 1.0 = reset phase before rendering (Hard Sync), or nullptr
+     * @param wrapMask Per-sample 1.0 written where the phase wrapped, or nullptr
+     */
+    void renderBlock(float* out, int numSamples, float dcwAmount, float dcwStep = 0.0f,
+                     const float* resetMask = nullptr, float* wrapMask = nullptr) noexcept;
+    
+    using BlockKernel = void (*)(PhaseDistOscillator& osc, float* out, int numSamples, float dcwAmount, float dcwStep,
+                                 const float* resetMask, float* wrapMask) noexcept;
+    
+    /** Kernel for a (first, second) pair; NONE as second means single waveform. Exposed for benchmarks. */
+    static BlockKernel getKernel(CzWaveform first, CzWaveform second) noexcept;
+    
 private:
-    WaveTable waveTable;
+    BlockKernel kernel = nullptr;
     
+    template <CzWaveform First, CzWaveform Second>
+    static void renderKernel(PhaseDistOscillator& osc, float* out, int numSamples, float dcwAmount, float dcwStep,
+                             const float* resetMask, float* wrapMask) noexcept;
+    
+    template <int... Pairs>
+    static std::array<BlockKernel, sizeof...(Pairs)> buildKernelTable(std::integer_sequence<int, Pairs...>) noexcept;
+
     double sampleRate = 44100.0;
     float frequency = 440.0f;
     CzWaveform firstWaveform = SAWTOOTH;
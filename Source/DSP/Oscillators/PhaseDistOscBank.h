@@ -0,0 +1,347 @@
+#pragma once
+
+#include "PhaseDistOsc.h"
+#include <juce_dsp/juce_dsp.h>
+#include <array>
+#include <algorithm>
+
+namespace CZ101 {
+namespace DSP {
+
+/**
+ * @brief Per-line oscillator state pushed into the bank at every control segment.
+ */
+struct OscLineParams
+{
+    float phase = 0.0f;       // Loaded into the bank each segment; the voice's oscillator owns it in between
+    float phaseIncrement = 0.0f;
+    float dcw = 0.0f;
+    float dcwStep = 0.0f;     // Per-sample DCW ramp towards the next control target
+    PhaseDistOscillator::CzWaveform first = PhaseDistOscillator::SAWTOOTH;
+    PhaseDistOscillator::CzWaveform second = PhaseDistOscillator::NONE;
+    bool syncToLine1 = false; // Line 2 only: hard sync (reset on Line 1 wrap)
+};
+
+/**
+ * @brief Structure-of-arrays Phase Distortion oscillator bank
+ *
+ * Holds phase, increment, DCW (with its per-sample ramp) and waveform shape for both lines of every voice
+ * in SoA arrays and renders them N voices per instruction through
+ * juce::dsp::SIMDRegister (SSE/AVX on x86, NEON on ARM).
+ *
+ * Every CZ waveform is reduced to a piecewise-linear phase transfer
+ * (knee, low/high slope+offset), an optional resonance sine term and two
+ * PolyBLEP weights, so mixed waveforms across lanes run without branches.
+ *
+ * Output layout is [line][sample][voice], i.e. one voice reads its line with
+ * a stride of NUM_LANES.
+ */
+template <int NumVoices>
+class PhaseDistOscBank
+{
+public:
+    using Vec = juce::dsp::SIMDRegister<float>;
+    using Mask = typename Vec::vMaskType;
+
+    static constexpr int SIMD_WIDTH = (int)Vec::SIMDNumElements;
+    static constexpr int NUM_LANES = ((NumVoices + 7) / 8) * 8; // Padded for AVX (8) and SSE/NEON (4)
+    static constexpr int MAX_SEGMENT_SAMPLES = 32;
+    static constexpr int NUM_LINES = 2;
+
+    PhaseDistOscBank()
+    {
+        for (int l = 0; l < NUM_LINES; ++l)
+            for (int v = 0; v < NUM_LANES; ++v)
+                setShape(l, v, PhaseDistOscillator::SAWTOOTH, PhaseDistOscillator::NONE);
+    }
+
+    void setVoice(int voice, const OscLineParams& line1, const OscLineParams& line2) noexcept
+    {
+        jassert(voice >= 0 && voice < NumVoices);
+        setLine(0, voice, line1);
+        setLine(1, voice, line2);
+        syncMask[voice] = line2.syncToLine1 ? 1.0f : 0.0f;
+    }
+
+    /**
+     * @brief Render numSamples for lanes [0, numVoicesInUse)
+     * @param numLines 1 renders Line 1 only (single-line patches); Line 2 output is then stale
+     */
+    void render(int numSamples, int numVoicesInUse, int numLines = NUM_LINES) noexcept
+    {
+        jassert(numSamples <= MAX_SEGMENT_SAMPLES);
+        numSamples = std::min(numSamples, MAX_SEGMENT_SAMPLES);
+        const int lanesInUse = std::min(NUM_LANES, ((numVoicesInUse + SIMD_WIDTH - 1) / SIMD_WIDTH) * SIMD_WIDTH);
+
+        for (int lane = 0; lane < lanesInUse; lane += SIMD_WIDTH)
+        {
+            // Phases stay in registers for the whole segment
+            Vec phase1 = Vec::fromRawArray(lines[0].phase.data() + lane);
+            Vec phase2 = Vec::fromRawArray(lines[1].phase.data() + lane);
+            const Vec sync = Vec::fromRawArray(syncMask.data() + lane);
+            const Mask syncOn = Vec::greaterThan(sync, Vec::expand(0.5f));
+
+            LaneShape shape1 = loadShape(0, lane);
+
+            if (numLines < NUM_LINES)
+            {
+                for (int s = 0; s < numSamples; ++s)
+                {
+                    Mask wrapped1;
+                    renderLane(shape1, phase1, wrapped1).copyToRawArray(output[0][s].data() + lane);
+                    shape1.dcw = shape1.dcw + shape1.dcwStep;
+                }
+
+                phase1.copyToRawArray(lines[0].phase.data() + lane);
+                continue;
+            }
+
+            LaneShape shape2 = loadShape(1, lane);
+
+            for (int s = 0; s < numSamples; ++s)
+            {
+                Mask wrapped1;
+                renderLane(shape1, phase1, wrapped1).copyToRawArray(output[0][s].data() + lane);
+
+                // Hard Sync: Line 2 restarts when Line 1 wraps (scalar path: osc2.reset())
+                phase2 = phase2 & ~(wrapped1 & syncOn);
+
+                Mask wrapped2;
+                renderLane(shape2, phase2, wrapped2).copyToRawArray(output[1][s].data() + lane);
+
+                shape1.dcw = shape1.dcw + shape1.dcwStep;
+                shape2.dcw = shape2.dcw + shape2.dcwStep;
+            }
+
+            phase1.copyToRawArray(lines[0].phase.data() + lane);
+            phase2.copyToRawArray(lines[1].phase.data() + lane);
+        }
+    }
+
+    /** Phase a voice's line reached at the end of the last render (store back after each segment) */
+    float getPhase(int line, int voice) const noexcept { return lines[line].phase[voice]; }
+
+    /** First sample of a voice's line; successive samples are getStride() apart. */
+    const float* getOutput(int line, int voice) const noexcept { return &output[line][0][voice]; }
+    static constexpr int getStride() noexcept { return NUM_LANES; }
+
+private:
+    using LaneArray = std::array<float, NUM_LANES>;
+
+    // Piecewise phase transfer for one half-period: d = (t < knee) ? (aLo*t + bLo) : (aHi*t + bHi) + resoDepth*sin(2*pi*t*resoFreq)
+    struct HalfShape
+    {
+        alignas(32) LaneArray knee, aLo, bLo, aHi, bHi;
+        alignas(32) LaneArray resoDepth, resoFreq;
+        alignas(32) LaneArray blepMain, blepOffsetGain, blepOffset; // sample += blepMain*blep(t) + blepOffsetGain*blep(t + blepOffset)
+    };
+
+    struct LineState
+    {
+        alignas(32) LaneArray phase {};
+        alignas(32) LaneArray increment {};
+        alignas(32) LaneArray dt {};      // Effective PolyBLEP dt (x2 when halves are stretched)
+        alignas(32) LaneArray invDt {};
+        alignas(32) LaneArray dcw {};
+        alignas(32) LaneArray dcwStep {};
+        alignas(32) LaneArray split {};   // 1.0 = second waveform active (half-period switching)
+        HalfShape half[2];
+        std::array<PhaseDistOscillator::CzWaveform, NUM_LANES> cachedFirst {}, cachedSecond {};
+    };
+
+    struct VecHalf { Vec knee, aLo, bLo, aHi, bHi, resoDepth, resoFreq, blepMain, blepOffsetGain, blepOffset; };
+    struct LaneShape { Vec increment, dt, invDt, dcw, dcwStep; Mask split; VecHalf half[2]; bool hasResonance; };
+
+    std::array<LineState, NUM_LINES> lines;
+    alignas(32) LaneArray syncMask {};
+    alignas(32) std::array<std::array<LaneArray, MAX_SEGMENT_SAMPLES>, NUM_LINES> output {};
+
+    void setLine(int l, int v, const OscLineParams& p) noexcept
+    {
+        auto& line = lines[l];
+        if (p.first != line.cachedFirst[v] || p.second != line.cachedSecond[v])
+            setShape(l, v, p.first, p.second);
+
+        const bool split = line.split[v] > 0.5f;
+        const float dt = std::max(p.phaseIncrement * (split ? 2.0f : 1.0f), 1.0e-7f);
+        line.phase[v] = p.phase;
+        line.increment[v] = p.phaseIncrement;
+        line.dt[v] = dt;
+        line.invDt[v] = 1.0f / dt;
+        line.dcw[v] = p.dcw;
+        line.dcwStep[v] = p.dcwStep;
+    }
+
+    void setShape(int l, int v, PhaseDistOscillator::CzWaveform first, PhaseDistOscillator::CzWaveform second) noexcept
+    {
+        auto& line = lines[l];
+        line.cachedFirst[v] = first;
+        line.cachedSecond[v] = second;
+
+        const bool split = (second != PhaseDistOscillator::NONE && second < PhaseDistOscillator::NUM_CZ_WAVEFORMS);
+        line.split[v] = split ? 1.0f : 0.0f;
+
+        setHalf(line.half[0], v, first);
+        setHalf(line.half[1], v, split ? second : first);
+    }
+
+    // Mirrors PhaseDistOscillator::applyPhaseDistortion and its PolyBLEP selection
+    static void setHalf(HalfShape& h, int v, PhaseDistOscillator::CzWaveform wave) noexcept
+    {
+        using W = PhaseDistOscillator;
+        float knee = 1.0f, aLo = 1.0f, bLo = 0.0f, aHi = 1.0f, bHi = 0.0f;
+        float resoDepth = 0.0f, resoFreq = 0.0f;
+        float blepMain = 0.0f, blepOffsetGain = 0.0f, blepOffset = 0.0f;
+
+        switch (wave)
+        {
+            case W::SAWTOOTH:    knee = 0.5f;  aLo = 2.0f; bLo = 0.0f;  aHi = 0.0f; bHi = 1.0f;  blepMain = -1.0f; break;
+            case W::SQUARE:      knee = 0.5f;  aLo = 0.0f; bLo = 0.25f; aHi = 0.0f; bHi = 0.75f; blepMain = 1.0f; blepOffsetGain = -1.0f; blepOffset = 0.5f; break;
+            case W::PULSE:       knee = 0.25f; aLo = 0.0f; bLo = 0.25f; aHi = 0.0f; bHi = 0.75f; blepMain = 1.0f; blepOffsetGain = -1.0f; blepOffset = 0.75f; break;
+            case W::DOUBLE_SINE: knee = 1.0f;  aLo = 2.0f; bLo = 0.0f; break;
+            case W::SAW_PULSE:   knee = 0.5f;  aLo = 2.0f; bLo = 0.0f;  aHi = 0.0f; bHi = 0.75f; blepMain = 1.0f; blepOffsetGain = -1.0f; blepOffset = 0.5f; break;
+            case W::RESONANCE_1: resoDepth = 0.15f; resoFreq = 2.0f; break;
+            case W::RESONANCE_2: resoDepth = 0.20f; resoFreq = 4.0f; break;
+            case W::RESONANCE_3: resoDepth = 0.25f; resoFreq = 7.0f; break;
+            default: break; // NONE: undistorted sine
+        }
+
+        h.knee[v] = knee; h.aLo[v] = aLo; h.bLo[v] = bLo; h.aHi[v] = aHi; h.bHi[v] = bHi;
+        h.resoDepth[v] = resoDepth; h.resoFreq[v] = resoFreq;
+        h.blepMain[v] = blepMain; h.blepOffsetGain[v] = blepOffsetGain; h.blepOffset[v] = blepOffset;
+    }
+
+    LaneShape loadShape(int l, int lane) const noexcept
+    {
+        const auto& line = lines[l];
+        LaneShape s;
+        s.increment = Vec::fromRawArray(line.increment.data() + lane);
+        s.dt = Vec::fromRawArray(line.dt.data() + lane);
+        s.invDt = Vec::fromRawArray(line.invDt.data() + lane);
+        s.dcw = Vec::fromRawArray(line.dcw.data() + lane);
+        s.dcwStep = Vec::fromRawArray(line.dcwStep.data() + lane);
+        s.split = Vec::greaterThan(Vec::fromRawArray(line.split.data() + lane), Vec::expand(0.5f));
+        s.hasResonance = false;
+
+        for (int h = 0; h < 2; ++h)
+        {
+            const auto& src = line.half[h];
+            auto& dst = s.half[h];
+            dst.knee = Vec::fromRawArray(src.knee.data() + lane);
+            dst.aLo = Vec::fromRawArray(src.aLo.data() + lane);
+            dst.bLo = Vec::fromRawArray(src.bLo.data() + lane);
+            dst.aHi = Vec::fromRawArray(src.aHi.data() + lane);
+            dst.bHi = Vec::fromRawArray(src.bHi.data() + lane);
+            dst.resoDepth = Vec::fromRawArray(src.resoDepth.data() + lane);
+            dst.resoFreq = Vec::fromRawArray(src.resoFreq.data() + lane);
+            dst.blepMain = Vec::fromRawArray(src.blepMain.data() + lane);
+            dst.blepOffsetGain = Vec::fromRawArray(src.blepOffsetGain.data() + lane);
+            dst.blepOffset = Vec::fromRawArray(src.blepOffset.data() + lane);
+
+            for (int i = 0; i < SIMD_WIDTH; ++i)
+                s.hasResonance = s.hasResonance || (src.resoDepth[lane + i] != 0.0f);
+        }
+        return s;
+    }
+
+    static inline Vec select(Mask m, Vec a, Vec b) noexcept { return (a & m) + (b & ~m); }
+
+    // Wrap x in [-1, 2) into [0, 1)
+    static inline Vec wrapUnit(Vec x) noexcept
+    {
+        const Vec one = Vec::expand(1.0f);
+        x = x - (one & Vec::greaterThanOrEqual(x, one));
+        return x + (one & Vec::lessThan(x, Vec::expand(0.0f)));
+    }
+
+    /**
+     * sin(2*pi*x) for x in [0, 1): fold to [-pi/2, pi/2] then odd minimax
+     * polynomial (Abramowitz & Stegun 4.3.98). Max abs error ~4e-6, the same order as
+     * SineTable's interpolation error, with no gathers.
+     */
+    static inline Vec sin2Pi(Vec x) noexcept
+    {
+        const Vec half = Vec::expand(0.5f);
+        const Vec quarter = Vec::expand(0.25f);
+        const Vec zero = Vec::expand(0.0f);
+
+        Vec y = x - half;                                        // [-0.5, 0.5), sin(2*pi*x) = -sin(2*pi*y)
+        const Mask negative = Vec::lessThan(y, zero);
+        const Vec absY = select(negative, zero - y, y);
+        const Vec signedHalf = select(negative, zero - half, half);
+        y = select(Vec::greaterThan(absY, quarter), signedHalf - y, y);
+
+        const Vec z = y * Vec::expand(6.28318530718f);
+        const Vec z2 = z * z;
+        Vec p = Vec::expand(0.0000027526f);
+        p = p * z2 + Vec::expand(-0.0001984090f);
+        p = p * z2 + Vec::expand(0.0083333315f);
+        p = p * z2 + Vec::expand(-0.1666666664f);
+        p = p * z2 + Vec::expand(1.0f);
+        return zero - z * p;
+    }
+
+    static inline Vec polyBLEP(Vec t, Vec dt, Vec invDt) noexcept
+    {
+        const Vec one = Vec::expand(1.0f);
+        const Vec two = Vec::expand(2.0f);
+        const Mask low = Vec::lessThan(t, dt);
+        const Mask high = Vec::greaterThan(t, one - dt);
+
+        const Vec x = t * invDt;
+        const Vec lo = two * x - x * x - one;
+        const Vec y = (t - one) * invDt;
+        const Vec hi = y * y + two * y + one;
+
+        return (lo & low) + (hi & (high & ~low));
+    }
+
+    // One sample for SIMD_WIDTH lanes of a line; advances phase and reports wraps
+    static inline Vec renderLane(const LaneShape& s, Vec& phase, Mask& wrapped) noexcept
+    {
+        const Vec one = Vec::expand(1.0f);
+        const Vec two = Vec::expand(2.0f);
+
+        // Half-period switching: 0.0-0.5 is Wave 1, 0.5-1.0 is Wave 2
+        const Mask secondHalf = Vec::greaterThanOrEqual(phase, Vec::expand(0.5f)) & s.split;
+        const Vec t = select(s.split, two * phase - (one & secondHalf), phase);
+
+        const VecHalf& a = s.half[0];
+        const VecHalf& b = s.half[1];
+        const Vec knee = select(secondHalf, b.knee, a.knee);
+        const Vec aLo = select(secondHalf, b.aLo, a.aLo);
+        const Vec bLo = select(secondHalf, b.bLo, a.bLo);
+        const Vec aHi = select(secondHalf, b.aHi, a.aHi);
+        const Vec bHi = select(secondHalf, b.bHi, a.bHi);
+
+        Vec distorted = select(Vec::lessThan(t, knee), aLo * t + bLo, aHi * t + bHi);
+
+        if (s.hasResonance)
+        {
+            const Vec resoDepth = select(secondHalf, b.resoDepth, a.resoDepth);
+            const Vec resoFreq = select(secondHalf, b.resoFreq, a.resoFreq);
+            const Vec resoPhase = t * resoFreq;
+            distorted = distorted + resoDepth * sin2Pi(resoPhase - Vec::truncate(resoPhase));
+        }
+
+        const Vec distPhase = wrapUnit(t + (distorted - t) * s.dcw);
+        Vec sample = sin2Pi(distPhase);
+
+        // PolyBLEP (anti-aliasing)
+        const Vec blepMain = select(secondHalf, b.blepMain, a.blepMain);
+        const Vec blepOffsetGain = select(secondHalf, b.blepOffsetGain, a.blepOffsetGain);
+        const Vec blepOffset = select(secondHalf, b.blepOffset, a.blepOffset);
+        sample = sample + blepMain * polyBLEP(t, s.dt, s.invDt)
+                        + blepOffsetGain * polyBLEP(wrapUnit(t + blepOffset), s.dt, s.invDt);
+
+        // Advance Phase (increment < 0.5, so a single conditional wrap is enough)
+        phase = phase + s.increment;
+        wrapped = Vec::greaterThanOrEqual(phase, one);
+        phase = phase - (one & wrapped);
+
+        return sample;
+    }
+};
+
+} // namespace DSP
+} // namespace CZ101
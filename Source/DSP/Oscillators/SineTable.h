@@ -0,0 +1,82 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+
+namespace CZ101 {
+namespace DSP {
+
+/**
+ * @brief Process-wide sine lookup table, generated at compile time
+ *
+ * One immutable, cache-line aligned table shared by every oscillator and every
+ * plugin instance (inline variable: a single definition across translation units).
+ * 2048 points plus a guard point (table[SIZE] == table[0]), so linear interpolation
+ * never wraps the upper index and needs no range branches.
+ */
+struct SineTable
+{
+    static constexpr int SIZE = 2048;
+    static constexpr int MASK = SIZE - 1;
+
+    using Table = std::array<float, SIZE + 1>;
+
+    /**
+     * @brief Linearly interpolated sin(2*pi*phase)
+     * @param phase Normalized phase, any value >= 0 (integer part is discarded)
+     */
+    static inline float lookup(float phase) noexcept
+    {
+        const float indexFloat = phase * static_cast<float>(SIZE);
+        const int index = static_cast<int>(indexFloat); // phase >= 0: truncation == floor
+        const float frac = indexFloat - static_cast<float>(index);
+        const float* p = data() + (index & MASK);
+        return p[0] + frac * (p[1] - p[0]);
+    }
+
+    static inline const float* data() noexcept;
+
+private:
+    // sin(x) for x in [0, pi/2]: Taylor series to x^15 in double (error < 1e-9, far below float precision)
+    static constexpr double quarterSine(double x) noexcept
+    {
+        const double x2 = x * x;
+        double s = 1.0 / 1307674368000.0;          // 1/15!
+        s = 1.0 / 6227020800.0 - x2 * s;           // 1/13!
+        s = 1.0 / 39916800.0 - x2 * s;             // 1/11!
+        s = 1.0 / 362880.0 - x2 * s;               // 1/9!
+        s = 1.0 / 5040.0 - x2 * s;                 // 1/7!
+        s = 1.0 / 120.0 - x2 * s;                  // 1/5!
+        s = 1.0 / 6.0 - x2 * s;                    // 1/3!
+        return x * (1.0 - x2 * s);
+    }
+
+public:
+    /** Built from one quarter wave and its symmetries (keeps constexpr evaluation cheap). */
+    static constexpr Table generate() noexcept
+    {
+        constexpr double HALF_PI = 1.57079632679489661923;
+        constexpr int QUARTER = SIZE / 4;
+
+        Table t {};
+        for (int i = 0; i <= QUARTER; ++i)
+        {
+            const float s = static_cast<float>(quarterSine(HALF_PI * static_cast<double>(i) / static_cast<double>(QUARTER)));
+            t[static_cast<size_t>(i)] = s;                                  // [0, pi/2]
+            t[static_cast<size_t>(2 * QUARTER - i)] = s;                    // [pi/2, pi]
+            t[static_cast<size_t>(2 * QUARTER + i)] = -s;                   // [pi, 3pi/2]
+            t[static_cast<size_t>((4 * QUARTER - i) & MASK)] = -s;          // [3pi/2, 2pi)
+        }
+        t[0] = 0.0f;
+        t[static_cast<size_t>(2 * QUARTER)] = 0.0f;
+        t[static_cast<size_t>(SIZE)] = t[0]; // Guard point
+        return t;
+    }
+};
+
+alignas(64) inline constexpr SineTable::Table sineTableData = SineTable::generate();
+
+inline const float* SineTable::data() noexcept { return sineTableData.data(); }
+
+} // namespace DSP
+} // namespace CZ101
@@ -4,60 +4,32 @@
 namespace CZ101 {
 namespace DSP {
 
-WaveTable::WaveTable()
+float WaveTable::getSine(float phase) noexcept
 {
-    generateTables();
+    return SineTable::lookup(phase);
 }
 
-void WaveTable::generateTables()
+float WaveTable::getSawtooth(float phase) noexcept
 {
-    constexpr float PI = 3.14159265358979323846f;
-    constexpr float TWO_PI = 2.0f * PI;
-    
-    for (int i = 0; i < TABLE_SIZE; ++i)
-    {
-        const float phase = static_cast<float>(i) / static_cast<float>(TABLE_SIZE);
-        
-        // Sine wave: Perfect, no aliasing
-        sineTable[i] = std::sin(TWO_PI * phase);
-        
-        // Sawtooth: Naive version (PolyBLEP applied at render time)
-        sawtoothTable[i] = 2.0f * phase - 1.0f;
-        
-        // Square: Naive version (PolyBLEP applied at render time)
-        squareTable[i] = (phase < 0.5f) ? 1.0f : -1.0f;
-        
-        // Triangle: Continuous waveform
-        if (phase < 0.25f)
-            triangleTable[i] = 4.0f * phase;
-        else if (phase < 0.75f)
-            triangleTable[i] = 2.0f - 4.0f * phase;
-        else
-            triangleTable[i] = 4.0f * phase - 4.0f;
-    }
-}
-
-float WaveTable::getSine(float phase) const noexcept
-{
-    return interpolate(sineTable, phase);
-}
-
-float WaveTable::getSawtooth(float phase) const noexcept
-{
-    return interpolate(sawtoothTable, phase);
+    phase = phase - std::floor(phase);
+    return 2.0f * phase - 1.0f;
 }
 
-float WaveTable::getSquare(float phase) const noexcept
+float WaveTable::getSquare(float phase) noexcept
 {
-    return interpolate(squareTable, phase);
+    phase = phase - std::floor(phase);
+    return (phase < 0.5f) ? 1.0f : -1.0f;
 }
 
-float WaveTable::getTriangle(float phase) const noexcept
+float WaveTable::getTriangle(float phase) noexcept
 {
-    return interpolate(triangleTable, phase);
+    phase = phase - std::floor(phase);
+    if (phase < 0.25f) return 4.0f * phase;
+    if (phase < 0.75f) return 2.0f - 4.0f * phase;
+    return 4.0f * phase - 4.0f;
 }
 
-float WaveTable::getPulse(float phase, float width) const noexcept
+float WaveTable::getPulse(float phase, float width) noexcept
 {
     // Pulse wave with variable width
     // width = 0.5 is square wave
@@ -66,7 +38,7 @@ float WaveTable::getPulse(float phase, float width) const noexcept
     return (phase < width) ? 1.0f : -1.0f;
 }
 
-float WaveTable::getDoubleSine(float phase) const noexcept
+float WaveTable::getDoubleSine(float phase) noexcept
 {
     // Two sine waves, one octave apart
     constexpr float PI = 3.14159265358979323846f;
@@ -79,7 +51,7 @@ float WaveTable::getDoubleSine(float phase) const noexcept
     return (fundamental + octave * 0.5f) / 1.5f;  // Normalize
 }
 
-float WaveTable::getHalfSine(float phase) const noexcept
+float WaveTable::getHalfSine(float phase) noexcept
 {
     // Sine wave rectified (only positive half)
     constexpr float PI = 3.14159265358979323846f;
@@ -91,7 +63,7 @@ float WaveTable::getHalfSine(float phase) const noexcept
     return (sine > 0.0f) ? sine : 0.0f;
 }
 
-float WaveTable::getResonantSaw(float phase) const noexcept
+float WaveTable::getResonantSaw(float phase) noexcept
 {
     // Sawtooth with emphasized harmonics (resonant character)
     phase = phase - std::floor(phase);
@@ -106,7 +78,7 @@ float WaveTable::getResonantSaw(float phase) const noexcept
     return std::clamp(saw + harmonic, -1.0f, 1.0f);
 }
 
-float WaveTable::getResonantTriangle(float phase) const noexcept
+float WaveTable::getResonantTriangle(float phase) noexcept
 {
     // Triangle with emphasized harmonics
     phase = phase - std::floor(phase);
@@ -127,7 +99,7 @@ float WaveTable::getResonantTriangle(float phase) const noexcept
     return std::clamp(tri + harmonic, -1.0f, 1.0f);
 }
 
-float WaveTable::getTrapezoid(float phase) const noexcept
+float WaveTable::getTrapezoid(float phase) noexcept
 {
     // Trapezoid wave (between square and triangle)
     phase = phase - std::floor(phase);
@@ -147,25 +119,5 @@ float WaveTable::getTrapezoid(float phase) const noexcept
         return -1.0f;  // Low
 }
 
-float WaveTable::interpolate(const std::array<float, TABLE_SIZE>& table, float phase) const noexcept
-{
-    // Fast wrap phase to [0.0, 1.0)
-    if (phase >= 1.0f) phase -= std::floor(phase);
-    else if (phase < 0.0f) phase += 1.0f - std::floor(phase);
-    
-    // Ensure strictly in range [0, 1)
-    if (phase >= 1.0f) phase = 0.0f;
-    if (phase < 0.0f) phase = 0.0f;
-
-    // Convert to table index
-    const float indexFloat = phase * static_cast<float>(TABLE_SIZE);
-    const int index0 = static_cast<int>(indexFloat) & (TABLE_SIZE - 1);
-    const int index1 = (index0 + 1) & (TABLE_SIZE - 1); // Power of 2 mask
-    
-    // Linear interpolation
-    const float frac = indexFloat - static_cast<float>(static_cast<int>(indexFloat));
-    return table[index0] + frac * (table[index1] - table[index0]);
-}
-
 } // namespace DSP
 } // namespace CZ101
@@ -1,6 +1,6 @@
 #pragma once
 
-#include <array>
+#include "SineTable.h"
 #include <cmath>
 
 namespace CZ101 {
@@ -9,25 +9,24 @@ namespace DSP {
 /**
  * @brief WaveTable generator for Phase Distortion synthesis
  * 
- * Generates lookup tables for basic waveforms used in CZ-101 emulation.
- * Tables are 256 samples for efficient memory usage and fast lookup.
+ * Basic waveforms used in CZ-101 emulation. Sine reads the shared
+ * compile-time SineTable; the naive shapes are computed directly, so a
+ * WaveTable holds no per-instance tables.
  * 
  * Note: Sawtooth and Square will use PolyBLEP at render time,
- * so these tables are "naive" versions.
+ * so these are "naive" versions.
  */
 class WaveTable
 {
 public:
-    static constexpr int TABLE_SIZE = 256;
-    
-    WaveTable();
+    static constexpr int TABLE_SIZE = SineTable::SIZE;
     
     /**
      * @brief Get sine wave value at normalized phase
-     * @param phase Normalized phase [0.0, 1.0]
+     * @param phase Normalized phase, >= 0 (wraps)
      * @return Sample value [-1.0, 1.0]
      */
-    float getSine(float phase) const noexcept;
+    static float getSine(float phase) noexcept;
     
     /**
      * @brief Get sawtooth wave value at normalized phase
@@ -35,7 +34,7 @@ public:
      * @return Sample value [-1.0, 1.0]
      * @note This is a naive sawtooth. Apply PolyBLEP at render time!
      */
-    float getSawtooth(float phase) const noexcept;
+    static float getSawtooth(float phase) noexcept;
     
     /**
      * @brief Get square wave value at normalized phase
@@ -43,33 +42,22 @@ public:
      * @return Sample value [-1.0, 1.0]
      * @note This is a naive square. Apply PolyBLEP at render time!
      */
-    float getSquare(float phase) const noexcept;
+    static float getSquare(float phase) noexcept;
     
     /**
      * @brief Get triangle wave value at normalized phase
      * @param phase Normalized phase [0.0, 1.0]
      * @return Sample value [-1.0, 1.0]
      */
-    float getTriangle(float phase) const noexcept;
+    static float getTriangle(float phase) noexcept;
     
     // Advanced waveforms (CZ-101 specific)
-    float getPulse(float phase, float width = 0.5f) const noexcept;
-    float getDoubleSine(float phase) const noexcept;
-    float getHalfSine(float phase) const noexcept;
-    float getResonantSaw(float phase) const noexcept;
-    float getResonantTriangle(float phase) const noexcept;
-    float getTrapezoid(float phase) const noexcept;
-    
-private:
-    std::array<float, TABLE_SIZE> sineTable;
-    std::array<float, TABLE_SIZE> sawtoothTable;
-    std::array<float, TABLE_SIZE> squareTable;
-    std::array<float, TABLE_SIZE> triangleTable;
-    
-    void generateTables();
-    
-    // Helper: Linear interpolation between table samples
-    float interpolate(const std::array<float, TABLE_SIZE>& table, float phase) const noexcept;
+    static float getPulse(float phase, float width = 0.5f) noexcept;
+    static float getDoubleSine(float phase) noexcept;
+    static float getHalfSine(float phase) noexcept;
+    static float getResonantSaw(float phase) noexcept;
+    static float getResonantTriangle(float phase) noexcept;
+    static float getTrapezoid(float phase) noexcept;
 };
 
 } // namespace DSP
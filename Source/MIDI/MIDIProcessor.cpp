@@ -51,8 +51,10 @@ void MIDIProcessor::processMidiMessage(const juce::MidiMessage& message) noexcep
         handleControlChange(message.getControllerNumber(), message.getControllerValue());
     else if (message.isChannelPressure())
         handleAftertouch(message.getChannelPressureValue() / 127.0f);
+    else if (message.isProgramChange())
+        handleProgramChange(message.getProgramChangeNumber());
     else if (message.isSysEx())
-        handleSysEx(message.getSysExData(), message.getSysExDataSize());
+        handleSysEx(message.getRawData(), message.getRawDataSize()); // F0 ... F7: SysExManager frames on them
 }
 
 void MIDIProcessor::processMidiBuffer(const juce::MidiBuffer& midiBuffer) noexcept
@@ -197,11 +199,19 @@ void MIDIProcessor::handleAftertouch(float value) noexcept
     voiceManager.setAftertouch(value);
 }
 
+void MIDIProcessor::handleProgramChange(int program) noexcept
+{
+    // The owner swaps in the program's pre-built snapshot; the split in processMidiBuffer
+    // means the new sound starts on this event's sample
+    if (onProgramChange)
+        onProgramChange(program);
+}
+
 void MIDIProcessor::handleSysEx(const void* data, int size) noexcept
 {
     if (sysExManager)
-        // Pass the RAW data including F0/F7 for robust buffering
-        sysExManager->handleSysEx(data, size, "MIDI Input");
+        // Pass the RAW data including F0/F7 for robust buffering (fixed buffers: audio-thread safe)
+        sysExManager->handleMidiSysEx(data, size);
 }
 
 } // namespace MIDI
@@ -3,6 +3,8 @@
 #include "../Core/VoiceManager.h"
 #include "SysExManager.h"
 #include <juce_audio_processors/juce_audio_processors.h>
+#include <algorithm>
+#include <map>
 
 namespace CZ101 {
 namespace MIDI {
@@ -19,6 +21,35 @@ public:
     void processMessage(const juce::MidiMessage& message) { processMidiMessage(message); }
     void processMidiBuffer(const juce::MidiBuffer& midiBuffer) noexcept;
     
+    // Sub-blocks after the first are at least this long: events closer than this to the previous
+    // split are dispatched at that split (< 0.4 ms early at 44.1 kHz), which bounds the render
+    // calls for dense controller streams to numSamples / MIN_SUB_BLOCK_SAMPLES + 2
+    static constexpr int MIN_SUB_BLOCK_SAMPLES = 16;
+    
+    /**
+     * Sample-accurate dispatch: renders the block in sub-blocks split at the event
+     * timestamps, dispatching each event right before the audio it affects.
+     * render(startSample, numSamples) is called for every sub-block, in order.
+     */
+    template <typename Renderer>
+    void processMidiBuffer(const juce::MidiBuffer& midiBuffer, int numSamples, Renderer&& render) noexcept
+    {
+        int subBlockStart = 0;
+        for (const auto metadata : midiBuffer)
+        {
+            const int eventPosition = std::clamp(metadata.samplePosition, 0, numSamples);
+            if (eventPosition > subBlockStart && (subBlockStart == 0 || eventPosition - subBlockStart >= MIN_SUB_BLOCK_SAMPLES))
+            {
+                render(subBlockStart, eventPosition - subBlockStart);
+                subBlockStart = eventPosition;
+            }
+            processMidiMessage(metadata.getMessage());
+        }
+        
+        if (subBlockStart < numSamples)
+            render(subBlockStart, numSamples - subBlockStart);
+    }
+    
     void setPitchBendRange(int semitones) noexcept { pitchBendRange = semitones; }
     void setMidiChannel(int channel) noexcept { listenChannel = channel; }
     
@@ -32,9 +63,12 @@ private:
     
     // Audit Fix 10.1: Lock-free callback for parameter updates
     std::function<void(const char*, float)> onMidiParamChange; 
+    std::function<void(int)> onProgramChange;
     
 public:
     void setParamChangeCallback(std::function<void(const char*, float)> cb) { onMidiParamChange = cb; }
+    // Program Change: called on the audio thread, at the event's position in the block
+    void setProgramChangeCallback(std::function<void(int)> cb) { onProgramChange = cb; }
 
 private:
     
@@ -68,6 +102,7 @@ public:
     void handlePitchBend(int value) noexcept;
     void handleControlChange(int cc, int value) noexcept;
     void handleAftertouch(float value) noexcept;
+    void handleProgramChange(int program) noexcept;
     void handleSysEx(const void* data, int size) noexcept;
 };
 
@@ -10,6 +10,7 @@
 #include <array>
 #include <cstdint>
 #include <algorithm> // Added for std::clamp
+#include <cstring>
 
 using std::uint8_t;
 
@@ -43,24 +44,75 @@ static float mapCZDepth(uint8_t depthVal) {
     return static_cast<float>(depthVal) / 99.0f;
 }
 
+bool SysExManager::FragmentBuffer::append(const void* data, int numBytes) noexcept
+{
+    bool kept = true;
+    if (numBytes > CAPACITY - size)
+    {
+        size = 0; // Partial message too large: discard the buffer to prevent overflow
+        kept = false;
+    }
+    
+    numBytes = std::min(numBytes, CAPACITY);
+    std::memcpy(bytes.data() + size, data, (size_t)numBytes);
+    size += numBytes;
+    return kept;
+}
+
+void SysExManager::FragmentBuffer::removeFront(int numBytes) noexcept
+{
+    numBytes = std::min(numBytes, size);
+    std::memmove(bytes.data(), bytes.data() + numBytes, (size_t)(size - numBytes));
+    size -= numBytes;
+}
+
 void SysExManager::handleSysEx(const void* data, int size, const juce::String& patchName)
 {
-    if (memoryProtected || !programChangeEnabled) return;
+    if (memoryProtected.load(std::memory_order_relaxed) || !programChangeEnabled.load(std::memory_order_relaxed)) return;
 
     // Audit Fix 4.3: Robust Buffering / Running Status handling
-    fragmentBuffer.append(data, size);
+    if (!importFragments.append(data, size))
+        juce::Logger::writeToLog("SysEx fragment too large (>10KB), discarding buffer to prevent overflow");
+
+    parseMessages(importFragments, importPatch,
+        [&](CZ101::State::Preset& preset, int patchCount)
+        {
+            preset.name = patchName.toStdString();
+            if (patchCount > 0) preset.name += " " + std::to_string(patchCount);
+            if (onPresetParsed) onPresetParsed(preset);
+        },
+        [](uint8_t expected, uint8_t checksum)
+        {
+            juce::Logger::writeToLog("⚠️ SysEx Checksum Error: Expected " + juce::String::toHexString(expected) + " got " + juce::String::toHexString(checksum));
+        });
+}
 
-    while (fragmentBuffer.getSize() > 0)
+void SysExManager::handleMidiSysEx(const void* data, int size) noexcept
+{
+    if (memoryProtected.load(std::memory_order_relaxed) || !programChangeEnabled.load(std::memory_order_relaxed)) return;
+
+    midiFragments.append(data, size);
+
+    parseMessages(midiFragments, midiPatch,
+        [this](const CZ101::State::Preset& preset, int) { if (onMidiPatchReceived) onMidiPatchReceived(preset); },
+        [](uint8_t, uint8_t) {}); // Accepted as on the import path, without logging from the audio thread
+}
+
+template <typename OnPatch, typename OnChecksumError>
+void SysExManager::parseMessages(FragmentBuffer& fragments, CZ101::State::Preset& preset,
+                                 OnPatch&& onPatch, OnChecksumError&& onChecksumError)
+{
+    while (fragments.size > 0)
     {
-        const uint8_t* bytes = static_cast<const uint8_t*>(fragmentBuffer.getData());
-        int totalSize = (int)fragmentBuffer.getSize();
+        const uint8_t* bytes = fragments.bytes.data();
+        int totalSize = fragments.size;
 
         // Search for F0 (SYSEX_START)
         int startPos = -1;
         for (int i = 0; i < totalSize; ++i) if (bytes[i] == 0xF0) { startPos = i; break; }
 
-        if (startPos == -1) { fragmentBuffer.reset(); break; } // No start found, discard junk
-        if (startPos > 0) { fragmentBuffer.removeSection(0, startPos); continue; } // Skip leading junk
+        if (startPos == -1) { fragments.size = 0; break; } // No start found, discard junk
+        if (startPos > 0) { fragments.removeFront(startPos); continue; } // Skip leading junk
 
         // Search for F7 (SYSEX_END)
         int endPos = -1;
@@ -69,21 +121,14 @@ void SysExManager::handleSysEx(const void* data, int size, const juce::String& p
             if (bytes[i] == 0xF0 && i > 0) break; // Next message start before end? 
         }
 
-        if (endPos == -1) {
-            // Partial message, wait for more. Safety: cap at 10KB
-            if (totalSize > 10000) {
-                 juce::Logger::writeToLog("SysEx fragment too large (>10KB), discarding buffer to prevent overflow");
-                 fragmentBuffer.reset(); 
-            }
-            break; 
-        }
+        if (endPos == -1) break; // Partial message, wait for more (FragmentBuffer caps it)
 
         int msgSize = endPos + 1;
         const uint8_t* msg = bytes; // F0 ... F7
 
         // Validation (Casio ID 0x44)
         if (msgSize < 10 || msg[1] != 0x44) {
-            fragmentBuffer.removeSection(0, msgSize);
+            fragments.removeFront(msgSize);
             continue;
         }
 
@@ -92,7 +137,7 @@ void SysExManager::handleSysEx(const void* data, int size, const juce::String& p
         for (int i = 7; i < msgSize - 2; ++i) sum += msg[i];
         uint8_t checksum = (uint8_t)((0 - sum) & 0x7F);
         if (checksum != msg[msgSize - 2]) {
-            juce::Logger::writeToLog("⚠️ SysEx Checksum Error: Expected " + juce::String::toHexString(msg[msgSize-2]) + " got " + juce::String::toHexString(checksum));
+            onChecksumError(msg[msgSize - 2], checksum);
         }
 
         // Audit Fix 10.4: Relax Device ID Check
@@ -100,8 +145,7 @@ void SysExManager::handleSysEx(const void* data, int size, const juce::String& p
         // But for a received Bulk Dump, we should be promiscuous and accept any channel/ID to be robust.
         // Original: if (devId != 0) continue; 
         uint8_t devId = msg[5] & 0x0F; 
-        // We log it but accept it.
-        // juce::Logger::writeToLog("SysEx DevID: " + juce::String(devId));
+        juce::ignoreUnused(devId);
 
         // Parse Patches (Bulk Dump loop)
         int offset = 7;
@@ -111,26 +155,26 @@ void SysExManager::handleSysEx(const void* data, int size, const juce::String& p
 
         while (offset + 256 < msgSize) // Each patch is ~256 nibbles payload? No, check sizes.
         {
-            CZ101::State::Preset preset;
-            preset.name = patchName.toStdString();
-            if (patchCount > 0) preset.name += " " + std::to_string(patchCount);
+            // Decoded in place: the target is reused, so nothing is allocated per patch
+            preset.parameters.clear();
+            preset.pitchEnv = preset.dcwEnv = preset.dcaEnv = {};
+            preset.pitchEnv2 = preset.dcwEnv2 = preset.dcaEnv2 = {};
 
-            // ... (rest of parsing logic)
             // I will use a size-based safety break
             int patchStartOffset = offset;
             
             uint8_t pflag = decodeNibblePair(msg, offset, msgSize);
-            preset.parameters[ParameterIDs::lineSelect.toStdString()] = (float)(pflag & 0x03);
+            preset.parameters.set(ParameterIDs::Index::lineSelect, (float)(pflag & 0x03));
             
             uint8_t pds = decodeNibblePair(msg, offset, msgSize);
             uint8_t pdl = decodeNibblePair(msg, offset, msgSize);
             uint8_t pdh = decodeNibblePair(msg, offset, msgSize);
             float detune = (float)((pdl & 0x0F) + ((pdh & 0x03) * 12)) * 100.0f;
             if ((pds & 0x01)) detune = -detune;
-            preset.parameters[ParameterIDs::osc2Detune.toStdString()] = detune;
+            preset.parameters.set(ParameterIDs::Index::osc2Detune, detune);
 
             uint8_t pvk = decodeNibblePair(msg, offset, msgSize);
-            preset.parameters[ParameterIDs::lfoWaveform.toStdString()] = (float)(pvk & 0x03);
+            preset.parameters.set(ParameterIDs::Index::lfoWaveform, (float)(pvk & 0x03));
             decodeNibblePair(msg, offset, msgSize); 
             decodeNibblePair(msg, offset, msgSize);
             decodeNibblePair(msg, offset, msgSize);
@@ -138,17 +182,17 @@ void SysExManager::handleSysEx(const void* data, int size, const juce::String& p
             uint8_t rv1 = decodeNibblePair(msg, offset, msgSize);
             uint8_t rv2 = decodeNibblePair(msg, offset, msgSize);
             decodeNibblePair(msg, offset, msgSize);
-            preset.parameters[ParameterIDs::lfoRate.toStdString()] = mapCZRateToNormalized((rv1 & 0x0F) | ((rv2 & 0x0F) << 4)) * 20.0f;
+            preset.parameters.set(ParameterIDs::Index::lfoRate, mapCZRateToNormalized((rv1 & 0x0F) | ((rv2 & 0x0F) << 4)) * 20.0f);
 
             uint8_t dv1 = decodeNibblePair(msg, offset, msgSize);
             uint8_t dv2 = decodeNibblePair(msg, offset, msgSize);
             decodeNibblePair(msg, offset, msgSize);
-            preset.parameters[ParameterIDs::lfoDepth.toStdString()] = mapCZDepth((dv1 & 0x0F) | ((dv2 & 0x0F) << 4));
+            preset.parameters.set(ParameterIDs::Index::lfoDepth, mapCZDepth((dv1 & 0x0F) | ((dv2 & 0x0F) << 4)));
 
             uint8_t mfw1 = decodeNibblePair(msg, offset, msgSize);
             uint8_t mfw1_2 = decodeNibblePair(msg, offset, msgSize);
-            preset.parameters[ParameterIDs::osc1Waveform.toStdString()] = (float)(mfw1 & 0x07);
-            preset.parameters[ParameterIDs::osc1Waveform2.toStdString()] = (float)(mfw1_2 & 0x07);
+            preset.parameters.set(ParameterIDs::Index::osc1Waveform, (float)(mfw1 & 0x07));
+            preset.parameters.set(ParameterIDs::Index::osc1Waveform2, (float)(mfw1_2 & 0x07));
 
             decodeNibblePair(msg, offset, msgSize); decodeNibblePair(msg, offset, msgSize);
             decodeNibblePair(msg, offset, msgSize); decodeNibblePair(msg, offset, msgSize);
@@ -159,8 +203,8 @@ void SysExManager::handleSysEx(const void* data, int size, const juce::String& p
 
             uint8_t mfw2 = decodeNibblePair(msg, offset, msgSize);
             uint8_t mfw2_2 = decodeNibblePair(msg, offset, msgSize);
-            preset.parameters[ParameterIDs::osc2Waveform.toStdString()] = (float)(mfw2 & 0x07);
-            preset.parameters[ParameterIDs::osc2Waveform2.toStdString()] = (float)(mfw2_2 & 0x07);
+            preset.parameters.set(ParameterIDs::Index::osc2Waveform, (float)(mfw2 & 0x07));
+            preset.parameters.set(ParameterIDs::Index::osc2Waveform2, (float)(mfw2_2 & 0x07));
 
             decodeNibblePair(msg, offset, msgSize); decodeNibblePair(msg, offset, msgSize);
             decodeNibblePair(msg, offset, msgSize); decodeNibblePair(msg, offset, msgSize);
@@ -169,13 +213,13 @@ void SysExManager::handleSysEx(const void* data, int size, const juce::String& p
             State::EnvelopeSerializer::decodeFromSysEx(msg, offset, msgSize, preset.dcwEnv2);
             State::EnvelopeSerializer::decodeFromSysEx(msg, offset, msgSize, preset.pitchEnv2);
 
-            if (onPresetParsed) onPresetParsed(preset);
+            onPatch(preset, patchCount);
             patchCount++;
             
             if (offset == patchStartOffset) break; // Infinite loop safety
         }
 
-        fragmentBuffer.removeSection(0, msgSize);
+        fragments.removeFront(msgSize);
     }
 }
 
@@ -202,22 +246,18 @@ juce::MemoryBlock SysExManager::createPatchDump(const CZ101::State::Preset& pres
     juce::MemoryBlock data;
     data.ensureSize(264);
 
-    // Helper to safely get parameter
-    auto getParam = [&](const std::string& key, float def = 0.0f) {
-        auto it = preset.parameters.find(key);
-        if (it != preset.parameters.end()) return it->second;
-        return def;
-    };
+    // Helper to safely get parameter (stored value or default)
+    auto getParam = [&](ParameterIDs::Index id, float def = 0.0f) { return preset.parameters.get(id, def); };
 
     // Header
     const uint8_t header[] = { 0xF0, MANUF_ID_1, MANUF_ID_2, MANUF_ID_3, DEVICE_ID_BASE, FUNC_RECV, PROG_EDIT };
     data.append(header, sizeof(header));
 
     // Data Body PFLAG
-    uint8_t pflag = (uint8_t)getParam(ParameterIDs::lineSelect.toStdString(), 2.0f) & 0x03;
+    uint8_t pflag = (uint8_t)getParam(ParameterIDs::Index::lineSelect, 2.0f) & 0x03;
     encodeNibblePair(pflag, data);
 
-    float detune = getParam(ParameterIDs::osc2Detune.toStdString(), 0.0f) / 100.0f;
+    float detune = getParam(ParameterIDs::Index::osc2Detune, 0.0f) / 100.0f;
     uint8_t sign = (detune < 0) ? 1 : 0;
     int detuneInt = (int)std::abs(detune);
     uint8_t pdl = detuneInt % 12;
@@ -228,20 +268,20 @@ juce::MemoryBlock SysExManager::createPatchDump(const CZ101::State::Preset& pres
     encodeNibblePair(pdh, data);  // PDH
 
     // Vibrato
-    uint8_t wave = (uint8_t)getParam(ParameterIDs::lfoWaveform.toStdString(), 0.0f);
+    uint8_t wave = (uint8_t)getParam(ParameterIDs::Index::lfoWaveform, 0.0f);
     encodeNibblePair(wave, data); // PVK
     encodeNibblePair(0, data); // PVD (Delay)
     encodeNibblePair(0, data); 
     encodeNibblePair(0, data); 
     
-    float normRate = getParam(ParameterIDs::lfoRate.toStdString(), 1.0f) / 20.0f;
+    float normRate = getParam(ParameterIDs::Index::lfoRate, 1.0f) / 20.0f;
     int rateVal = mapNormalizedToCZRate(normRate);
     encodeNibblePair(rateVal & 0x0F, data); // RV1
     encodeNibblePair((rateVal >> 4) & 0x0F, data); // RV2
 
     encodeNibblePair(0, data); 
     
-    float depth = getParam(ParameterIDs::lfoDepth.toStdString(), 0.0f);
+    float depth = getParam(ParameterIDs::Index::lfoDepth, 0.0f);
     int depthVal = (int)(depth * 99.0f);
     encodeNibblePair(depthVal & 0x0F, data); // DV1
     encodeNibblePair((depthVal >> 4) & 0x0F, data); // DV2
@@ -249,8 +289,8 @@ juce::MemoryBlock SysExManager::createPatchDump(const CZ101::State::Preset& pres
     encodeNibblePair(0, data); 
 
     // 8. Waveforms Line 1
-    encodeNibblePair((uint8_t)getParam(ParameterIDs::osc1Waveform.toStdString(), 0.0f), data);
-    encodeNibblePair((uint8_t)getParam(ParameterIDs::osc1Waveform2.toStdString(), 0.0f), data);
+    encodeNibblePair((uint8_t)getParam(ParameterIDs::Index::osc1Waveform, 0.0f), data);
+    encodeNibblePair((uint8_t)getParam(ParameterIDs::Index::osc1Waveform2, 0.0f), data);
 
     // 9-10. Key Follow 
     for(int i=0; i<4; ++i) encodeNibblePair(0, data);
@@ -261,8 +301,8 @@ juce::MemoryBlock SysExManager::createPatchDump(const CZ101::State::Preset& pres
     State::EnvelopeSerializer::encodeToSysEx(preset.pitchEnv, data);
     
     // 17. Waveforms Line 2
-    encodeNibblePair((uint8_t)getParam(ParameterIDs::osc2Waveform.toStdString(), 0.0f), data);
-    encodeNibblePair((uint8_t)getParam(ParameterIDs::osc2Waveform2.toStdString(), 0.0f), data);
+    encodeNibblePair((uint8_t)getParam(ParameterIDs::Index::osc2Waveform, 0.0f), data);
+    encodeNibblePair((uint8_t)getParam(ParameterIDs::Index::osc2Waveform2, 0.0f), data);
 
     // 18-19. Key Follow 2
     for(int i=0; i<4; ++i) encodeNibblePair(0, data);
@@ -9,6 +9,7 @@
 #include <functional>
 #include <string>
 #include <array>
+#include <atomic>
 #include "../State/PresetManager.h"  // Adjusted Include
 
 namespace CZ101 {
@@ -42,7 +43,7 @@ public:
     ~SysExManager() = default;
 
     /**
-     * Parse and handle incoming SysEx message
+     * Parse and handle incoming SysEx message (message thread: file import / drag and drop)
      * 
      * @param data Pointer to SysEx data (including F0 and F7)
      * @param size Size of SysEx data in bytes
@@ -53,12 +54,24 @@ public:
         int size,
         const juce::String& patchName);
 
+    /**
+     * Parse SysEx received over MIDI (audio thread)
+     * 
+     * Same framing and decoding as handleSysEx, with its own fixed buffers: no allocation,
+     * no logging and no naming (the patch keeps its scratch name), so received patches
+     * can be applied at the event's sample. Calls onMidiPatchReceived.
+     */
+    void handleMidiSysEx(const void* data, int size) noexcept;
+
     /**
      * Callback when preset is successfully parsed
      * Usage: manager.onPresetParsed = [this](const auto& preset) { ... };
      */
     std::function<void(const CZ101::State::Preset&)> onPresetParsed;
     
+    /** Callback for patches from handleMidiSysEx: runs on the audio thread and must be real-time safe */
+    std::function<void(const CZ101::State::Preset&)> onMidiPatchReceived;
+    
     /**
      * Decode a single SysEx patch (264 bytes including F0/F7)
      * @param data Pointer to 264 bytes of SysEx data
@@ -74,17 +87,39 @@ public:
      */
     juce::MemoryBlock createPatchDump(const CZ101::State::Preset& preset);
     
-    // Protection State
+    // Protection State (message thread; read by handleSysEx on the audio thread)
     void setProtectionState(bool protectedMem, bool prgEnabled) {
-        memoryProtected = protectedMem;
-        programChangeEnabled = prgEnabled;
+        memoryProtected.store(protectedMem, std::memory_order_relaxed);
+        programChangeEnabled.store(prgEnabled, std::memory_order_relaxed);
     }
 
 private:
-    bool memoryProtected = true;
-    bool programChangeEnabled = false;
+    std::atomic<bool> memoryProtected { true };
+    std::atomic<bool> programChangeEnabled { false };
     
-    juce::MemoryBlock fragmentBuffer; // Audit Fix 4.3: Persistent buffer for fragmented SysEx
+    // Audit Fix 4.3: Persistent buffer for fragmented SysEx (fixed size, so the MIDI path never allocates)
+    struct FragmentBuffer
+    {
+        static constexpr int CAPACITY = 10000; // Larger partial messages are discarded
+        std::array<uint8_t, CAPACITY> bytes {};
+        int size = 0;
+        
+        /** Returns false if buffered bytes had to be discarded to make room */
+        bool append(const void* data, int numBytes) noexcept;
+        void removeFront(int numBytes) noexcept;
+    };
+    
+    // One buffer and decode target per caller thread
+    FragmentBuffer importFragments, midiFragments;
+    CZ101::State::Preset importPatch, midiPatch;
+    
+    /**
+     * Frames complete messages in fragments and decodes their patches into patch, calling
+     * onPatch(patch, patchIndex) for each and onChecksumError(stored, computed) on a mismatch
+     */
+    template <typename OnPatch, typename OnChecksumError>
+    static void parseMessages(FragmentBuffer& fragments, CZ101::State::Preset& patch,
+                              OnPatch&& onPatch, OnChecksumError&& onChecksumError);
 
     // Helper functions are static - see .cpp for implementation
 
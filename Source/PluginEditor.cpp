@@ -501,7 +501,10 @@ juce::PopupMenu CZ101AudioProcessorEditor::getMenuForIndex(int, const juce::Stri
         oversamplingMenu.addItem(410, "1x (Eco)", true, currentQ == 0);
         oversamplingMenu.addItem(411, "2x (High)", true, currentQ == 1);
         oversamplingMenu.addItem(412, "4x (Ultra)", true, currentQ == 2);
-        oversamplingMenu.addSubMenu("Oversampling", oversamplingMenu);
+        oversamplingMenu.addSeparator();
+        oversamplingMenu.addItem(413, "2x (Mix Bus)", true, currentQ == 3);
+        oversamplingMenu.addItem(414, "4x (Mix Bus)", true, currentQ == 4);
+        m.addSubMenu("Oversampling", oversamplingMenu);
     } else if (n == "View") {
         m.addItem(300, "Zoom 100%"); m.addItem(301, "Zoom 125%"); m.addItem(302, "Zoom 150%");
         m.addSeparator();
@@ -566,6 +569,8 @@ void CZ101AudioProcessorEditor::menuItemSelected(int id, int) {
         case 410: if (auto* p = audioProcessor.getParameters().getOversamplingQuality()) *p = 0; break;
         case 411: if (auto* p = audioProcessor.getParameters().getOversamplingQuality()) *p = 1; break;
         case 412: if (auto* p = audioProcessor.getParameters().getOversamplingQuality()) *p = 2; break;
+        case 413: if (auto* p = audioProcessor.getParameters().getOversamplingQuality()) *p = 3; break;
+        case 414: if (auto* p = audioProcessor.getParameters().getOversamplingQuality()) *p = 4; break;
 
         case 901: aboutDialog.setVisible(true); aboutDialog.toFront(true); break;
         default:
@@ -4,6 +4,48 @@
 #include "State/EnvelopeSerializer.h"
 #include "DSP/Envelopes/ADSRtoStage.h" // [NEW] for Snapshot Builder // Required for unique_ptr destructor
 #include "UI/LCDStateManager.h"
+#include <algorithm>
+#include <array>
+
+namespace
+{
+    // Oversampling choice index: 1x, 2x, 4x (per voice), 2x, 4x (mix bus)
+    int oversamplingFactorForChoice(int choice) noexcept { return choice == 0 ? 1 : ((choice == 1 || choice == 3) ? 2 : 4); }
+    bool isMixBusOversamplingChoice(int choice) noexcept { return choice >= 3; }
+    
+    // Macro Brilliance: > 0.5 = Brighter, < 0.5 = Darker (voice filter cutoff offset in Hz)
+    float brillianceCutoffOffset(float macroBrilliance) noexcept { return (macroBrilliance - 0.5f) * 2000.0f; }
+    
+    // Snapshot override serials (Program Change, SysEx patch) wrap around
+    bool isNewerSerial(uint32_t a, uint32_t b) noexcept { return static_cast<int32_t>(a - b) > 0; }
+    
+    using P = CZ101::ParameterIDs::Index;
+    constexpr std::array<P, 4> DCW_MACROS { P::dcwAttack, P::dcwDecay, P::dcwSustain, P::dcwRelease };
+    constexpr std::array<P, 4> DCA_MACROS { P::dcaAttack, P::dcaDecay, P::dcaSustain, P::dcaRelease };
+    
+    // A patch without ADSR macros for DCW (or DCA), such as a CZ SysEx dump, is played with its 8-stage envelopes
+    bool storesNone(const CZ101::State::PresetParameters& parameters, const std::array<P, 4>& ids) noexcept
+    {
+        return std::none_of(ids.begin(), ids.end(), [&](P id) { return parameters.has(id); });
+    }
+    
+    void copyPresetEnvelopes(const CZ101::State::Preset& preset, CZ101::Core::ParameterSnapshot& snap, bool dcw, bool dca)
+    {
+        using CZ101::State::EnvelopeSerializer;
+        EnvelopeSerializer::copyToSnapshot(preset.pitchEnv, snap.envelopes.pitch1);
+        EnvelopeSerializer::copyToSnapshot(preset.pitchEnv2, snap.envelopes.pitch2);
+        if (dcw)
+        {
+            EnvelopeSerializer::copyToSnapshot(preset.dcwEnv, snap.envelopes.dcw1);
+            EnvelopeSerializer::copyToSnapshot(preset.dcwEnv2, snap.envelopes.dcw2);
+        }
+        if (dca)
+        {
+            EnvelopeSerializer::copyToSnapshot(preset.dcaEnv, snap.envelopes.dca1);
+            EnvelopeSerializer::copyToSnapshot(preset.dcaEnv2, snap.envelopes.dca2);
+        }
+    }
+}
 
 // --- CONSTRUCTOR ---
 CZ101AudioProcessor::CZ101AudioProcessor()
@@ -28,39 +70,45 @@ CZ101AudioProcessor::CZ101AudioProcessor()
     // Bind SysEx Callback
     juce::Logger::writeToLog("Binding SysEx Callback...");
     sysExManager.onPresetParsed = [this](const CZ101::State::Preset& p) {
-        // 1. Prepare POD for Audio Thread
-        EnvelopeStatePOD pod;
-        pod.pitchEnv = p.pitchEnv; pod.dcwEnv = p.dcwEnv; pod.dcaEnv = p.dcaEnv;
-        pod.pitchEnv2 = p.pitchEnv2; pod.dcwEnv2 = p.dcwEnv2; pod.dcaEnv2 = p.dcaEnv2;
-        
-        int s1, sz1, s2, sz2;
-        presetFifo.prepareToWrite(1, s1, sz1, s2, sz2);
-        if (sz1 > 0) presetBuffer[s1] = pod;
-        else if (sz2 > 0) presetBuffer[s2] = pod;
-        presetFifo.finishedWrite(sz1 + sz2);
-        
-        // 2. Defer Parameter/Host notification to Message Thread
-        {
-            const juce::ScopedLock sl(sysExLock);
-            pendingSysExPreset = std::make_unique<CZ101::State::Preset>(p);
-            hasPendingSysEx = true;
-        }
-        triggerAsyncUpdate();
+        // Message thread (file import): loaded and committed right here, replacing any patch
+        // or program the audio thread switched to before it
+        const auto serial = overrideSerials.fetch_add(1) + 1;
+        presetManager.loadPresetFromStruct(p);
+        caughtUpOverrideSerial.store(serial);
+    };
+    sysExManager.onMidiPatchReceived = [this](const CZ101::State::Preset& p) noexcept {
+        applySysExPatch(p);
     };
     
     juce::Logger::writeToLog("Setting SysEx Manager...");
     midiProcessor.setSysExManager(&sysExManager);
     midiProcessor.setAPVTS(&parameters.getAPVTS());
     
+    bindAutomation();
+    
     // Audit Fix 10.1: Bind Lock-free MIDI Param Callback
     midiProcessor.setParamChangeCallback([this](const char* id, float val) {
         scheduleMidiParamUpdate(id, val);
     });
+    midiProcessor.setProgramChangeCallback([this](int program) noexcept {
+        applyProgramChange(program);
+    });
+    presetManager.addListener(this);
     
     // Initialize LCD State Manager here to ensure it persists and avoids dangling references
     juce::Logger::writeToLog("CZ101 Processor: Initializing LCD State Manager");
     lcdStateManager = std::make_unique<CZ101::UI::LCDStateManager>(parameters.getAPVTS());
 
+    // Preset loads write every parameter inside a Parameters::ScopedBatch: the per-parameter
+    // listeners stay quiet and the whole preset lands as one snapshot and one host/LCD refresh.
+    parameters.onBatchBegin = [this] { lcdStateManager->beginBatchUpdate(); };
+    parameters.onBatchEnd = [this]
+    {
+        updateParameters();
+        updateHostDisplay(juce::AudioProcessorListener::ChangeDetails().withProgramChanged(true));
+        lcdStateManager->endBatchUpdate();
+    };
+
     // Audit Fix [D]: Reconnect UI and DSP
     // Register this processor as a listener for all parameters to trigger snapshot updates
     for (auto* p : juce::AudioProcessor::getParameters()) {
@@ -75,6 +123,7 @@ CZ101AudioProcessor::CZ101AudioProcessor()
 CZ101AudioProcessor::~CZ101AudioProcessor() 
 { 
     // Unregister listeners
+    presetManager.removeListener(this);
     for (auto* p : juce::AudioProcessor::getParameters()) {
         if (auto* rp = dynamic_cast<juce::RangedAudioParameter*>(p)) {
             parameters.getAPVTS().removeParameterListener(rp->getParameterID(), this);
@@ -158,6 +207,10 @@ void CZ101AudioProcessor::prepareToPlay (double sampleRate, int samplesPerBlock)
     
     // Audit Fix 4.1: FIFO resizing
     voiceManager.setSampleRate(sampleRate);
+    
+    // Parallel voice rendering: one worker per spare physical core, up to VoiceRenderPool::MAX_WORKERS
+    // (used only for large voice counts; falls back to inline rendering without real-time threads)
+    voiceManager.setParallelRendering(juce::SystemStats::getNumPhysicalCpus() - 1);
  
     // Audit Fix: Initialize Vis Buffer (Triple Buffer is std::array, no resize needed)
     // visBuffer.setSize(1, VIS_FIFO_SIZE);
@@ -184,6 +237,7 @@ void CZ101AudioProcessor::prepareToPlay (double sampleRate, int samplesPerBlock)
     
     juce::Logger::writeToLog("CZ101Processor: Initializing Preset 0");
     presetManager.loadPreset(0);
+    publishProgramBank(); // Real-time Program Changes read the bank from here on (bankUpdated keeps it current)
     // Modern Filters Setup
     juce::dsp::ProcessSpec spec;
     spec.sampleRate = sampleRate;
@@ -192,11 +246,18 @@ void CZ101AudioProcessor::prepareToPlay (double sampleRate, int samplesPerBlock)
     
     effectsChain.prepare(spec);
     
+    // Voices start at the current parameter values instead of ramping from the defaults
+    automation.reset();
+    applyVoiceAutomation(1.0f);
+    
     // Audit Fix 3.1: Initialize Latency
     updateParameters();
 }
 
-void CZ101AudioProcessor::releaseResources() {}
+void CZ101AudioProcessor::releaseResources()
+{
+    voiceManager.setParallelRendering(0);
+}
 
 bool CZ101AudioProcessor::isBusesLayoutSupported(const BusesLayout& layouts) const
 {
@@ -228,46 +289,84 @@ void CZ101AudioProcessor::processBlock(juce::AudioBuffer<float>& buffer, juce::M
     // Envelopes are "Events", Snapshot is "State". Keep Events separate.
     processEnvelopeUpdates();
 
-    // 2. Process SysEx Presets (if any pending swap) logic is handled in handleAsyncUpdate mostly, 
-    // but pendingSysExPreset logic was for message thread.
-    // Here we might have a simple atomic swap if we used lock-free queue for whole presets.
-    // For now, handleAsyncUpdate handles the Heavy Load, and we just read the resulting Snapshot.
+    // 2. SysEx patches and Program Changes are swapped in at their event's sample (applySysExPatch,
+    // applyProgramChange); handleAsyncUpdate brings APVTS, host and UI up to them afterwards.
     
-    // 3. Get LATEST Snapshot
+    // 3. Get LATEST Snapshot (a Program Change / SysEx patch wins until the message thread caught up;
+    //    the serial is checked first so a caught-up pool snapshot is never missed)
+    if (snapshotOverride != nullptr && !isNewerSerial(activeOverrideSerial, caughtUpOverrideSerial.load()))
+        snapshotOverride = nullptr;
     const auto* snapshot = audioSnapshot.get();
+    if (snapshotOverride != nullptr)
+        snapshot = snapshotOverride;
     
     // Optimized Bypass Path
     // Bypass is not in Snapshot yet (Juice Param). 
     // We should probably rely on the Param directly for Bypass or put it in Snapshot.
     // For safety, let's use the param directly as it's an Atomic wrapper usually?
     // Parameters access in Audio Thread is SAFE if they are Atomics (most JUCE params are).
-    // But `getBypass()->get()` is safe.
-    if (parameters.getBypass() && parameters.getBypass()->get())
+    // The cached handle is that atomic (no APVTS string lookup on the audio thread).
+    if (parameters.getRawBool(CZ101::ParameterIDs::Index::bypass))
     {
         midiProcessor.processMidiBuffer(midiMessages);
         performanceMonitor.stopMeasurement();
         return;
     }
 
-    // 4. Apply Snapshot to Voice Manager
+    // 4. Apply Snapshot to Voice Manager (only the sections changed since the last applied version)
     if (snapshot)
-    {
         voiceManager.applySnapshot(snapshot);
-        voiceManager.getArpeggiator().setEnabled(snapshot->arp.enabled); // Redundant? applySnapshot does it.
-    }
-    
-    midiProcessor.processMidiBuffer(midiMessages);
     
+    syncArpeggiatorToHost();
+
     auto* channelDataL = buffer.getWritePointer(0);
     auto* channelDataR = buffer.getWritePointer(1);
     
-    // Render synth audio ONCE
-    voiceManager.renderNextBlock(channelDataL, channelDataR, buffer.getNumSamples());
+    // Render synth audio, split at the MIDI timestamps so every event lands on its own sample
+    // Automated continuous parameters ramp across the block: voices get a breakpoint every
+    // RAMP_SEGMENT_SAMPLES while anything moves (their control-rate smoothing joins the steps)
+    automation.beginBlock();
+    if (snapshotOverride != nullptr)
+        holdAutomationAt(*snapshotOverride); // The APVTS values still belong to the previous patch
+    const int blockSize = buffer.getNumSamples();
+    const float invBlockSize = 1.0f / static_cast<float>(std::max(1, blockSize));
+    
+    // Render synth audio, split at the MIDI timestamps so every event lands on its own sample
+    midiProcessor.processMidiBuffer(midiMessages, blockSize, [&](int startSample, int numSamples) noexcept {
+        const int end = startSample + numSamples;
+        for (int pos = startSample; pos < end;)
+        {
+            const int segment = automation.isRamping() ? std::min(CZ101::Core::ParameterAutomation::RAMP_SEGMENT_SAMPLES, end - pos) : end - pos;
+            applyVoiceAutomation(static_cast<float>(pos + segment) * invBlockSize);
+            voiceManager.renderNextBlock(channelDataL + pos, channelDataR + pos, segment);
+            pos += segment;
+        }
+    });
+    performanceMonitor.setVoiceCount(voiceManager.getActiveVoiceCount());
+    performanceMonitor.setRetiredVoiceCount(voiceManager.getSilenceRetiredCount());
 
-    // 5. Effects Processing
+    // 5. Effects Processing (a Program Change inside this block switches the effects at the block end)
+    if (snapshotOverride != nullptr)
+        snapshot = snapshotOverride;
     if (snapshot)
     {
-         effectsChain.process(buffer, *snapshot);
+        using Automated = CZ101::Core::ParameterAutomation;
+        auto effects = snapshot->effects;
+        effects.lpfCutoff = automation.getEnd(Automated::LpfCutoff);
+        effects.lpfReso = automation.getEnd(Automated::LpfReso);
+        effects.hpfCutoff = automation.getEnd(Automated::HpfCutoff);
+        effects.chorusRate = automation.getEnd(Automated::ChorusRate);
+        effects.chorusDepth = automation.getEnd(Automated::ChorusDepth);
+        effects.chorusMix = automation.getEnd(Automated::ChorusMix);
+        effects.delayFb = automation.getEnd(Automated::DelayFeedback);
+        effects.delayMix = automation.getEnd(Automated::DelayMix);
+        effects.reverbSize = automation.getEnd(Automated::ReverbSize);
+        effects.reverbMix = automation.getEnd(Automated::ReverbMix);
+        effects.driveAmount = automation.getEnd(Automated::DriveAmount);
+        effects.driveColor = automation.getEnd(Automated::DriveColor);
+        effects.driveMix = automation.getEnd(Automated::DriveMix);
+        
+        effectsChain.process(buffer, effects, snapshot->system.opMode);
     }
     
     // Visualization logic - Triple Buffer Producer
@@ -304,9 +403,8 @@ void CZ101AudioProcessor::updateParameters()
     updateSystemGlobal();
     updateArpeggiator();
     
-    // Centralized Snapshot Creation (Optimization: One allocation per update)
-    auto snap = buildAudioSnapshot();
-    audioSnapshot.commit(std::move(snap));
+    // Centralized Snapshot Creation (no allocation: built on the stack, copied into a pooled slot)
+    audioSnapshot.commit(buildAudioSnapshot());
 }
 
 // Audit Fix 2.1: Implement setNonRealtime to recalculate smoothing
@@ -484,24 +582,43 @@ juce::AudioProcessor* JUCE_CALLTYPE createPluginFilter() { return new CZ101Audio
 void CZ101AudioProcessor::handleAsyncUpdate()
 {
     std::unique_ptr<CZ101::State::Preset> p;
+    uint32_t sysExSerial = 0;
     
-    // Check flag first efficiently
-    if (hasPendingSysEx.load())
+    // Newest SysEx patch the audio thread published since the last pick-up (older ones were overwritten)
+    if (sysExMailbox.midIndex.load(std::memory_order_acquire) & SysExPatchMailbox::FRESH)
     {
-        {
-            const juce::ScopedLock sl(sysExLock);
-            p = std::move(pendingSysExPreset);
-            hasPendingSysEx = false;
-        }
-
-    if (p)
-        {
-            // Update Parameters and notify host (Message Thread)
-            // We pass false to updateVoice because we already updated it in the callback
-            presetManager.loadPresetFromStruct(*p, false);
-        }
+        sysExMailbox.frontIndex = sysExMailbox.midIndex.exchange(sysExMailbox.frontIndex, std::memory_order_acq_rel) & ~SysExPatchMailbox::FRESH;
+        const auto& pod = sysExMailbox.slots[static_cast<size_t>(sysExMailbox.frontIndex)];
+        p = std::make_unique<CZ101::State::Preset>("MIDI Input");
+        p->parameters = pod.parameters;
+        p->pitchEnv = pod.pitchEnv;   p->dcwEnv = pod.dcwEnv;   p->dcaEnv = pod.dcaEnv;
+        p->pitchEnv2 = pod.pitchEnv2; p->dcwEnv2 = pod.dcwEnv2; p->dcaEnv2 = pod.dcaEnv2;
+        sysExSerial = pod.serial;
+        if (!isNewerSerial(sysExSerial, caughtUpOverrideSerial.load()))
+            p.reset(); // A file import replaced it meanwhile
     }
     
+    const auto request = requestedProgram.load();
+    const auto programSerial = static_cast<uint32_t>(request >> 32);
+    const bool programPending = programSerial != handledProgramSerial;
+    handledProgramSerial = programSerial;
+    
+    // The audio thread already switched to these patches (SysEx dump, Program Change): bring APVTS,
+    // host and UI up to them in the order they arrived
+    auto loadSysEx = [&] {
+        // The audio thread already applied the patch: this only brings APVTS, host and UI up to it
+        if (p) presetManager.loadPresetFromStruct(*p, false);
+    };
+    auto loadProgram = [&] {
+        if (programPending) presetManager.loadPreset(static_cast<int>(request & 0xffffffffu));
+    };
+    if (p && programPending && isNewerSerial(sysExSerial, programSerial)) { loadProgram(); loadSysEx(); }
+    else                                                                  { loadSysEx(); loadProgram(); }
+    
+    auto caughtUp = caughtUpOverrideSerial.load();
+    if (p && isNewerSerial(sysExSerial, caughtUp)) caughtUp = sysExSerial;
+    if (programPending && isNewerSerial(programSerial, caughtUp)) caughtUp = programSerial;
+
     // Audit Fix 10.1: Process MIDI Parameter Queue
     int mStart1, mSize1, mStart2, mSize2;
     midiParamFifo.prepareToRead(100, mStart1, mSize1, mStart2, mSize2);
@@ -520,6 +637,9 @@ void CZ101AudioProcessor::handleAsyncUpdate()
 
     // Audit Fix [D]: Rebuild Snapshot after any parameter change (SysEx, MIDI, or UI)
     updateParameters();
+    
+    // Published after the commit above: the audio thread drops its override only once the pool holds the same sound
+    caughtUpOverrideSerial.store(caughtUp);
 }
 
 // Audit Fix 10.1: Lock-Free MIDI Scheduler
@@ -546,6 +666,9 @@ void CZ101AudioProcessor::parameterChanged(const juce::String& parameterID, floa
     // Any parameter change in the UI or host automation triggers a snapshot rebuild
     // We use AsyncUpdater to avoid rebuilding the snapshot multiple times in a single block
     // or when multiple parameters change almost simultaneously.
+    // Batched preset writes are committed once by parameters.onBatchEnd instead.
+    juce::ignoreUnused(parameterID, newValue);
+    if (parameters.isApplyingBatch()) return;
     triggerAsyncUpdate();
 }
 
@@ -567,15 +690,15 @@ void CZ101AudioProcessor::toggleCompareMode(bool enable)
 // --- REFACTORED UPDATERS (Audit Fix 4.1) ---
 CZ101AudioProcessor::MacroValues CZ101AudioProcessor::calculateMacros()
 {
+    using P = CZ101::ParameterIDs::Index;
     MacroValues m;
-    float macroBrilliance = parameters.getMacroBrilliance() ? parameters.getMacroBrilliance()->get() : 0.5f;
-    float macroTone = parameters.getMacroTone() ? parameters.getMacroTone()->get() : 0.5f;
-    float macroSpace = parameters.getMacroSpace() ? parameters.getMacroSpace()->get() : 0.0f;
+    float macroBrilliance = parameters.getRaw(P::macroBrilliance);
+    float macroTone = parameters.getRaw(P::macroTone);
+    float macroSpace = parameters.getRaw(P::macroSpace);
 
     // Tone Modifiers (0.5 = No change, < 0.5 = Slower, > 0.5 = Faster)
     m.toneSpeedMult = std::pow(2.0f, (macroTone - 0.5f) * 2.0f); 
-    // Brilliance Modifiers (> 0.5 = Brighter, < 0.5 = Darker)
-    m.brillianceOffset = (macroBrilliance - 0.5f) * 2000.0f;
+    m.brillianceOffset = brillianceCutoffOffset(macroBrilliance);
     // Space Modifiers (Additive Mix)
     m.spaceMix = macroSpace * 0.5f;
     
@@ -584,20 +707,72 @@ CZ101AudioProcessor::MacroValues CZ101AudioProcessor::calculateMacros()
 
 void CZ101AudioProcessor::updateFilters(const MacroValues& m)
 {
-    if (parameters.getModernLpfCutoff()) {
-        float baseCutoff = parameters.getModernLpfCutoff()->get();
-        // Voice Filters use Macro Brilliance (Output LPF handled in EffectsChain via Snapshot)
-        float finalCutoff = juce::jlimit(20.0f, 20000.0f, baseCutoff + m.brillianceOffset);
-        voiceManager.setFilterCutoff(finalCutoff);
-    }
-    if (parameters.getModernLpfReso()) {
-        float res = parameters.getModernLpfReso()->get();
-        voiceManager.setFilterResonance(res);
-    }
-    if (parameters.getModernHpfCutoff()) {
-        float hpf = parameters.getModernHpfCutoff()->get();
-        voiceManager.setHPF(hpf);
-    }
+    // Voice filters follow ParameterAutomation on the audio thread (applyVoiceAutomation)
+}
+
+void CZ101AudioProcessor::bindAutomation()
+{
+    using Automated = CZ101::Core::ParameterAutomation;
+    using P = CZ101::ParameterIDs::Index;
+    auto bind = [&](Automated::Param p, P id, float defaultValue) {
+        automation.bind(p, parameters.getRawHandle(id), defaultValue);
+    };
+    
+    bind(Automated::MasterVolume, P::masterVolume, 1.0f);
+    bind(Automated::LpfCutoff, P::lpfCutoff, 20000.0f);
+    bind(Automated::LpfReso, P::lpfReso, 0.0f);
+    bind(Automated::HpfCutoff, P::hpfCutoff, 20.0f);
+    bind(Automated::MacroBrilliance, P::macroBrilliance, 0.5f);
+    bind(Automated::LfoRate, P::lfoRate, 1.0f);
+    bind(Automated::LfoDepth, P::lfoDepth, 0.0f);
+    bind(Automated::ChorusRate, P::chorusRate, 0.0f);
+    bind(Automated::ChorusDepth, P::chorusDepth, 0.0f);
+    bind(Automated::ChorusMix, P::chorusMix, 0.0f);
+    bind(Automated::DelayFeedback, P::delayFeedback, 0.0f);
+    bind(Automated::DelayMix, P::delayMix, 0.0f);
+    bind(Automated::ReverbSize, P::reverbSize, 0.5f);
+    bind(Automated::ReverbMix, P::reverbMix, 0.0f);
+    bind(Automated::DriveAmount, P::driveAmount, 0.0f);
+    bind(Automated::DriveColor, P::driveColor, 0.5f);
+    bind(Automated::DriveMix, P::driveMix, 0.0f);
+}
+
+// Audio thread: continuous voice parameters at a point of the current block's automation ramps
+void CZ101AudioProcessor::applyVoiceAutomation(float blockFraction) noexcept
+{
+    using Automated = CZ101::Core::ParameterAutomation;
+    const auto at = [&](Automated::Param p) { return automation[p].at(blockFraction); };
+    
+    // Voice Filters use Macro Brilliance (Output LPF handled in EffectsChain)
+    voiceManager.setFilterCutoff(juce::jlimit(20.0f, 20000.0f, at(Automated::LpfCutoff) + brillianceCutoffOffset(at(Automated::MacroBrilliance))));
+    voiceManager.setFilterResonance(at(Automated::LpfReso));
+    voiceManager.setHPF(at(Automated::HpfCutoff));
+    voiceManager.setMasterVolume(at(Automated::MasterVolume));
+    voiceManager.setLFOFrequency(at(Automated::LfoRate));
+    voiceManager.setVibratoDepth(at(Automated::LfoDepth));
+}
+
+// Audio thread: automated parameters follow a program / SysEx patch while it overrides the pool
+void CZ101AudioProcessor::holdAutomationAt(const CZ101::Core::ParameterSnapshot& snapshot) noexcept
+{
+    using Automated = CZ101::Core::ParameterAutomation;
+    automation.hold(Automated::MasterVolume, snapshot.system.masterVol);
+    automation.hold(Automated::LpfCutoff, snapshot.effects.lpfCutoff);
+    automation.hold(Automated::LpfReso, snapshot.effects.lpfReso);
+    automation.hold(Automated::HpfCutoff, snapshot.effects.hpfCutoff);
+    automation.hold(Automated::LfoRate, snapshot.lfo.rate);
+    automation.hold(Automated::LfoDepth, snapshot.lfo.depth);
+    automation.hold(Automated::ChorusRate, snapshot.effects.chorusRate);
+    automation.hold(Automated::ChorusDepth, snapshot.effects.chorusDepth);
+    automation.hold(Automated::ChorusMix, snapshot.effects.chorusMix);
+    automation.hold(Automated::DelayFeedback, snapshot.effects.delayFb);
+    automation.hold(Automated::DelayMix, snapshot.effects.delayMix);
+    automation.hold(Automated::ReverbSize, snapshot.effects.reverbSize);
+    automation.hold(Automated::ReverbMix, snapshot.effects.reverbMix);
+    automation.hold(Automated::DriveAmount, snapshot.effects.driveAmount);
+    automation.hold(Automated::DriveColor, snapshot.effects.driveColor);
+    automation.hold(Automated::DriveMix, snapshot.effects.driveMix);
+    // MacroBrilliance is a performance control no patch stores: it keeps following the host
 }
 
 void CZ101AudioProcessor::updateOscillators(const MacroValues& m)
@@ -627,19 +802,27 @@ void CZ101AudioProcessor::updateEffects(const MacroValues& m)
     
     // Calculate Latency (Message Thread logic)
     // We can access parameters directly since we are on the Message Thread (or Async update)
-    float cMix = parameters.getChorusMix() ? parameters.getChorusMix()->get() : 0.0f;
-    float dMix = parameters.getDelayMix() ? parameters.getDelayMix()->get() : 0.0f;
-    float dTime = parameters.getDelayTime() ? parameters.getDelayTime()->get() : 0.25f;
+    using P = CZ101::ParameterIDs::Index;
+    float cMix = parameters.getRaw(P::chorusMix);
+    float dMix = parameters.getRaw(P::delayMix);
+    float dTime = parameters.getRaw(P::delayTime);
     
     int chorusDelaySamples = (cMix > 0.0f) ? (int)(0.025 * getSampleRate()) : 0;
     int delaySamples = (dMix > 0.0f) ? (int)(dTime * getSampleRate()) : 0;
     int latency = chorusDelaySamples + (delaySamples > 0 ? 1 : 0); 
+    
+    // Phase 5.1: Half-band decimator group delay (same chain in PerVoice and MixBus modes)
+    const int osChoice = parameters.getRawInt(P::oversampling);
+    latency += juce::roundToInt(CZ101::DSP::OversamplingDecimator::getLatencySamples(oversamplingFactorForChoice(osChoice)));
     if (getLatencySamples() != latency) setLatencySamples(latency);
 }
 
 void CZ101AudioProcessor::updateSystemGlobal()
 {
     // Snapshot logic moved to updateParameters
+    // SysEx reception follows the front-panel switches (PROTECT off + MIDI PGM on)
+    using P = CZ101::ParameterIDs::Index;
+    sysExManager.setProtectionState(parameters.getRawBool(P::protectSwitch), parameters.getRawBool(P::systemPrg));
 }
 
 void CZ101AudioProcessor::updateArpeggiator()
@@ -647,106 +830,140 @@ void CZ101AudioProcessor::updateArpeggiator()
     // Snapshot logic moved to updateParameters
 }
 
+// Arp clock follows the host transport; without a play head (or PPQ) it free-runs at the last tempo
+void CZ101AudioProcessor::syncArpeggiatorToHost() noexcept
+{
+    auto& arpeggiator = voiceManager.getArpeggiator();
+    auto* playHead = getPlayHead();
+    const auto position = playHead != nullptr ? playHead->getPosition() : juce::Optional<juce::AudioPlayHead::PositionInfo>();
+    if (!position.hasValue())
+    {
+        arpeggiator.clearHostSync();
+        return;
+    }
+
+    CZ101::DSP::Arpeggiator::HostPosition host;
+    host.bpm = arpeggiator.getTempo();
+    if (const auto bpm = position->getBpm())
+        host.bpm = *bpm;
+    if (const auto ppq = position->getPpqPosition())
+    {
+        host.ppqPosition = *ppq;
+        host.isPlaying = position->getIsPlaying();
+    }
+    if (const auto loop = position->getLoopPoints())
+    {
+        host.isLooping = position->getIsLooping();
+        host.loopStartPpq = loop->ppqStart;
+        host.loopEndPpq = loop->ppqEnd;
+    }
+
+    arpeggiator.syncToHost(host);
+}
+
 // Phase 7: Snapshot Builder Implementation
-std::unique_ptr<CZ101::Core::ParameterSnapshot> CZ101AudioProcessor::buildAudioSnapshot()
+template <typename ValueSource>
+CZ101::Core::ParameterSnapshot CZ101AudioProcessor::buildSnapshot(ValueSource&& getVal) const
 {
-    auto snap = std::make_unique<CZ101::Core::ParameterSnapshot>();
+    CZ101::Core::ParameterSnapshot snap;
     
-    // Helper lambda for safe param access
-    auto getVal = [](juce::AudioParameterFloat* p, float def = 0.0f) { return p ? p->get() : def; };
-    auto getInt = [](juce::AudioParameterChoice* p, int def = 0) { return p ? p->getIndex() : def; };
-    auto getIntParam = [](juce::AudioParameterInt* p, int def = 0) { return p ? p->get() : def; };
-    auto getBool = [](juce::AudioParameterBool* p, bool def = false) { return p ? p->get() : def; };
+    // getVal returns parameter units: choice index / int value / 0-1 for bools
+    using P = CZ101::ParameterIDs::Index;
+    auto getInt = [&getVal](P p) { return juce::roundToInt(getVal(p)); };
+    auto getBool = [&getVal](P p) { return getVal(p) >= 0.5f; };
 
     // DCO 1
-    snap->dco1.wave1 = getInt(parameters.getOsc1Waveform());
-    snap->dco1.wave2 = parameters.getOsc1Waveform2() ? (getInt(parameters.getOsc1Waveform2()) == 0 ? 8 : getInt(parameters.getOsc1Waveform2()) - 1) : 8;
-    snap->dco1.level = getVal(parameters.getOsc1Level());
+    snap.dco1.wave1 = getInt(P::osc1Waveform);
+    snap.dco1.wave2 = getInt(P::osc1Waveform2) == 0 ? 8 : getInt(P::osc1Waveform2) - 1;
+    snap.dco1.level = getVal(P::osc1Level);
 
     // DCO 2
-    snap->dco2.wave1 = getInt(parameters.getOsc2Waveform());
-    snap->dco2.wave2 = parameters.getOsc2Waveform2() ? (getInt(parameters.getOsc2Waveform2()) == 0 ? 8 : getInt(parameters.getOsc2Waveform2()) - 1) : 8;
-    snap->dco2.level = getVal(parameters.getOsc2Level());
-    snap->dco2.octave = getIntParam(parameters.getDetuneOctave()); 
-    snap->dco2.coarse = getIntParam(parameters.getDetuneCoarse());
-    snap->dco2.fine = getIntParam(parameters.getDetuneFine());
+    snap.dco2.wave1 = getInt(P::osc2Waveform);
+    snap.dco2.wave2 = getInt(P::osc2Waveform2) == 0 ? 8 : getInt(P::osc2Waveform2) - 1;
+    snap.dco2.level = getVal(P::osc2Level);
+    snap.dco2.octave = getInt(P::detuneOct); 
+    snap.dco2.coarse = getInt(P::detuneCoarse);
+    snap.dco2.fine = getInt(P::detuneFine);
 
     // 1+1 Logic (Line Select = 2)
-    int lineSel = parameters.getLineSelect() ? getInt(parameters.getLineSelect()) : 2;
+    int lineSel = getInt(P::lineSelect);
     if (lineSel == 2) {
-         snap->dco2.wave1 = snap->dco1.wave1;
-         snap->dco2.wave2 = snap->dco1.wave2;
-         snap->dco2.level = snap->dco1.level;
+         snap.dco2.wave1 = snap.dco1.wave1;
+         snap.dco2.wave2 = snap.dco1.wave2;
+         snap.dco2.level = snap.dco1.level;
     }
-    if (lineSel == 0) snap->dco2.level = 0.0f;
-    if (lineSel == 1) snap->dco1.level = 0.0f;
+    // Single-line patches: the voice renders only the selected line (and the voice limit doubles)
+    snap.lineSelect = lineSel;
+    if (lineSel == 0) snap.dco2.level = 0.0f;
+    if (lineSel == 1) snap.dco1.level = 0.0f;
 
     // Line Mod
-    snap->lineMod.ring = getBool(parameters.getRingMod());
-    snap->lineMod.noise = parameters.getNoiseMod() ? getBool(parameters.getNoiseMod()) : false;
+    snap.lineMod.ring = getBool(P::ringMod);
+    snap.lineMod.noise = getBool(P::noiseMod);
 
     // System
-    snap->system.masterVol = getVal(parameters.getMasterVolume(), 1.0f);
-    snap->system.masterTune = 0.0f; 
-    snap->system.bendRange = 2.0f; 
+    snap.system.masterVol = getVal(P::masterVolume);
+    snap.system.masterTune = 0.0f; 
+    snap.system.bendRange = 2.0f; 
     
     // Op Mode & Limits
-    snap->system.opMode = getInt(parameters.getOperationMode());
-    snap->system.voiceLimit = (snap->system.opMode == 2) ? 16 : (snap->system.opMode == 0 ? 4 : 8);
-    snap->system.hardwareNoise = getBool(parameters.getHardwareNoise()); // Audit Fix: Corrected name
-    snap->system.oversampling = getInt(parameters.getOversamplingQuality()); 
-    snap->system.oversampling = (snap->system.oversampling == 0) ? 1 : (snap->system.oversampling == 1 ? 2 : 4);
+    snap.system.opMode = getInt(P::operationMode);
+    snap.system.voiceLimit = (snap.system.opMode == 2) ? CZ101::Core::VoiceManager::MAX_VOICES : (snap.system.opMode == 0 ? 4 : 8);
+    snap.system.hardwareNoise = getBool(P::hardwareNoise); // Audit Fix: Corrected name
+    const int osChoice = getInt(P::oversampling);
+    snap.system.oversampling = oversamplingFactorForChoice(osChoice);
+    snap.system.oversamplingMixBus = isMixBusOversamplingChoice(osChoice);
     
-    if (parameters.getMidiChannel()) snap->system.midiChannel = getIntParam(parameters.getMidiChannel());
+    snap.system.midiChannel = getInt(P::midiChannel);
 
     // Mod Matrix
-    snap->mod.veloDcw = getVal(parameters.getModVeloToDcw());
-    snap->mod.veloAmp = getVal(parameters.getModVeloToDca());
-    snap->mod.wheelToDcw = getVal(parameters.getModWheelToDcw());
-    snap->mod.wheelToLfoRate = getVal(parameters.getModWheelToLfoRate());
-    snap->mod.wheelToVibrato = getVal(parameters.getModWheelToVibrato());
-    snap->mod.atToDcw = getVal(parameters.getModAtToDcw());
-    snap->mod.atToVibrato = getVal(parameters.getModAtToVibrato());
-    
-    snap->mod.keyFollowDcw = getInt(parameters.getKeyFollowDcw());
-    snap->mod.keyFollowAmp = getInt(parameters.getKeyFollowDca());
-    snap->mod.keyFollowDco = getInt(parameters.getKeyFollowDco()); 
-    snap->mod.detune = getBool(parameters.getHardSync()) ? 1 : 0; 
-    snap->mod.glideTime = getVal(parameters.getGlideTime());
+    snap.mod.veloDcw = getVal(P::modVeloDcw);
+    snap.mod.veloAmp = getVal(P::modVeloDca);
+    snap.mod.wheelToDcw = getVal(P::modWheelDcw);
+    snap.mod.wheelToLfoRate = getVal(P::modWheelLfoRate);
+    snap.mod.wheelToVibrato = getVal(P::modWheelVib);
+    snap.mod.atToDcw = getVal(P::modAtDcw);
+    snap.mod.atToVibrato = getVal(P::modAtVib);
+    
+    snap.mod.keyFollowDcw = getInt(P::keyFollowDcw);
+    snap.mod.keyFollowAmp = getInt(P::keyFollowDca);
+    snap.mod.keyFollowDco = getInt(P::keyFollowDco); 
+    snap.mod.detune = getBool(P::hardSync) ? 1 : 0; 
+    snap.mod.glideTime = getVal(P::glideTime);
 
     // LFO
-    snap->lfo.rate = getVal(parameters.getLfoRate(), 1.0f);
-    snap->lfo.waveform = getInt(parameters.getLfoWaveform());
-    snap->lfo.depth = getVal(parameters.getLfoDepth());
-    snap->lfo.delay = getVal(parameters.getLfoDelay());
+    snap.lfo.rate = getVal(P::lfoRate);
+    snap.lfo.waveform = getInt(P::lfoWaveform);
+    snap.lfo.depth = getVal(P::lfoDepth);
+    snap.lfo.delay = getVal(P::lfoDelay);
 
     // Arp
-    snap->arp.enabled = getBool(parameters.getArpEnabled()) && (snap->system.opMode != 0);
-    snap->arp.latch = getBool(parameters.getArpLatch());
-    snap->arp.rate = getInt(parameters.getArpRate());
-    snap->arp.pattern = getInt(parameters.getArpPattern());
-    snap->arp.octave = getIntParam(parameters.getArpOctave()) + 1; // Audit Fix: getIntParam
-    snap->arp.gate = getVal(parameters.getArpGate(), 1.0f);
-    snap->arp.swing = getVal(parameters.getArpSwing(), 0.0f);
-    snap->arp.swingMode = getInt(parameters.getArpSwingMode(), 0);
+    snap.arp.enabled = getBool(P::arpEnabled) && (snap.system.opMode != 0);
+    snap.arp.latch = getBool(P::arpLatch);
+    snap.arp.rate = getInt(P::arpRate);
+    snap.arp.pattern = getInt(P::arpPattern);
+    snap.arp.octave = getInt(P::arpOctave) + 1; // Audit Fix: integer parameter
+    snap.arp.gate = getVal(P::arpGate);
+    snap.arp.swing = getVal(P::arpSwing);
+    snap.arp.swingMode = getInt(P::arpSwingMode);
 
     // Effects
-    snap->effects.chorusOn = true;
-    snap->effects.chorusRate = getVal(parameters.getChorusRate());
-    snap->effects.chorusDepth = getVal(parameters.getChorusDepth());
-    snap->effects.chorusMix = getVal(parameters.getChorusMix());
+    snap.effects.chorusOn = true;
+    snap.effects.chorusRate = getVal(P::chorusRate);
+    snap.effects.chorusDepth = getVal(P::chorusDepth);
+    snap.effects.chorusMix = getVal(P::chorusMix);
 
-    snap->effects.delayTime = getVal(parameters.getDelayTime(), 0.25f);
-    snap->effects.delayFb = getVal(parameters.getDelayFeedback());
-    snap->effects.delayMix = getVal(parameters.getDelayMix());
+    snap.effects.delayTime = getVal(P::delayTime);
+    snap.effects.delayFb = getVal(P::delayFeedback);
+    snap.effects.delayMix = getVal(P::delayMix);
     
-    snap->effects.reverbSize = getVal(parameters.getReverbSize(), 0.5f);
-    snap->effects.reverbMix = getVal(parameters.getReverbMix());
+    snap.effects.reverbSize = getVal(P::reverbSize);
+    snap.effects.reverbMix = getVal(P::reverbMix);
 
     // [NEW] Drive
-    snap->effects.driveAmount = getVal(parameters.getDriveAmount());
-    snap->effects.driveColor = getVal(parameters.getDriveColor(), 0.5f);
-    snap->effects.driveMix = getVal(parameters.getDriveMix());
+    snap.effects.driveAmount = getVal(P::driveAmount);
+    snap.effects.driveColor = getVal(P::driveColor);
+    snap.effects.driveMix = getVal(P::driveMix);
 
     // [NEW] Modern Filters
     // These only affect the output filter (EffectsChain). Voice filters are handled in updateFilters via setNonRealtime?
@@ -754,34 +971,128 @@ std::unique_ptr<CZ101::Core::ParameterSnapshot> CZ101AudioProcessor::buildAudioS
     // Wait, updateFilters calls voiceManager.setFilterCutoff directly. 
     // VoiceManager inside processBlock uses these values.
     // So we just need to populate the snapshot for EffectsChain here.
-    snap->effects.lpfCutoff = getVal(parameters.getModernLpfCutoff(), 20000.0f);
-    snap->effects.lpfReso = getVal(parameters.getModernLpfReso(), 0.0f);
-    snap->effects.hpfCutoff = getVal(parameters.getModernHpfCutoff(), 20.0f);
+    snap.effects.lpfCutoff = getVal(P::lpfCutoff);
+    snap.effects.lpfReso = getVal(P::lpfReso);
+    snap.effects.hpfCutoff = getVal(P::hpfCutoff);
 
     // Envelopes (Calculated from ADSR Macros)
     double sr = currentSampleRate.load();
-    auto* envs = &snap->envelopes;
+    auto* envs = &snap.envelopes;
     
     // Convert Macros directly to Snapshot format
     ::CZ101::State::EnvelopeSerializer::convertADSRToSnapshot(
-        getVal(parameters.getDcwAttack()), getVal(parameters.getDcwDecay()),
-        getVal(parameters.getDcwSustain(), 1.0f), getVal(parameters.getDcwRelease()),
+        getVal(P::dcwAttack), getVal(P::dcwDecay),
+        getVal(P::dcwSustain), getVal(P::dcwRelease),
         envs->dcw1, sr);
     envs->dcw2 = envs->dcw1; 
 
     ::CZ101::State::EnvelopeSerializer::convertADSRToSnapshot(
-        getVal(parameters.getDcaAttack()), getVal(parameters.getDcaDecay()),
-        getVal(parameters.getDcaSustain(), 1.0f), getVal(parameters.getDcaRelease()),
+        getVal(P::dcaAttack), getVal(P::dcaDecay),
+        getVal(P::dcaSustain), getVal(P::dcaRelease),
         envs->dca1, sr);
     envs->dca2 = envs->dca1; 
     
-    // Pitch Envelope: Retrieve from PresetManager to preserve loaded state (Macros don't control Pitch yet)
+    return snap;
+}
+
+CZ101::Core::ParameterSnapshot CZ101AudioProcessor::buildAudioSnapshot()
+{
+    // Cached value handles: one atomic load per parameter, no string lookups
+    auto snap = buildSnapshot([this](CZ101::ParameterIDs::Index p) { return parameters.getRaw(p); });
+    
+    // Pitch Envelope: Retrieve from PresetManager to preserve loaded state (Macros don't control Pitch yet).
+    // DCW/DCA too for a patch without macros, until the user moves one of the (then unrelated) macros.
     {
         const juce::ScopedReadLock srl(presetManager.getLock());
         const auto& currentPreset = presetManager.getCurrentPreset();
-        ::CZ101::State::EnvelopeSerializer::copyToSnapshot(currentPreset.pitchEnv, snap->envelopes.pitch1);
-        ::CZ101::State::EnvelopeSerializer::copyToSnapshot(currentPreset.pitchEnv2, snap->envelopes.pitch2);
+        
+        std::array<float, 8> macros {};
+        for (size_t i = 0; i < 4; ++i)
+        {
+            macros[i] = parameters.getRaw(DCW_MACROS[i]);
+            macros[i + 4] = parameters.getRaw(DCA_MACROS[i]);
+        }
+        if (presetManager.getCurrentPresetSerial() != stageEnvelopePresetSerial)
+        {
+            stageEnvelopePresetSerial = presetManager.getCurrentPresetSerial();
+            stageEnvelopeMacros = macros;
+            dcwMacrosMoved = dcaMacrosMoved = false;
+        }
+        dcwMacrosMoved = dcwMacrosMoved || !std::equal(macros.begin(), macros.begin() + 4, stageEnvelopeMacros.begin());
+        dcaMacrosMoved = dcaMacrosMoved || !std::equal(macros.begin() + 4, macros.end(), stageEnvelopeMacros.begin() + 4);
+        
+        copyPresetEnvelopes(currentPreset, snap,
+                            !dcwMacrosMoved && storesNone(currentPreset.parameters, DCW_MACROS),
+                            !dcaMacrosMoved && storesNone(currentPreset.parameters, DCA_MACROS));
     }
     
     return snap;
 }
+
+CZ101::Core::ParameterSnapshot CZ101AudioProcessor::buildProgramSnapshot(const CZ101::State::Preset& preset) const
+{
+    // What buildAudioSnapshot will see once loadPreset has applied this preset: parameters
+    // the preset does not store keep their current value, as applyPresetToProcessor leaves them
+    auto snap = buildSnapshot([this, &preset](CZ101::ParameterIDs::Index p) { return preset.parameters.get(p, parameters.getRaw(p)); });
+    copyPresetEnvelopes(preset, snap, storesNone(preset.parameters, DCW_MACROS), storesNone(preset.parameters, DCA_MACROS));
+    return snap;
+}
+
+// --- REAL-TIME PROGRAM CHANGE ---
+void CZ101AudioProcessor::publishProgramBank()
+{
+    std::vector<CZ101::State::Preset> programs;
+    {
+        const juce::ScopedReadLock srl(presetManager.getLock());
+        programs = presetManager.getPresets();
+    }
+    programBank.publish(std::move(programs));
+}
+
+void CZ101AudioProcessor::bankUpdated()
+{
+    publishProgramBank();
+}
+
+void CZ101AudioProcessor::applyOverridePatch(const CZ101::State::Preset& patch) noexcept
+{
+    // Audio thread, at the event's sample: the voices switch now, the message thread catches up.
+    // Built here rather than ahead, so unstored parameters (operation mode, oversampling, arp,
+    // effects...) take their live values. Alternating slots keep the pointer different from
+    // the one VoiceManager applied last, and the version makes the next pool snapshot apply in full.
+    auto& snapshot = overrideSnapshots[nextOverrideSnapshot];
+    nextOverrideSnapshot ^= 1u;
+    snapshot = buildProgramSnapshot(patch);
+    snapshot.version = CZ101::Core::ParameterSnapshot::OVERRIDE_VERSION;
+    snapshot.dirtySections = CZ101::Core::ParameterSnapshot::AllSections;
+    
+    snapshotOverride = &snapshot;
+    activeOverrideSerial = overrideSerials.fetch_add(1) + 1;
+    voiceManager.applySnapshot(&snapshot);
+    holdAutomationAt(snapshot); // The rest of the block's automation segments
+}
+
+void CZ101AudioProcessor::applyProgramChange(int program) noexcept
+{
+    const auto* patch = programBank.find(program);
+    if (patch == nullptr) return;
+    
+    applyOverridePatch(*patch);
+    requestedProgram.store((static_cast<uint64_t>(activeOverrideSerial) << 32) | static_cast<uint32_t>(program));
+    triggerAsyncUpdate();
+}
+
+void CZ101AudioProcessor::applySysExPatch(const CZ101::State::Preset& patch) noexcept
+{
+    applyOverridePatch(patch);
+    
+    // Latest wins: if the message thread has not picked up the previous patch, this one replaces it
+    auto& pod = sysExMailbox.slots[static_cast<size_t>(sysExMailbox.backIndex)];
+    pod.parameters = patch.parameters;
+    pod.pitchEnv = patch.pitchEnv;   pod.dcwEnv = patch.dcwEnv;   pod.dcaEnv = patch.dcaEnv;
+    pod.pitchEnv2 = patch.pitchEnv2; pod.dcwEnv2 = patch.dcwEnv2; pod.dcaEnv2 = patch.dcaEnv2;
+    pod.serial = activeOverrideSerial;
+    sysExMailbox.backIndex = sysExMailbox.midIndex.exchange(sysExMailbox.backIndex | SysExPatchMailbox::FRESH, std::memory_order_acq_rel)
+                           & ~SysExPatchMailbox::FRESH;
+    triggerAsyncUpdate();
+}
@@ -18,6 +18,8 @@
 #include <juce_dsp/juce_dsp.h> // Required for LadderFilter
 #include "DSP/Modulation/LFO.h"
 #include "Core/AudioThreadSnapshot.h"
+#include "Core/ProgramBank.h"
+#include "Core/ParameterAutomation.h"
 // #include "UI/LCDStateManager.h" // Removed to prevent circular dependency
 namespace CZ101 { namespace UI { class LCDStateManager; } }
 
@@ -46,9 +48,21 @@ struct EnvelopeStatePOD
 static_assert(std::is_trivially_copyable<EnvelopeUpdateCommand>::value, "EnvelopeUpdateCommand must be POD for thread-safe FIFO usage");
 static_assert(std::is_trivially_copyable<EnvelopeStatePOD>::value, "EnvelopeStatePOD must be POD for thread-safe FIFO usage");
 
+// Real-time SysEx swap: a patch the audio thread switched to, for the message thread to commit
+struct SysExPatchPOD
+{
+    CZ101::State::PresetParameters parameters;
+    CZ101::State::EnvelopeData pitchEnv, dcwEnv, dcaEnv;
+    CZ101::State::EnvelopeData pitchEnv2, dcwEnv2, dcaEnv2;
+    uint32_t serial = 0; // Orders it against Program Changes
+};
+
+static_assert(std::is_trivially_copyable<SysExPatchPOD>::value, "SysExPatchPOD must be POD for thread-safe FIFO usage");
+
 class CZ101AudioProcessor : public juce::AudioProcessor, 
                             public juce::AsyncUpdater,
-                            public juce::AudioProcessorValueTreeState::Listener
+                            public juce::AudioProcessorValueTreeState::Listener,
+                            public CZ101::State::PresetManager::Listener
 {
 public:
     CZ101AudioProcessor();
@@ -139,8 +153,47 @@ private:
     
     CZ101::Core::AudioThreadSnapshot audioSnapshot;
     
-    // Phase 7: Snapshot Builder
-    std::unique_ptr<CZ101::Core::ParameterSnapshot> buildAudioSnapshot();
+    // Phase 7: Snapshot Builder (by value: commit copies it into the snapshot pool)
+    CZ101::Core::ParameterSnapshot buildAudioSnapshot();
+    uint32_t stageEnvelopePresetSerial = 0;        // Message thread: preset the macros below were read for
+    std::array<float, 8> stageEnvelopeMacros {};   // DCW then DCA ADSR macros as that preset left them
+    bool dcwMacrosMoved = false, dcaMacrosMoved = false; // Since then: the macros win over its 8-stage envelopes
+    CZ101::Core::ParameterSnapshot buildProgramSnapshot(const CZ101::State::Preset& preset) const;
+    template <typename ValueSource>
+    CZ101::Core::ParameterSnapshot buildSnapshot(ValueSource&& getVal) const;
+    
+    // Real-time Program Change / SysEx patch: swapped in on the audio thread, used instead of the
+    // pool snapshot until the message thread has loaded the same patch and committed it
+    CZ101::Core::BasicProgramBank<CZ101::State::Preset> programBank;
+    const CZ101::Core::ParameterSnapshot* snapshotOverride = nullptr; // Audio thread
+    uint32_t activeOverrideSerial = 0;                                // Audio thread: serial of snapshotOverride
+    std::atomic<uint32_t> overrideSerials { 0 };                      // Next serial - 1 (any thread)
+    std::atomic<uint32_t> caughtUpOverrideSerial { 0 };               // Newest serial the pool has caught up with
+    uint32_t handledProgramSerial = 0;                                // Message thread
+    std::atomic<uint64_t> requestedProgram { 0 };                     // serial << 32 | program
+    std::array<CZ101::Core::ParameterSnapshot, 2> overrideSnapshots {}; // Audio thread: the applied patch
+    uint32_t nextOverrideSnapshot = 0;
+    // Latest-wins triple buffer (audio -> message thread): a patch not picked up yet is
+    // overwritten by the next one, so the newest dump always reaches APVTS
+    struct SysExPatchMailbox {
+        static constexpr int FRESH = 4; // Flag in midIndex: the slot there has not been read
+        std::array<SysExPatchPOD, 3> slots {};
+        int backIndex = 0;               // Audio thread
+        std::atomic<int> midIndex { 1 }; // Shared
+        int frontIndex = 2;              // Message thread
+    };
+    SysExPatchMailbox sysExMailbox;
+    void publishProgramBank();
+    void applyOverridePatch(const CZ101::State::Preset& patch) noexcept;
+    void applyProgramChange(int program) noexcept;
+    void applySysExPatch(const CZ101::State::Preset& patch) noexcept;
+    void bankUpdated() override; // PresetManager::Listener
+    
+    // Continuous parameters: host automation read on the audio thread, ramped per block
+    CZ101::Core::ParameterAutomation automation;
+    void bindAutomation();
+    void applyVoiceAutomation(float blockFraction) noexcept;
+    void holdAutomationAt(const CZ101::Core::ParameterSnapshot& snapshot) noexcept;
     
 
 
@@ -177,15 +230,6 @@ private:
     
     // Audit Fix [D]: Mutex ELIMINATED. Using lock-free patterns.
     
-    // Audit Fix 4.2: Pending update from SysEx
-    juce::CriticalSection sysExLock; // Protects the pendingSysExPreset unique_ptr
-    std::unique_ptr<CZ101::State::Preset> pendingSysExPreset;
-    std::atomic<bool> hasPendingSysEx { false };    
-
-    // Audit Fix: Lock-free POD Swap for audio thread
-    static constexpr int PRESET_FIFO_SIZE = 4;
-    juce::AbstractFifo presetFifo { PRESET_FIFO_SIZE };
-    std::array<EnvelopeStatePOD, PRESET_FIFO_SIZE> presetBuffer;
     std::atomic<double> currentSampleRate { 44100.0 };
     
     // Audit Fix: Performance optimization
@@ -238,6 +282,7 @@ private:
     void updateModMatrix();
     void updateEffects(const MacroValues& macros);
     void updateArpeggiator();
+    void syncArpeggiatorToHost() noexcept; // Audio thread: AudioPlayHead -> arp clock
     void updateSystemGlobal(); // Hardware model, protection, etc.
 
     std::unique_ptr<juce::FileLogger> fileLogger;
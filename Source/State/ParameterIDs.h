@@ -1,104 +1,136 @@
 #pragma once
 
 #include <juce_core/juce_core.h>
+#include <array>
+
+/**
+ * Every APVTS parameter: X(name, "ID"). Expanded below into the string IDs
+ * (ParameterIDs::name), the dense index (ParameterIDs::Index::name) and the
+ * index -> ID table, so the three can never disagree.
+ */
+#define CZ101_PARAMETER_IDS(X) \
+    /* --- Oscillators --- */                  \
+    X(lineSelect,      "LINE_SELECT")          \
+    X(osc1Waveform,    "OSC1_WAVEFORM")        \
+    X(osc1Waveform2,   "OSC1_WAVEFORM2")       \
+    X(osc1Level,       "OSC1_LEVEL")           \
+    X(osc2Waveform,    "OSC2_WAVEFORM")        \
+    X(osc2Waveform2,   "OSC2_WAVEFORM2")       \
+    X(osc2Level,       "OSC2_LEVEL")           \
+    X(osc2Detune,      "OSC2_DETUNE")          \
+    X(detuneOct,       "DETUNE_OCT")           \
+    X(detuneCoarse,    "DETUNE_COARSE")        \
+    X(detuneFine,      "DETUNE_FINE")          \
+    X(lineMix,         "LINE_MIX")             \
+    X(hardSync,        "HARD_SYNC")            \
+    X(ringMod,         "RING_MOD")             \
+    X(noiseMod,        "NOISE_MOD")            \
+    X(glideTime,       "GLIDE")                \
+    /* --- LFO / Vibrato --- */                \
+    X(lfoWaveform,     "LFO_WAVE")             \
+    X(lfoRate,         "LFO_RATE")             \
+    X(lfoDepth,        "LFO_DEPTH")            \
+    X(lfoDelay,        "LFO_DELAY")            \
+    /* --- Envelopes (DCA/DCW) --- */          \
+    X(dcaAttack,       "DCA_ATTACK")           \
+    X(dcaDecay,        "DCA_DECAY")            \
+    X(dcaSustain,      "DCA_SUSTAIN")          \
+    X(dcaRelease,      "DCA_RELEASE")          \
+    X(dcwAttack,       "DCW_ATTACK")           \
+    X(dcwDecay,        "DCW_DECAY")            \
+    X(dcwSustain,      "DCW_SUSTAIN")          \
+    X(dcwRelease,      "DCW_RELEASE")          \
+    /* --- Modulation Matrix --- */            \
+    X(modVeloDcw,      "MOD_VELO_DCW")         \
+    X(modVeloDca,      "MOD_VELO_DCA")         \
+    X(modWheelDcw,     "MOD_WHEEL_DCW")        \
+    X(modWheelLfoRate, "MOD_WHEEL_LFORATE")    \
+    X(modWheelVib,     "MOD_WHEEL_VIB")        \
+    X(modAtDcw,        "MOD_AT_DCW")           \
+    X(modAtVib,        "MOD_AT_VIB")           \
+    X(keyTrackDcw,     "KEY_TRACK_DCW")        \
+    X(keyTrackPitch,   "KEY_TRACK_PITCH")      \
+    X(keyFollowDco,    "KEY_FOLLOW_DCO")       \
+    X(keyFollowDcw,    "KEY_FOLLOW_DCW")       \
+    X(keyFollowDca,    "KEY_FOLLOW_DCA")       \
+    /* --- Modern Filters --- */               \
+    X(lpfCutoff,       "MODERN_LPF_CUTOFF")    \
+    X(lpfReso,         "MODERN_LPF_RESO")      \
+    X(hpfCutoff,       "MODERN_HPF_CUTOFF")    \
+    /* --- Effects --- */                      \
+    X(driveAmount,     "DRIVE_AMOUNT")         \
+    X(driveColor,      "DRIVE_COLOR")          \
+    X(driveMix,        "DRIVE_MIX")            \
+    X(chorusRate,      "CHORUS_RATE")          \
+    X(chorusDepth,     "CHORUS_DEPTH")         \
+    X(chorusMix,       "CHORUS_MIX")           \
+    X(delayTime,       "DELAY_TIME")           \
+    X(delayFeedback,   "DELAY_FEEDBACK")       \
+    X(delayMix,        "DELAY_MIX")            \
+    X(reverbSize,      "REVERB_SIZE")          \
+    X(reverbMix,       "REVERB_MIX")           \
+    /* --- System --- */                       \
+    X(protectSwitch,   "PROTECT_SWITCH")       \
+    X(systemPrg,       "SYSTEM_PRG")           \
+    X(bypass,          "BYPASS")               \
+    X(operationMode,   "OPERATION_MODE")       \
+    X(masterVolume,    "MASTER_VOLUME")        \
+    X(midiChannel,     "MIDI_CH")              \
+    X(masterTune,      "MASTER_TUNE")          \
+    X(benderRange,     "PITCH_BEND_RANGE")     \
+    X(transpose,       "KEY_TRANSPOSE")        \
+    X(oversampling,    "OVERSAMPLING_QUALITY") \
+    X(hardwareNoise,   "HARDWARE_NOISE")       \
+    /* --- Arpeggiator --- */                  \
+    X(arpEnabled,      "ARP_ENABLED")          \
+    X(arpLatch,        "ARP_LATCH")            \
+    X(arpRate,         "ARP_RATE")             \
+    X(arpBpm,          "ARP_BPM")              \
+    X(arpGate,         "ARP_GATE")             \
+    X(arpSwing,        "ARP_SWING")            \
+    X(arpSwingMode,    "ARP_SWING_MODE")       \
+    X(arpPattern,      "ARP_PATTERN")          \
+    X(arpOctave,       "ARP_OCTAVE")           \
+    /* --- Performance Macros --- */           \
+    X(macroBrilliance, "MACRO_BRILLIANCE")     \
+    X(macroTone,       "MACRO_TONE")           \
+    X(macroSpace,      "MACRO_SPACE")
 
 namespace CZ101 {
 namespace ParameterIDs {
 
-    // --- Oscillators ---
-    inline const juce::String lineSelect     { "LINE_SELECT" };
-    inline const juce::String osc1Waveform   { "OSC1_WAVEFORM" };
-    inline const juce::String osc1Waveform2  { "OSC1_WAVEFORM2" };
-    inline const juce::String osc1Level      { "OSC1_LEVEL" };
-    inline const juce::String osc2Waveform   { "OSC2_WAVEFORM" };
-    inline const juce::String osc2Waveform2  { "OSC2_WAVEFORM2" };
-    inline const juce::String osc2Level      { "OSC2_LEVEL" };
-    inline const juce::String osc2Detune     { "OSC2_DETUNE" };
-    inline const juce::String detuneOct      { "DETUNE_OCT" };
-    inline const juce::String detuneCoarse   { "DETUNE_COARSE" };
-    inline const juce::String detuneFine     { "DETUNE_FINE" };
-    inline const juce::String lineMix        { "LINE_MIX" };
-    inline const juce::String hardSync       { "HARD_SYNC" };
-    inline const juce::String ringMod        { "RING_MOD" };
-    inline const juce::String noiseMod       { "NOISE_MOD" };
-    inline const juce::String glideTime      { "GLIDE" };
-
-    // --- LFO / Vibrato ---
-    inline const juce::String lfoWaveform    { "LFO_WAVE" };
-    inline const juce::String lfoRate        { "LFO_RATE" };
-    inline const juce::String lfoDepth       { "LFO_DEPTH" };
-    inline const juce::String lfoDelay       { "LFO_DELAY" };
-
-    // --- Envelopes (DCA/DCW) ---
-    inline const juce::String dcaAttack      { "DCA_ATTACK" };
-    inline const juce::String dcaDecay       { "DCA_DECAY" };
-    inline const juce::String dcaSustain     { "DCA_SUSTAIN" };
-    inline const juce::String dcaRelease     { "DCA_RELEASE" };
-    inline const juce::String dcwAttack      { "DCW_ATTACK" };
-    inline const juce::String dcwDecay       { "DCW_DECAY" };
-    inline const juce::String dcwSustain     { "DCW_SUSTAIN" };
-    inline const juce::String dcwRelease     { "DCW_RELEASE" };
-
-    // --- Modulation Matrix ---
-    inline const juce::String modVeloDcw      { "MOD_VELO_DCW" };
-    inline const juce::String modVeloDca      { "MOD_VELO_DCA" };
-    inline const juce::String modWheelDcw     { "MOD_WHEEL_DCW" };
-    inline const juce::String modWheelLfoRate { "MOD_WHEEL_LFORATE" };
-    inline const juce::String modWheelVib     { "MOD_WHEEL_VIB" };
-    inline const juce::String modAtDcw        { "MOD_AT_DCW" };
-    inline const juce::String modAtVib        { "MOD_AT_VIB" };
-    inline const juce::String keyTrackDcw     { "KEY_TRACK_DCW" };
-    inline const juce::String keyTrackPitch   { "KEY_TRACK_PITCH" };
-    inline const juce::String keyFollowDco    { "KEY_FOLLOW_DCO" };
-    inline const juce::String keyFollowDcw    { "KEY_FOLLOW_DCW" };
-    inline const juce::String keyFollowDca    { "KEY_FOLLOW_DCA" };
-
-    // --- Modern Filters ---
-    inline const juce::String lpfCutoff      { "MODERN_LPF_CUTOFF" };
-    inline const juce::String lpfReso        { "MODERN_LPF_RESO" };
-    inline const juce::String hpfCutoff      { "MODERN_HPF_CUTOFF" };
+#define CZ101_PARAMETER_ID_STRING(name, id) inline const juce::String name { id };
+    CZ101_PARAMETER_IDS(CZ101_PARAMETER_ID_STRING)
+#undef CZ101_PARAMETER_ID_STRING
 
-    // --- Effects ---
-    inline const juce::String driveAmount    { "DRIVE_AMOUNT" };
-    inline const juce::String driveColor     { "DRIVE_COLOR" };
-    inline const juce::String driveMix       { "DRIVE_MIX" };
-    inline const juce::String chorusRate     { "CHORUS_RATE" };
-    inline const juce::String chorusDepth    { "CHORUS_DEPTH" };
-    inline const juce::String chorusMix      { "CHORUS_MIX" };
-    inline const juce::String delayTime      { "DELAY_TIME" };
-    inline const juce::String delayFeedback  { "DELAY_FEEDBACK" };
-    inline const juce::String delayMix       { "DELAY_MIX" };
-    inline const juce::String reverbSize     { "REVERB_SIZE" };
-    inline const juce::String reverbMix      { "REVERB_MIX" };
+    /** Dense parameter index (declaration order), for flat per-parameter tables */
+    enum class Index : int
+    {
+#define CZ101_PARAMETER_ID_INDEX(name, id) name,
+        CZ101_PARAMETER_IDS(CZ101_PARAMETER_ID_INDEX)
+#undef CZ101_PARAMETER_ID_INDEX
+    };
 
-    // --- System ---
-    inline const juce::String protectSwitch   { "PROTECT_SWITCH" };
-    inline const juce::String systemPrg       { "SYSTEM_PRG" };
-    inline const juce::String bypass          { "BYPASS" };
-    inline const juce::String operationMode   { "OPERATION_MODE" };
-    inline const juce::String masterVolume    { "MASTER_VOLUME" };
-    inline const juce::String midiChannel     { "MIDI_CH" };
-    inline const juce::String masterTune      { "MASTER_TUNE" };
-    inline const juce::String benderRange     { "PITCH_BEND_RANGE" };
-    inline const juce::String transpose       { "KEY_TRANSPOSE" };
-    inline const juce::String oversampling    { "OVERSAMPLING_QUALITY" };
-    inline const juce::String hardwareNoise   { "HARDWARE_NOISE" };
+#define CZ101_PARAMETER_ID_COUNT(name, id) + 1
+    inline constexpr int NUM_PARAMETERS = 0 CZ101_PARAMETER_IDS(CZ101_PARAMETER_ID_COUNT);
+#undef CZ101_PARAMETER_ID_COUNT
 
-    // --- Arpeggiator ---
-    inline const juce::String arpEnabled     { "ARP_ENABLED" };
-    inline const juce::String arpLatch       { "ARP_LATCH" };
-    inline const juce::String arpRate        { "ARP_RATE" };
-    inline const juce::String arpBpm         { "ARP_BPM" };
-    inline const juce::String arpGate        { "ARP_GATE" };
-    inline const juce::String arpSwing       { "ARP_SWING" };
-    inline const juce::String arpSwingMode   { "ARP_SWING_MODE" };
-    inline const juce::String arpPattern     { "ARP_PATTERN" };
-    inline const juce::String arpOctave      { "ARP_OCTAVE" };
+    /** String ID of an index (serialisation and APVTS lookups) */
+    inline const juce::String& idFor(Index index)
+    {
+#define CZ101_PARAMETER_ID_ADDRESS(name, id) &name,
+        static const std::array<const juce::String*, NUM_PARAMETERS> ids { CZ101_PARAMETER_IDS(CZ101_PARAMETER_ID_ADDRESS) };
+#undef CZ101_PARAMETER_ID_ADDRESS
+        return *ids[static_cast<size_t>(index)];
+    }
 
-    // --- Performance Macros ---
-    inline const juce::String macroBrilliance { "MACRO_BRILLIANCE" };
-    inline const juce::String macroTone       { "MACRO_TONE" };
-    inline const juce::String macroSpace      { "MACRO_SPACE" };
+    /** Index of a string ID, or -1 (serialisation boundary only: linear scan) */
+    inline int indexOf(const juce::String& id)
+    {
+        for (int i = 0; i < NUM_PARAMETERS; ++i)
+            if (idFor(static_cast<Index>(i)) == id) return i;
+        return -1;
+    }
 
 } // namespace ParameterIDs
 } // namespace CZ101
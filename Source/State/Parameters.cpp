@@ -126,7 +126,7 @@ juce::AudioProcessorValueTreeState::ParameterLayout createParameterLayout()
         group->addChild(std::make_unique<juce::AudioParameterInt>(ParameterIDs::transpose, "Key Transpose", -12, 12, 0));
         
         // Phase 5.1: Oversampling Quality
-        group->addChild(std::make_unique<juce::AudioParameterChoice>(ParameterIDs::oversampling, "Oversampling", juce::StringArray{"1x (Eco)", "2x (High)", "4x (Ultra)"}, 0));
+        group->addChild(std::make_unique<juce::AudioParameterChoice>(ParameterIDs::oversampling, "Oversampling", juce::StringArray{"1x (Eco)", "2x (High)", "4x (Ultra)", "2x (Mix Bus)", "4x (Mix Bus)"}, 0));
         group->addChild(std::make_unique<juce::AudioParameterBool>(ParameterIDs::hardwareNoise, "Hardware Noise", true));
         
         layout.add(std::move(group));
@@ -171,6 +171,14 @@ Parameters::Parameters(juce::AudioProcessor& processor, juce::UndoManager* undoM
             parameterMap[rp->getParameterID()] = rp;
         }
     }
+
+    for (int i = 0; i < ParameterIDs::NUM_PARAMETERS; ++i)
+    {
+        const auto& id = ParameterIDs::idFor(static_cast<Index>(i));
+        rawValues[(size_t)i] = apvts->getRawParameterValue(id);
+        parameterObjects[(size_t)i] = apvts->getParameter(id);
+        jassert(rawValues[(size_t)i] != nullptr); // Every ID in CZ101_PARAMETER_IDS must be in the layout
+    }
 }
 
 void Parameters::createParameters() {}
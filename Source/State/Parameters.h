@@ -2,6 +2,9 @@
 
 #include <juce_audio_processors/juce_audio_processors.h>
 #include "ParameterIDs.h"
+#include <array>
+#include <atomic>
+#include <functional>
 #include <map>
 #include <string>
 
@@ -115,8 +118,50 @@ public:
     juce::AudioParameterFloat*  getMacroTone() const          { return getParam<juce::AudioParameterFloat>(ParameterIDs::macroTone); }
     juce::AudioParameterFloat*  getMacroSpace() const         { return getParam<juce::AudioParameterFloat>(ParameterIDs::macroSpace); }
 
+    // --- CACHED VALUE HANDLES ---
+    // Resolved once at construction (getRawParameterValue), so hot paths such as the
+    // snapshot builder read an atomic instead of a string lookup + dynamic_cast.
+    // Values are in parameter units: choice index / int value / 0-1 for bools.
+    using Index = ParameterIDs::Index;
+    float getRaw(Index p) const noexcept       { return rawValues[static_cast<size_t>(p)]->load(std::memory_order_relaxed); }
+    int   getRawInt(Index p) const noexcept    { return juce::roundToInt(getRaw(p)); }
+    bool  getRawBool(Index p) const noexcept   { return getRaw(p) >= 0.5f; }
+    std::atomic<float>* getRawHandle(Index p) const noexcept { return rawValues[static_cast<size_t>(p)]; }
+    juce::RangedAudioParameter* getParameter(Index p) const noexcept { return parameterObjects[static_cast<size_t>(p)]; }
+
     juce::RangedAudioParameter* getParameter(const juce::String& paramId) const;
     const std::map<juce::String, juce::RangedAudioParameter*>& getParameterMap() const { return parameterMap; }
+
+    // --- BATCHED WRITES ---
+    // A preset load writes dozens of parameters. Inside a ScopedBatch the per-parameter
+    // listeners (snapshot rebuild, LCD feedback) stay quiet; onBatchEnd fires once when
+    // the outermost batch closes so the owner can commit one snapshot and refresh once.
+    class ScopedBatch
+    {
+    public:
+        explicit ScopedBatch(Parameters& p) : owner(p)
+        {
+            if (owner.batchDepth.fetch_add(1) == 0 && owner.onBatchBegin)
+                owner.onBatchBegin();
+        }
+
+        ~ScopedBatch()
+        {
+            if (owner.batchDepth.fetch_sub(1) == 1 && owner.onBatchEnd)
+                owner.onBatchEnd();
+        }
+
+        ScopedBatch(const ScopedBatch&) = delete;
+        ScopedBatch& operator=(const ScopedBatch&) = delete;
+
+    private:
+        Parameters& owner;
+    };
+
+    bool isApplyingBatch() const noexcept { return batchDepth.load() > 0; }
+
+    std::function<void()> onBatchBegin;
+    std::function<void()> onBatchEnd;
     
 private:
     template <typename T>
@@ -127,6 +172,9 @@ private:
     juce::AudioProcessor& audioProcessor;
     std::unique_ptr<juce::AudioProcessorValueTreeState> apvts;
     std::map<juce::String, juce::RangedAudioParameter*> parameterMap;
+    std::array<std::atomic<float>*, ParameterIDs::NUM_PARAMETERS> rawValues {};
+    std::array<juce::RangedAudioParameter*, ParameterIDs::NUM_PARAMETERS> parameterObjects {};
+    std::atomic<int> batchDepth { 0 };
 };
 
 } // namespace State
@@ -2,6 +2,7 @@
 #include "Parameters.h"
 #include "ParameterIDs.h"
 #include "../Core/VoiceManager.h"
+#include <optional>
 // JuceHeader is now included in PresetManager.h
 
 namespace CZ101 {
@@ -26,6 +27,9 @@ void PresetManager::removeListener(Listener* l) { listeners.remove(l); }
 void PresetManager::setCompareMode(bool enabled)
 {
     const juce::ScopedWriteLock sl(presetLock);
+    // One snapshot commit + host refresh for the whole swap (reentrant read lock inside updateParameters)
+    std::optional<Parameters::ScopedBatch> batch;
+    if (parameters) batch.emplace(*parameters);
     
     if (enabled && !isComparing)
     {
@@ -40,6 +44,7 @@ void PresetManager::setCompareMode(bool enabled)
              // We load into 'currentPreset' so the engine & UI reflect the "Saved" state
              // But we DON'T update the index or anything else.
              currentPreset = presets[currentPresetIndex];
+             ++currentPresetSerial;
         }
         // Apply "Saved" state to engine
         applyPresetToProcessor(currentPreset);
@@ -51,21 +56,11 @@ void PresetManager::setCompareMode(bool enabled)
     {
         // Exit Compare: Restore Backup -> Engine
         currentPreset = compareBuffer;
+        ++currentPresetSerial;
         isComparing = false;
         applyPresetToProcessor(currentPreset);
     }
-    
-    // Update Voice Envelopes
-    if (voiceManager)
-    {
-        applyEnvelopeToVoice(currentPreset.pitchEnv, 0, 1);
-        applyEnvelopeToVoice(currentPreset.dcwEnv, 1, 1);
-        applyEnvelopeToVoice(currentPreset.dcaEnv, 2, 1);
-        
-        applyEnvelopeToVoice(currentPreset.pitchEnv2, 0, 2);
-        applyEnvelopeToVoice(currentPreset.dcwEnv2, 1, 2);
-        applyEnvelopeToVoice(currentPreset.dcaEnv2, 2, 2);
-    }
+    // Envelopes reach the voices with the batch's snapshot commit (buildAudioSnapshot reads currentPreset)
 }
 
 void PresetManager::loadPreset(int index, bool updateVoice)
@@ -78,6 +73,7 @@ void PresetManager::loadPreset(int index, bool updateVoice)
         {
             currentPresetIndex = index;
             currentPreset = presets[index];
+            ++currentPresetSerial;
             pToLoad = currentPreset;
             notifyIndex = index;
         }
@@ -85,17 +81,13 @@ void PresetManager::loadPreset(int index, bool updateVoice)
 
     if (notifyIndex >= 0)
     {
-        applyPresetToProcessor(pToLoad);
-        
-        if (updateVoice && voiceManager)
         {
-            applyEnvelopeToVoice(pToLoad.pitchEnv, 0, 1);
-            applyEnvelopeToVoice(pToLoad.dcwEnv, 1, 1);
-            applyEnvelopeToVoice(pToLoad.dcaEnv, 2, 1);
-            
-            applyEnvelopeToVoice(pToLoad.pitchEnv2, 0, 2);
-            applyEnvelopeToVoice(pToLoad.dcwEnv2, 1, 2);
-            applyEnvelopeToVoice(pToLoad.dcaEnv2, 2, 2);
+            std::optional<Parameters::ScopedBatch> batch;
+            if (parameters) batch.emplace(*parameters);
+
+            // The envelopes ride on the batch's snapshot commit, applied by the audio thread
+            juce::ignoreUnused(updateVoice);
+            applyPresetToProcessor(pToLoad);
         }
 
         // Notify listeners OUTSIDE the lock
@@ -108,67 +100,34 @@ void PresetManager::loadPresetFromStruct(const Preset& p, bool updateVoice, bool
     {
         const juce::ScopedWriteLock sl(presetLock);
         currentPreset = p;
+        ++currentPresetSerial;
     }
     
+    // Audit Fix [2.1]: Host display and APVTS are synced once, when the batch closes
+    // (the processor's onBatchEnd), and the envelopes reach the voices with that same
+    // snapshot commit; updateVoice and notifyHost are kept for API compatibility.
+    juce::ignoreUnused(updateVoice, notifyHost);
+    std::optional<Parameters::ScopedBatch> batch;
+    if (parameters) batch.emplace(*parameters);
+
     applyPresetToProcessor(p);
-    
-    if (updateVoice && voiceManager)
-    {
-        applyEnvelopeToVoice(p.pitchEnv, 0, 1);
-        applyEnvelopeToVoice(p.dcwEnv, 1, 1);
-        applyEnvelopeToVoice(p.dcaEnv, 2, 1);
-        
-        applyEnvelopeToVoice(p.pitchEnv2, 0, 2);
-        applyEnvelopeToVoice(p.dcwEnv2, 1, 2);
-        applyEnvelopeToVoice(p.dcaEnv2, 2, 2);
-    }
-    
-    // Audit Fix [2.1]: Ensure Host Display and APVTS are in sync
-    if (notifyHost && parameters)
-    {
-         // Note: We cannot call audioProcessor.updateHostDisplay() directly here as we only have Parameters.
-         // However, applyPresetToProcessor calls setValueNotifyingHost which triggers listeners.
-    }
 }
 
 void PresetManager::applyPresetToProcessor(const Preset& p)
 {
     if (parameters)
     {
-        for (const auto& pair : p.parameters)
+        const Parameters::ScopedBatch batch(*parameters);
+        p.parameters.forEachStored([this](ParameterIDs::Index id, float value)
         {
-            const auto& paramId = pair.first;
-            const auto& value = pair.second;
-            
-            if (auto* param = parameters->getParameter(paramId))
+            if (auto* param = parameters->getParameter(id))
             {
+                // Unchanged values would only cost a host notification (and an undo step)
                 float normalized = param->convertTo0to1(value);
-                param->setValueNotifyingHost(normalized);
+                if (param->getValue() != normalized)
+                    param->setValueNotifyingHost(normalized);
             }
-        }
-    }
-}
-
-void PresetManager::applyEnvelopeToVoice(const EnvelopeData& env, int type, int line)
-{
-    if (!voiceManager) return;
-
-    for (int i = 0; i < 8; ++i)
-    {
-        if (type == 0) voiceManager->setPitchStage(line, i, env.rates[i], env.levels[i]);
-        else if (type == 1) voiceManager->setDCWStage(line, i, env.rates[i], env.levels[i]);
-        else if (type == 2) voiceManager->setDCAStage(line, i, env.rates[i], env.levels[i]);
-    }
-
-    if (type == 0) {
-        voiceManager->setPitchSustainPoint(line, env.sustainPoint);
-        voiceManager->setPitchEndPoint(line, env.endPoint);
-    } else if (type == 1) {
-        voiceManager->setDCWSustainPoint(line, env.sustainPoint);
-        voiceManager->setDCWEndPoint(line, env.endPoint);
-    } else if (type == 2) {
-        voiceManager->setDCASustainPoint(line, env.sustainPoint);
-        voiceManager->setDCAEndPoint(line, env.endPoint);
+        });
     }
 }
 
@@ -179,22 +138,11 @@ void PresetManager::copyStateFromProcessor()
         // 1. Capture Parameters (Denormalized)
         if (parameters)
         {
-            // Iterate over ALL defined parameters using the new getter
-            const auto& map = parameters->getParameterMap();
-            for (const auto& pair : map) 
+            // Every parameter, in parameter units, through the cached handles
+            for (int i = 0; i < ParameterIDs::NUM_PARAMETERS; ++i)
             {
-                const juce::String& key = pair.first;
-                juce::RangedAudioParameter* param = pair.second;
-                std::string stdKey = key.toStdString();
-
-                if (auto* p = dynamic_cast<juce::AudioParameterFloat*>(param))
-                    currentPreset.parameters[stdKey] = p->get();
-                else if (auto* pInt = dynamic_cast<juce::AudioParameterInt*>(param))
-                    currentPreset.parameters[stdKey] = (float)pInt->get();
-                else if (auto* pChoice = dynamic_cast<juce::AudioParameterChoice*>(param))
-                    currentPreset.parameters[stdKey] = (float)pChoice->getIndex();
-                else if (auto* pBool = dynamic_cast<juce::AudioParameterBool*>(param))
-                    currentPreset.parameters[stdKey] = pBool->get() ? 1.0f : 0.0f;
+                const auto id = static_cast<ParameterIDs::Index>(i);
+                currentPreset.parameters.set(id, parameters->getRaw(id));
             }
         }
 
@@ -275,11 +223,11 @@ void PresetManager::createFactoryPresets()
         p.author = "User";
         initEnvelopes(p);
         
-        p.parameters[ParameterIDs::osc1Waveform.toStdString()] = 1.0f; // Saw
-        p.parameters[ParameterIDs::osc1Level.toStdString()] = 1.0f;
-        p.parameters[ParameterIDs::osc2Waveform.toStdString()] = 1.0f; 
-        p.parameters[ParameterIDs::osc2Level.toStdString()] = 1.0f;
-        p.parameters[ParameterIDs::osc2Detune.toStdString()] = -7.0f; 
+        p.parameters.set(ParameterIDs::Index::osc1Waveform, 1.0f); // Saw
+        p.parameters.set(ParameterIDs::Index::osc1Level, 1.0f);
+        p.parameters.set(ParameterIDs::Index::osc2Waveform, 1.0f); 
+        p.parameters.set(ParameterIDs::Index::osc2Level, 1.0f);
+        p.parameters.set(ParameterIDs::Index::osc2Detune, -7.0f); 
         
         // DCW
          p.dcwEnv.levels[0] = 0.48f; p.dcwEnv.rates[0] = 0.78f;
@@ -295,9 +243,9 @@ void PresetManager::createFactoryPresets()
         p.dcaEnv.levels[1] = 0.0f; p.dcaEnv.rates[1] = 0.39f;
         p.dcaEnv.endPoint = 1;
         
-        p.parameters[ParameterIDs::lfoWaveform.toStdString()] = 3.0f; 
-        p.parameters[ParameterIDs::lfoRate.toStdString()] = 0.49f;
-        p.parameters[ParameterIDs::lfoDepth.toStdString()] = 0.59f;
+        p.parameters.set(ParameterIDs::Index::lfoWaveform, 3.0f); 
+        p.parameters.set(ParameterIDs::Index::lfoRate, 0.49f);
+        p.parameters.set(ParameterIDs::Index::lfoDepth, 0.59f);
 
         presets.push_back(p);
     }
@@ -309,11 +257,11 @@ void PresetManager::createFactoryPresets()
         p.author = "User";
         initEnvelopes(p);
 
-        p.parameters[ParameterIDs::osc1Waveform.toStdString()] = 1.0f;
-        p.parameters[ParameterIDs::osc1Level.toStdString()] = 0.5f;
-        p.parameters[ParameterIDs::osc2Waveform.toStdString()] = 1.0f; 
-        p.parameters[ParameterIDs::osc2Level.toStdString()] = 0.5f;
-        p.parameters[ParameterIDs::osc2Detune.toStdString()] = 6.0f; 
+        p.parameters.set(ParameterIDs::Index::osc1Waveform, 1.0f);
+        p.parameters.set(ParameterIDs::Index::osc1Level, 0.5f);
+        p.parameters.set(ParameterIDs::Index::osc2Waveform, 1.0f); 
+        p.parameters.set(ParameterIDs::Index::osc2Level, 0.5f);
+        p.parameters.set(ParameterIDs::Index::osc2Detune, 6.0f); 
 
         // DCW
         p.dcwEnv.levels[0] = 0.99f; p.dcwEnv.rates[0] = 0.99f; 
@@ -342,9 +290,9 @@ void PresetManager::createFactoryPresets()
         p.author = "User";
         initEnvelopes(p);
 
-        p.parameters[ParameterIDs::lfoWaveform.toStdString()] = 1.0f; 
-        p.parameters[ParameterIDs::lfoDepth.toStdString()] = 1.0f; 
-        p.parameters[ParameterIDs::lfoRate.toStdString()] = 0.6f; 
+        p.parameters.set(ParameterIDs::Index::lfoWaveform, 1.0f); 
+        p.parameters.set(ParameterIDs::Index::lfoDepth, 1.0f); 
+        p.parameters.set(ParameterIDs::Index::lfoRate, 0.6f); 
 
         p.pitchEnv.levels[0] = 0.5f; p.pitchEnv.rates[0] = 0.5f; 
         p.pitchEnv.levels[1] = 0.0f; p.pitchEnv.rates[1] = 0.5f;
@@ -366,29 +314,29 @@ void PresetManager::createFactoryPresets()
         initEnvelopes(p);
         
         // Defaults
-        p.parameters[ParameterIDs::osc1Waveform.toStdString()] = 0.0f; p.parameters[ParameterIDs::osc1Level.toStdString()] = 1.0f;
-        p.parameters[ParameterIDs::osc2Waveform.toStdString()] = 0.0f; p.parameters[ParameterIDs::osc2Level.toStdString()] = 0.0f;
-        p.parameters[ParameterIDs::osc2Detune.toStdString()] = 0.0f;
+        p.parameters.set(ParameterIDs::Index::osc1Waveform, 0.0f); p.parameters.set(ParameterIDs::Index::osc1Level, 1.0f);
+        p.parameters.set(ParameterIDs::Index::osc2Waveform, 0.0f); p.parameters.set(ParameterIDs::Index::osc2Level, 0.0f);
+        p.parameters.set(ParameterIDs::Index::osc2Detune, 0.0f);
         
-        p.parameters[ParameterIDs::dcwAttack.toStdString()] = 0.0f; p.parameters[ParameterIDs::dcwDecay.toStdString()] = 0.0f; p.parameters[ParameterIDs::dcwSustain.toStdString()] = 1.0f; p.parameters[ParameterIDs::dcwRelease.toStdString()] = 0.0f;
-        p.parameters[ParameterIDs::dcaAttack.toStdString()] = 0.0f; p.parameters[ParameterIDs::dcaDecay.toStdString()] = 0.0f; p.parameters[ParameterIDs::dcaSustain.toStdString()] = 1.0f; p.parameters[ParameterIDs::dcaRelease.toStdString()] = 0.0f;
+        p.parameters.set(ParameterIDs::Index::dcwAttack, 0.0f); p.parameters.set(ParameterIDs::Index::dcwDecay, 0.0f); p.parameters.set(ParameterIDs::Index::dcwSustain, 1.0f); p.parameters.set(ParameterIDs::Index::dcwRelease, 0.0f);
+        p.parameters.set(ParameterIDs::Index::dcaAttack, 0.0f); p.parameters.set(ParameterIDs::Index::dcaDecay, 0.0f); p.parameters.set(ParameterIDs::Index::dcaSustain, 1.0f); p.parameters.set(ParameterIDs::Index::dcaRelease, 0.0f);
         
-        p.parameters[ParameterIDs::lpfCutoff.toStdString()] = 20000.0f; p.parameters[ParameterIDs::lpfReso.toStdString()] = 0.1f;
-        p.parameters[ParameterIDs::lfoRate.toStdString()] = 1.0f;
-        p.parameters[ParameterIDs::delayMix.toStdString()] = 0.0f; p.parameters[ParameterIDs::reverbMix.toStdString()] = 0.0f;
-        p.parameters[ParameterIDs::hardSync.toStdString()] = 0.0f;
-        p.parameters[ParameterIDs::ringMod.toStdString()] = 0.0f;
-        p.parameters[ParameterIDs::glideTime.toStdString()] = 0.0f;
+        p.parameters.set(ParameterIDs::Index::lpfCutoff, 20000.0f); p.parameters.set(ParameterIDs::Index::lpfReso, 0.1f);
+        p.parameters.set(ParameterIDs::Index::lfoRate, 1.0f);
+        p.parameters.set(ParameterIDs::Index::delayMix, 0.0f); p.parameters.set(ParameterIDs::Index::reverbMix, 0.0f);
+        p.parameters.set(ParameterIDs::Index::hardSync, 0.0f);
+        p.parameters.set(ParameterIDs::Index::ringMod, 0.0f);
+        p.parameters.set(ParameterIDs::Index::glideTime, 0.0f);
         
         // Audit Fix 3.2: Initialize "Phantom" Parameters
-        p.parameters[ParameterIDs::lineSelect.toStdString()] = 1.0f; // Default Line 1
-        p.parameters[ParameterIDs::systemPrg.toStdString()] = 0.0f;
-        p.parameters[ParameterIDs::protectSwitch.toStdString()] = 0.0f;
+        p.parameters.set(ParameterIDs::Index::lineSelect, 1.0f); // Default Line 1
+        p.parameters.set(ParameterIDs::Index::systemPrg, 0.0f);
+        p.parameters.set(ParameterIDs::Index::protectSwitch, 0.0f);
         
         // Chorus
-        p.parameters[ParameterIDs::chorusRate.toStdString()] = 0.5f;
-        p.parameters[ParameterIDs::chorusDepth.toStdString()] = 2.0f;
-        p.parameters[ParameterIDs::chorusMix.toStdString()] = 0.0f;
+        p.parameters.set(ParameterIDs::Index::chorusRate, 0.5f);
+        p.parameters.set(ParameterIDs::Index::chorusDepth, 2.0f);
+        p.parameters.set(ParameterIDs::Index::chorusMix, 0.0f);
 
         presets.push_back(p);
     }
@@ -401,13 +349,13 @@ void PresetManager::createBassPreset()
     initEnvelopes(p);
     
     // ===== OSCILLATORS (NORMALIZED) =====
-    p.parameters[ParameterIDs::osc1Waveform.toStdString()] = 1.0f;      // Saw
-    p.parameters[ParameterIDs::osc1Level.toStdString()] = 0.6f;         // âœ… 60% (normalized)
-    p.parameters[ParameterIDs::osc2Waveform.toStdString()] = 2.0f;      // Square
-    p.parameters[ParameterIDs::osc2Level.toStdString()] = 0.4f;         // âœ… 40% (normalized)
+    p.parameters.set(ParameterIDs::Index::osc1Waveform, 1.0f);      // Saw
+    p.parameters.set(ParameterIDs::Index::osc1Level, 0.6f);         // âœ… 60% (normalized)
+    p.parameters.set(ParameterIDs::Index::osc2Waveform, 2.0f);      // Square
+    p.parameters.set(ParameterIDs::Index::osc2Level, 0.4f);         // âœ… 40% (normalized)
     // Total: 0.6 + 0.4 = 1.0 âœ…
     
-    p.parameters[ParameterIDs::osc2Detune.toStdString()] = -10.0f;      // -10 cents
+    p.parameters.set(ParameterIDs::Index::osc2Detune, -10.0f);      // -10 cents
     
     // ===== ENVELOPES (Explicit for 8-stage engine) =====
     // Pitch: Flat
@@ -429,32 +377,32 @@ void PresetManager::createBassPreset()
     p.dcaEnv.sustainPoint = 2; p.dcaEnv.endPoint = 3;
 
     // Also set legacy params for display
-    p.parameters[ParameterIDs::dcwAttack.toStdString()] = 0.01f; p.parameters[ParameterIDs::dcwDecay.toStdString()] = 0.2f; p.parameters[ParameterIDs::dcwSustain.toStdString()] = 0.2f; p.parameters[ParameterIDs::dcwRelease.toStdString()] = 0.1f;
-    p.parameters[ParameterIDs::dcaAttack.toStdString()] = 0.001f; p.parameters[ParameterIDs::dcaDecay.toStdString()] = 0.2f; p.parameters[ParameterIDs::dcaSustain.toStdString()] = 0.5f; p.parameters[ParameterIDs::dcaRelease.toStdString()] = 0.15f;
+    p.parameters.set(ParameterIDs::Index::dcwAttack, 0.01f); p.parameters.set(ParameterIDs::Index::dcwDecay, 0.2f); p.parameters.set(ParameterIDs::Index::dcwSustain, 0.2f); p.parameters.set(ParameterIDs::Index::dcwRelease, 0.1f);
+    p.parameters.set(ParameterIDs::Index::dcaAttack, 0.001f); p.parameters.set(ParameterIDs::Index::dcaDecay, 0.2f); p.parameters.set(ParameterIDs::Index::dcaSustain, 0.5f); p.parameters.set(ParameterIDs::Index::dcaRelease, 0.15f);
     
     // ===== FILTER =====
-    p.parameters[ParameterIDs::lpfCutoff.toStdString()] = 2000.0f;   // 2000 Hz
-    p.parameters[ParameterIDs::lpfReso.toStdString()] = 0.5f;   // 50% Q
+    p.parameters.set(ParameterIDs::Index::lpfCutoff, 2000.0f);   // 2000 Hz
+    p.parameters.set(ParameterIDs::Index::lpfReso, 0.5f);   // 50% Q
     
     // ===== LFO =====
-    p.parameters[ParameterIDs::lfoRate.toStdString()] = 0.5f;           // 0.5 Hz
-    p.parameters[ParameterIDs::lfoDepth.toStdString()] = 0.0f;          // No vibrato
+    p.parameters.set(ParameterIDs::Index::lfoRate, 0.5f);           // 0.5 Hz
+    p.parameters.set(ParameterIDs::Index::lfoDepth, 0.0f);          // No vibrato
     
     // ===== EFFECTS =====
-    p.parameters[ParameterIDs::delayTime.toStdString()] = 0.3f;         // âœ… 300ms
-    p.parameters[ParameterIDs::delayFeedback.toStdString()] = 0.3f;     // 30%
-    p.parameters[ParameterIDs::delayMix.toStdString()] = 0.08f;         // âœ… 8% wet
+    p.parameters.set(ParameterIDs::Index::delayTime, 0.3f);         // âœ… 300ms
+    p.parameters.set(ParameterIDs::Index::delayFeedback, 0.3f);     // 30%
+    p.parameters.set(ParameterIDs::Index::delayMix, 0.08f);         // âœ… 8% wet
     
-    p.parameters[ParameterIDs::chorusRate.toStdString()] = 0.5f;        // 0.5 Hz
-    p.parameters[ParameterIDs::chorusDepth.toStdString()] = 2.0f;       // 2ms
-    p.parameters[ParameterIDs::chorusMix.toStdString()] = 0.0f;         // Off
+    p.parameters.set(ParameterIDs::Index::chorusRate, 0.5f);        // 0.5 Hz
+    p.parameters.set(ParameterIDs::Index::chorusDepth, 2.0f);       // 2ms
+    p.parameters.set(ParameterIDs::Index::chorusMix, 0.0f);         // Off
     
-    p.parameters[ParameterIDs::reverbSize.toStdString()] = 0.3f;        // Small room
-    p.parameters[ParameterIDs::reverbMix.toStdString()] = 0.08f;        // âœ… 8% wet
+    p.parameters.set(ParameterIDs::Index::reverbSize, 0.3f);        // Small room
+    p.parameters.set(ParameterIDs::Index::reverbMix, 0.08f);        // âœ… 8% wet
     
-    p.parameters[ParameterIDs::hardSync.toStdString()] = 0.0f;          // Off
-    p.parameters[ParameterIDs::ringMod.toStdString()] = 0.0f;           // Off
-    p.parameters[ParameterIDs::glideTime.toStdString()] = 0.0f;         // No portamento
+    p.parameters.set(ParameterIDs::Index::hardSync, 0.0f);          // Off
+    p.parameters.set(ParameterIDs::Index::ringMod, 0.0f);           // Off
+    p.parameters.set(ParameterIDs::Index::glideTime, 0.0f);         // No portamento
     
     presets.push_back(p);
 }
@@ -466,13 +414,13 @@ void PresetManager::createStringPreset()
     initEnvelopes(p);
     
     // ===== OSCILLATORS (NORMALIZED) =====
-    p.parameters[ParameterIDs::osc1Waveform.toStdString()] = 1.0f;      // Saw
-    p.parameters[ParameterIDs::osc1Level.toStdString()] = 0.5f;         // âœ… 50% (normalized)
-    p.parameters[ParameterIDs::osc2Waveform.toStdString()] = 1.0f;      // Saw
-    p.parameters[ParameterIDs::osc2Level.toStdString()] = 0.5f;         // âœ… 50% (normalized)
+    p.parameters.set(ParameterIDs::Index::osc1Waveform, 1.0f);      // Saw
+    p.parameters.set(ParameterIDs::Index::osc1Level, 0.5f);         // âœ… 50% (normalized)
+    p.parameters.set(ParameterIDs::Index::osc2Waveform, 1.0f);      // Saw
+    p.parameters.set(ParameterIDs::Index::osc2Level, 0.5f);         // âœ… 50% (normalized)
     // Total: 0.5 + 0.5 = 1.0 âœ…
     
-    p.parameters[ParameterIDs::osc2Detune.toStdString()] = 12.0f;       // +1 octava
+    p.parameters.set(ParameterIDs::Index::osc2Detune, 12.0f);       // +1 octava
     
     // ===== ENVELOPES (Explicit for 8-stage engine) =====
     // Pitch: Flat
@@ -494,32 +442,32 @@ void PresetManager::createStringPreset()
     p.dcaEnv.sustainPoint = 2; p.dcaEnv.endPoint = 3;
 
     // Legacy Params for display
-    p.parameters[ParameterIDs::dcwAttack.toStdString()] = 0.3f; p.parameters[ParameterIDs::dcwDecay.toStdString()] = 0.4f; p.parameters[ParameterIDs::dcwSustain.toStdString()] = 0.7f; p.parameters[ParameterIDs::dcwRelease.toStdString()] = 0.5f;
-    p.parameters[ParameterIDs::dcaAttack.toStdString()] = 0.4f; p.parameters[ParameterIDs::dcaDecay.toStdString()] = 0.3f; p.parameters[ParameterIDs::dcaSustain.toStdString()] = 0.8f; p.parameters[ParameterIDs::dcaRelease.toStdString()] = 0.6f;
+    p.parameters.set(ParameterIDs::Index::dcwAttack, 0.3f); p.parameters.set(ParameterIDs::Index::dcwDecay, 0.4f); p.parameters.set(ParameterIDs::Index::dcwSustain, 0.7f); p.parameters.set(ParameterIDs::Index::dcwRelease, 0.5f);
+    p.parameters.set(ParameterIDs::Index::dcaAttack, 0.4f); p.parameters.set(ParameterIDs::Index::dcaDecay, 0.3f); p.parameters.set(ParameterIDs::Index::dcaSustain, 0.8f); p.parameters.set(ParameterIDs::Index::dcaRelease, 0.6f);
     
     // ===== FILTER =====
-    p.parameters[ParameterIDs::lpfCutoff.toStdString()] = 8000.0f;   // Open
-    p.parameters[ParameterIDs::lpfReso.toStdString()] = 0.3f;   // 30% Q
+    p.parameters.set(ParameterIDs::Index::lpfCutoff, 8000.0f);   // Open
+    p.parameters.set(ParameterIDs::Index::lpfReso, 0.3f);   // 30% Q
     
     // ===== LFO (VIBRATO) =====
-    p.parameters[ParameterIDs::lfoRate.toStdString()] = 4.5f;           // âœ… 4.5 Hz
-    p.parameters[ParameterIDs::lfoDepth.toStdString()] = 0.08f;         // âœ… Subtle vibrato
+    p.parameters.set(ParameterIDs::Index::lfoRate, 4.5f);           // âœ… 4.5 Hz
+    p.parameters.set(ParameterIDs::Index::lfoDepth, 0.08f);         // âœ… Subtle vibrato
     
     // ===== EFFECTS =====
-    p.parameters[ParameterIDs::delayTime.toStdString()] = 0.25f;        // âœ… 250ms
-    p.parameters[ParameterIDs::delayFeedback.toStdString()] = 0.4f;     // 40%
-    p.parameters[ParameterIDs::delayMix.toStdString()] = 0.3f;          // âœ… 30% wet (longer tail)
+    p.parameters.set(ParameterIDs::Index::delayTime, 0.25f);        // âœ… 250ms
+    p.parameters.set(ParameterIDs::Index::delayFeedback, 0.4f);     // 40%
+    p.parameters.set(ParameterIDs::Index::delayMix, 0.3f);          // âœ… 30% wet (longer tail)
     
-    p.parameters[ParameterIDs::chorusRate.toStdString()] = 0.6f;        // 0.6 Hz
-    p.parameters[ParameterIDs::chorusDepth.toStdString()] = 3.0f;       // 3ms
-    p.parameters[ParameterIDs::chorusMix.toStdString()] = 0.15f;        // âœ… 15% light chorus
+    p.parameters.set(ParameterIDs::Index::chorusRate, 0.6f);        // 0.6 Hz
+    p.parameters.set(ParameterIDs::Index::chorusDepth, 3.0f);       // 3ms
+    p.parameters.set(ParameterIDs::Index::chorusMix, 0.15f);        // âœ… 15% light chorus
     
-    p.parameters[ParameterIDs::reverbSize.toStdString()] = 0.7f;        // Large room
-    p.parameters[ParameterIDs::reverbMix.toStdString()] = 0.4f;         // âœ… 40% wet (lush)
+    p.parameters.set(ParameterIDs::Index::reverbSize, 0.7f);        // Large room
+    p.parameters.set(ParameterIDs::Index::reverbMix, 0.4f);         // âœ… 40% wet (lush)
     
-    p.parameters[ParameterIDs::hardSync.toStdString()] = 0.0f;
-    p.parameters[ParameterIDs::ringMod.toStdString()] = 0.0f;
-    p.parameters[ParameterIDs::glideTime.toStdString()] = 0.0f;
+    p.parameters.set(ParameterIDs::Index::hardSync, 0.0f);
+    p.parameters.set(ParameterIDs::Index::ringMod, 0.0f);
+    p.parameters.set(ParameterIDs::Index::glideTime, 0.0f);
     
     presets.push_back(p);
 }
@@ -530,9 +478,9 @@ void PresetManager::createBrassPreset()
     p.name = "Synth Brass";
     initEnvelopes(p);
     
-    p.parameters[ParameterIDs::osc1Waveform.toStdString()] = 1.0f; p.parameters[ParameterIDs::osc1Level.toStdString()] = 1.0f;
-    p.parameters[ParameterIDs::osc2Waveform.toStdString()] = 3.0f; p.parameters[ParameterIDs::osc2Level.toStdString()] = 0.6f; // Triangle for body
-    p.parameters[ParameterIDs::osc2Detune.toStdString()] = 7.0f; // Slight detune
+    p.parameters.set(ParameterIDs::Index::osc1Waveform, 1.0f); p.parameters.set(ParameterIDs::Index::osc1Level, 1.0f);
+    p.parameters.set(ParameterIDs::Index::osc2Waveform, 3.0f); p.parameters.set(ParameterIDs::Index::osc2Level, 0.6f); // Triangle for body
+    p.parameters.set(ParameterIDs::Index::osc2Detune, 7.0f); // Slight detune
     
     // Pitch Envelope (Brass Attack: slight drop-up)
     // Stage 0: Fast drop to slightly fla (-2 semitones approx)
@@ -570,23 +518,23 @@ void PresetManager::createBrassPreset()
     p.dcaEnv.endPoint = 3;
     
     // UI Params (Approximate for display)
-    p.parameters[ParameterIDs::dcwAttack.toStdString()] = 0.2f; p.parameters[ParameterIDs::dcwDecay.toStdString()] = 0.3f; p.parameters[ParameterIDs::dcwSustain.toStdString()] = 0.8f; p.parameters[ParameterIDs::dcwRelease.toStdString()] = 0.4f;
-    p.parameters[ParameterIDs::dcaAttack.toStdString()] = 0.1f; p.parameters[ParameterIDs::dcaDecay.toStdString()] = 0.2f; p.parameters[ParameterIDs::dcaSustain.toStdString()] = 0.9f; p.parameters[ParameterIDs::dcaRelease.toStdString()] = 0.4f;
+    p.parameters.set(ParameterIDs::Index::dcwAttack, 0.2f); p.parameters.set(ParameterIDs::Index::dcwDecay, 0.3f); p.parameters.set(ParameterIDs::Index::dcwSustain, 0.8f); p.parameters.set(ParameterIDs::Index::dcwRelease, 0.4f);
+    p.parameters.set(ParameterIDs::Index::dcaAttack, 0.1f); p.parameters.set(ParameterIDs::Index::dcaDecay, 0.2f); p.parameters.set(ParameterIDs::Index::dcaSustain, 0.9f); p.parameters.set(ParameterIDs::Index::dcaRelease, 0.4f);
 
     // Filter
-    p.parameters[ParameterIDs::lpfCutoff.toStdString()] = 5000.0f;
-    p.parameters[ParameterIDs::lpfReso.toStdString()] = 0.6f;
+    p.parameters.set(ParameterIDs::Index::lpfCutoff, 5000.0f);
+    p.parameters.set(ParameterIDs::Index::lpfReso, 0.6f);
 
     // LFO
-    p.parameters[ParameterIDs::lfoRate.toStdString()] = 0.5f;
+    p.parameters.set(ParameterIDs::Index::lfoRate, 0.5f);
     
     // Effects
-    p.parameters[ParameterIDs::delayTime.toStdString()] = 0.0f; p.parameters[ParameterIDs::delayFeedback.toStdString()] = 0.0f; p.parameters[ParameterIDs::delayMix.toStdString()] = 0.0f;
-    p.parameters[ParameterIDs::reverbSize.toStdString()] = 0.6f; p.parameters[ParameterIDs::reverbMix.toStdString()] = 0.3f;
+    p.parameters.set(ParameterIDs::Index::delayTime, 0.0f); p.parameters.set(ParameterIDs::Index::delayFeedback, 0.0f); p.parameters.set(ParameterIDs::Index::delayMix, 0.0f);
+    p.parameters.set(ParameterIDs::Index::reverbSize, 0.6f); p.parameters.set(ParameterIDs::Index::reverbMix, 0.3f);
     
-    p.parameters[ParameterIDs::hardSync.toStdString()] = 0.0f;
-    p.parameters[ParameterIDs::ringMod.toStdString()] = 0.0f;
-    p.parameters[ParameterIDs::glideTime.toStdString()] = 0.0f;
+    p.parameters.set(ParameterIDs::Index::hardSync, 0.0f);
+    p.parameters.set(ParameterIDs::Index::ringMod, 0.0f);
+    p.parameters.set(ParameterIDs::Index::glideTime, 0.0f);
 
     presets.push_back(p);
 }
@@ -597,9 +545,9 @@ void PresetManager::createLeadPreset()
     p.name = "Solo Lead";
     initEnvelopes(p);
     
-    p.parameters[ParameterIDs::osc1Waveform.toStdString()] = 2.0f; p.parameters[ParameterIDs::osc1Level.toStdString()] = 1.0f;
-    p.parameters[ParameterIDs::osc2Waveform.toStdString()] = 2.0f; p.parameters[ParameterIDs::osc2Level.toStdString()] = 0.6f;
-    p.parameters[ParameterIDs::osc2Detune.toStdString()] = 0.0f;
+    p.parameters.set(ParameterIDs::Index::osc1Waveform, 2.0f); p.parameters.set(ParameterIDs::Index::osc1Level, 1.0f);
+    p.parameters.set(ParameterIDs::Index::osc2Waveform, 2.0f); p.parameters.set(ParameterIDs::Index::osc2Level, 0.6f);
+    p.parameters.set(ParameterIDs::Index::osc2Detune, 0.0f);
     
     // DCW: Open
     p.dcwEnv.rates[0] = 0.99f; p.dcwEnv.levels[0] = 1.0f;
@@ -613,25 +561,25 @@ void PresetManager::createLeadPreset()
     p.dcaEnv.rates[2] = 0.99f; p.dcaEnv.levels[2] = 1.0f;
     p.dcaEnv.rates[3] = 0.7f;  p.dcaEnv.levels[3] = 0.0f;
     
-    p.parameters[ParameterIDs::dcwAttack.toStdString()] = 0.0f; p.parameters[ParameterIDs::dcwDecay.toStdString()] = 0.0f; p.parameters[ParameterIDs::dcwSustain.toStdString()] = 1.0f; p.parameters[ParameterIDs::dcwRelease.toStdString()] = 0.1f;
-    p.parameters[ParameterIDs::dcaAttack.toStdString()] = 0.001f; p.parameters[ParameterIDs::dcaDecay.toStdString()] = 0.1f; p.parameters[ParameterIDs::dcaSustain.toStdString()] = 1.0f; p.parameters[ParameterIDs::dcaRelease.toStdString()] = 0.2f;
+    p.parameters.set(ParameterIDs::Index::dcwAttack, 0.0f); p.parameters.set(ParameterIDs::Index::dcwDecay, 0.0f); p.parameters.set(ParameterIDs::Index::dcwSustain, 1.0f); p.parameters.set(ParameterIDs::Index::dcwRelease, 0.1f);
+    p.parameters.set(ParameterIDs::Index::dcaAttack, 0.001f); p.parameters.set(ParameterIDs::Index::dcaDecay, 0.1f); p.parameters.set(ParameterIDs::Index::dcaSustain, 1.0f); p.parameters.set(ParameterIDs::Index::dcaRelease, 0.2f);
     
     // Filter
-    p.parameters[ParameterIDs::lpfCutoff.toStdString()] = 20000.0f;
-    p.parameters[ParameterIDs::lpfReso.toStdString()] = 0.1f;
+    p.parameters.set(ParameterIDs::Index::lpfCutoff, 20000.0f);
+    p.parameters.set(ParameterIDs::Index::lpfReso, 0.1f);
 
     // LFO
-    p.parameters[ParameterIDs::lfoRate.toStdString()] = 4.0f;
+    p.parameters.set(ParameterIDs::Index::lfoRate, 4.0f);
     
     // Effects
-    p.parameters[ParameterIDs::delayTime.toStdString()] = 0.4f; p.parameters[ParameterIDs::delayFeedback.toStdString()] = 0.5f; p.parameters[ParameterIDs::delayMix.toStdString()] = 0.4f;
-    p.parameters[ParameterIDs::reverbSize.toStdString()] = 0.4f; p.parameters[ParameterIDs::reverbMix.toStdString()] = 0.2f;
+    p.parameters.set(ParameterIDs::Index::delayTime, 0.4f); p.parameters.set(ParameterIDs::Index::delayFeedback, 0.5f); p.parameters.set(ParameterIDs::Index::delayMix, 0.4f);
+    p.parameters.set(ParameterIDs::Index::reverbSize, 0.4f); p.parameters.set(ParameterIDs::Index::reverbMix, 0.2f);
     
-    p.parameters[ParameterIDs::hardSync.toStdString()] = 1.0f; // ENABLE HARD SYNC FOR LEAD
-    p.parameters[ParameterIDs::ringMod.toStdString()] = 0.0f;
-    p.parameters[ParameterIDs::glideTime.toStdString()] = 0.2f; // ENABLE GLIDE FOR LEAD!
-    p.parameters[ParameterIDs::chorusRate.toStdString()] = 0.5f; p.parameters[ParameterIDs::chorusDepth.toStdString()] = 2.0f; p.parameters[ParameterIDs::chorusMix.toStdString()] = 0.0f;
-p.parameters[ParameterIDs::chorusRate.toStdString()] = 0.5f; p.parameters[ParameterIDs::chorusDepth.toStdString()] = 2.0f; p.parameters[ParameterIDs::chorusMix.toStdString()] = 0.0f;
+    p.parameters.set(ParameterIDs::Index::hardSync, 1.0f); // ENABLE HARD SYNC FOR LEAD
+    p.parameters.set(ParameterIDs::Index::ringMod, 0.0f);
+    p.parameters.set(ParameterIDs::Index::glideTime, 0.2f); // ENABLE GLIDE FOR LEAD!
+    p.parameters.set(ParameterIDs::Index::chorusRate, 0.5f); p.parameters.set(ParameterIDs::Index::chorusDepth, 2.0f); p.parameters.set(ParameterIDs::Index::chorusMix, 0.0f);
+p.parameters.set(ParameterIDs::Index::chorusRate, 0.5f); p.parameters.set(ParameterIDs::Index::chorusDepth, 2.0f); p.parameters.set(ParameterIDs::Index::chorusMix, 0.0f);
 
     presets.push_back(p);
 }
@@ -642,9 +590,9 @@ void PresetManager::createBellsPreset()
     p.name = "Digital Bells";
     initEnvelopes(p);
     
-    p.parameters[ParameterIDs::osc1Waveform.toStdString()] = 0.0f; p.parameters[ParameterIDs::osc1Level.toStdString()] = 1.0f;
-    p.parameters[ParameterIDs::osc2Waveform.toStdString()] = 0.0f; p.parameters[ParameterIDs::osc2Level.toStdString()] = 1.0f;
-    p.parameters[ParameterIDs::osc2Detune.toStdString()] = 350.0f; // Detune for bell
+    p.parameters.set(ParameterIDs::Index::osc1Waveform, 0.0f); p.parameters.set(ParameterIDs::Index::osc1Level, 1.0f);
+    p.parameters.set(ParameterIDs::Index::osc2Waveform, 0.0f); p.parameters.set(ParameterIDs::Index::osc2Level, 1.0f);
+    p.parameters.set(ParameterIDs::Index::osc2Detune, 350.0f); // Detune for bell
     
     // DCW: Short
     p.dcwEnv.rates[0] = 0.99f; p.dcwEnv.levels[0] = 1.0f;
@@ -659,23 +607,23 @@ void PresetManager::createBellsPreset()
     p.dcaEnv.rates[2] = 0.99f; p.dcaEnv.levels[2] = 0.0f;
     p.dcaEnv.rates[3] = 0.5f;  p.dcaEnv.levels[3] = 0.0f;
     
-    p.parameters[ParameterIDs::dcwAttack.toStdString()] = 0.0f; p.parameters[ParameterIDs::dcwDecay.toStdString()] = 0.8f; p.parameters[ParameterIDs::dcwSustain.toStdString()] = 0.0f; p.parameters[ParameterIDs::dcwRelease.toStdString()] = 0.5f;
-    p.parameters[ParameterIDs::dcaAttack.toStdString()] = 0.0f; p.parameters[ParameterIDs::dcaDecay.toStdString()] = 1.5f; p.parameters[ParameterIDs::dcaSustain.toStdString()] = 0.0f; p.parameters[ParameterIDs::dcaRelease.toStdString()] = 1.0f;
+    p.parameters.set(ParameterIDs::Index::dcwAttack, 0.0f); p.parameters.set(ParameterIDs::Index::dcwDecay, 0.8f); p.parameters.set(ParameterIDs::Index::dcwSustain, 0.0f); p.parameters.set(ParameterIDs::Index::dcwRelease, 0.5f);
+    p.parameters.set(ParameterIDs::Index::dcaAttack, 0.0f); p.parameters.set(ParameterIDs::Index::dcaDecay, 1.5f); p.parameters.set(ParameterIDs::Index::dcaSustain, 0.0f); p.parameters.set(ParameterIDs::Index::dcaRelease, 1.0f);
 
     // Filter
-    p.parameters[ParameterIDs::lpfCutoff.toStdString()] = 12000.0f;
-    p.parameters[ParameterIDs::lpfReso.toStdString()] = 0.2f;
+    p.parameters.set(ParameterIDs::Index::lpfCutoff, 12000.0f);
+    p.parameters.set(ParameterIDs::Index::lpfReso, 0.2f);
 
     // LFO
-    p.parameters[ParameterIDs::lfoRate.toStdString()] = 6.0f;
+    p.parameters.set(ParameterIDs::Index::lfoRate, 6.0f);
     
     // Effects
-    p.parameters[ParameterIDs::delayTime.toStdString()] = 0.0f; p.parameters[ParameterIDs::delayFeedback.toStdString()] = 0.0f; p.parameters[ParameterIDs::delayMix.toStdString()] = 0.0f;
-    p.parameters[ParameterIDs::reverbSize.toStdString()] = 0.9f; p.parameters[ParameterIDs::reverbMix.toStdString()] = 0.4f; // Spacey
+    p.parameters.set(ParameterIDs::Index::delayTime, 0.0f); p.parameters.set(ParameterIDs::Index::delayFeedback, 0.0f); p.parameters.set(ParameterIDs::Index::delayMix, 0.0f);
+    p.parameters.set(ParameterIDs::Index::reverbSize, 0.9f); p.parameters.set(ParameterIDs::Index::reverbMix, 0.4f); // Spacey
     
-    p.parameters[ParameterIDs::hardSync.toStdString()] = 0.0f;
-    p.parameters[ParameterIDs::ringMod.toStdString()] = 1.0f; // ENABLE RING MOD FOR BELLS
-    p.parameters[ParameterIDs::glideTime.toStdString()] = 0.0f;
+    p.parameters.set(ParameterIDs::Index::hardSync, 0.0f);
+    p.parameters.set(ParameterIDs::Index::ringMod, 1.0f); // ENABLE RING MOD FOR BELLS
+    p.parameters.set(ParameterIDs::Index::glideTime, 0.0f);
 
     presets.push_back(p);
 }
@@ -721,9 +669,9 @@ void PresetManager::saveBank(const juce::File& file)
         if (!preset.author.empty()) obj->setProperty("author", juce::String(preset.author));
 
         juce::DynamicObject::Ptr paramsObj = new juce::DynamicObject();
-        for (const auto& [id, val] : preset.parameters) {
-            paramsObj->setProperty(juce::Identifier(id), val);
-        }
+        preset.parameters.forEachStored([&paramsObj](ParameterIDs::Index id, float val) {
+            paramsObj->setProperty(juce::Identifier(ParameterIDs::idFor(id)), val);
+        });
         obj->setProperty("params", juce::var(paramsObj.get()));
         
         // Helper to serialize Env (Audit Fix 5.1: Int Serialization x10000)
@@ -787,9 +735,9 @@ void PresetManager::savePresetToFile(int index, const juce::File& file)
     obj->setProperty("author", juce::String(preset.author));
     
     juce::DynamicObject::Ptr paramsObj = new juce::DynamicObject();
-    for (auto const& [key, val] : preset.parameters) {
-        paramsObj->setProperty(juce::Identifier(key), val);
-    }
+    preset.parameters.forEachStored([&paramsObj](ParameterIDs::Index id, float val) {
+        paramsObj->setProperty(juce::Identifier(ParameterIDs::idFor(id)), val);
+    });
     obj->setProperty("params", paramsObj.get());
     
     auto serializeEnv = [&](const EnvelopeData& env, const juce::String& propertyName) {
@@ -838,7 +786,7 @@ void PresetManager::loadPresetFromFile(const juce::File& file)
     if (auto* paramsObj = presetVar["params"].getDynamicObject()) {
         auto props = paramsObj->getProperties();
         for (auto& prop : props) {
-            p.parameters[prop.name.toString().toUpperCase().toStdString()] = static_cast<float>(prop.value);
+            p.parameters.setById(prop.name.toString().toUpperCase(), static_cast<float>(prop.value));
         }
     }
     
@@ -906,7 +854,7 @@ void PresetManager::loadBank(const juce::File& file)
             if (auto* paramsObj = presetVar["params"].getDynamicObject()) {
                 auto props = paramsObj->getProperties();
                 for (auto& prop : props) {
-                    p.parameters[prop.name.toString().toUpperCase().toStdString()] = static_cast<float>(prop.value);
+                    p.parameters.setById(prop.name.toString().toUpperCase(), static_cast<float>(prop.value));
                 }
             }
             
@@ -958,6 +906,7 @@ void PresetManager::loadBank(const juce::File& file)
     }
     
     juce::Logger::writeToLog("PresetManager: Bank applied, loading preset 0");
+    listeners.call(&Listener::bankUpdated);
     loadPreset(currentPresetIndex);
 }
 
@@ -972,8 +921,10 @@ void PresetManager::resetToFactory()
     {
         currentPresetIndex = 0;
         currentPreset = presets[0];
+        ++currentPresetSerial;
         applyPresetToProcessor(currentPreset);
     }
+    listeners.call(&Listener::bankUpdated);
 }
 
 
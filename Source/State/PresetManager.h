@@ -2,13 +2,12 @@
 
 #include <string>
 #include <vector>
-#include <map>
-#include <string>
-#include <vector>
-#include <map>
+#include <array>
+#include <cstdint>
 #include <juce_core/juce_core.h>
 #include <juce_events/juce_events.h>
 #include <juce_data_structures/juce_data_structures.h>
+#include "ParameterIDs.h"
 
 namespace CZ101 {
 namespace State {
@@ -32,13 +31,69 @@ struct EnvelopeData
     }
 };
 
+/**
+ * Preset parameter values indexed by ParameterIDs::Index, in parameter units
+ * (choice index / int value / 0-1 for bools).
+ *
+ * Fixed-size plain data, so copying and comparing presets is memcpy/memcmp work;
+ * string IDs appear only at the serialisation boundary (setById / JSON).
+ * Factory and SysEx patches store a subset: parameters that are not stored keep
+ * their current value when the preset is applied. Unstored values are kept at 0.
+ */
+struct PresetParameters
+{
+    using Index = ParameterIDs::Index;
+    static constexpr int NUM_PARAMETERS = ParameterIDs::NUM_PARAMETERS;
+
+    void set(Index p, float value) noexcept
+    {
+        const auto i = static_cast<size_t>(p);
+        values[i] = value;
+        stored[i / 32] |= (1u << (i % 32));
+    }
+
+    bool has(Index p) const noexcept
+    {
+        const auto i = static_cast<size_t>(p);
+        return (stored[i / 32] >> (i % 32)) & 1u;
+    }
+
+    float get(Index p, float fallback = 0.0f) const noexcept { return has(p) ? values[static_cast<size_t>(p)] : fallback; }
+
+    /** Stores by string ID; returns false (and ignores the value) for unknown IDs */
+    bool setById(const juce::String& id, float value)
+    {
+        const int index = ParameterIDs::indexOf(id);
+        if (index < 0) return false;
+        set(static_cast<Index>(index), value);
+        return true;
+    }
+
+    /** f(Index, float) for every stored parameter, in index order */
+    template <typename Func>
+    void forEachStored(Func&& f) const
+    {
+        for (int i = 0; i < NUM_PARAMETERS; ++i)
+            if (has(static_cast<Index>(i))) f(static_cast<Index>(i), values[(size_t)i]);
+    }
+
+    void clear() noexcept { values.fill(0.0f); stored.fill(0u); }
+
+    bool operator==(const PresetParameters& other) const noexcept { return stored == other.stored && values == other.values; }
+    bool operator!=(const PresetParameters& other) const noexcept { return !(*this == other); }
+
+private:
+    std::array<float, NUM_PARAMETERS> values {};
+    std::array<uint32_t, (NUM_PARAMETERS + 31) / 32> stored {};
+};
+
 struct Preset
 {
     std::string name;
     std::string author; // Added author field
     
-    // Parameter map (string ID -> normalized value 0.0-1.0 or specific range)
-    std::map<std::string, float> parameters;
+    // Parameter values (dense, see PresetParameters)
+    PresetParameters parameters;
     
     // Envelopes Line 1
     EnvelopeData pitchEnv;
@@ -111,6 +166,7 @@ public:
     const Preset& getCurrentPreset() const { return currentPreset; }
     const std::vector<Preset>& getPresets() const { return presets; } // Warning: Not thread-safe without calling getLock()
     int getCurrentPresetIndex() const { return currentPresetIndex; }
+    uint32_t getCurrentPresetSerial() const { return currentPresetSerial; } // Changes whenever currentPreset is replaced (read under getLock())
     
     // Thread-Safe Accessors (Audit Fix)
     int getNumPresets() const;
@@ -125,6 +181,7 @@ private:
     std::vector<Preset> presets;
     Preset currentPreset;
     int currentPresetIndex = 0; // Added for tracking
+    uint32_t currentPresetSerial = 0; // Bumped wherever currentPreset is replaced
     Parameters* parameters = nullptr;
     Core::VoiceManager* voiceManager = nullptr;
     juce::ReadWriteLock presetLock;
@@ -143,8 +200,6 @@ private:
     void createBellsPreset();
     
     void applyPresetToProcessor();
-    // Helper to push 8-stage data to VoiceManager
-    void applyEnvelopeToVoice(const EnvelopeData& env, int type, int line); // 0=Pitch, 1=DCW, 2=DCA, line=1/2
     void autoSaveUserBank();
 
 public:
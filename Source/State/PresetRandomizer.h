@@ -19,22 +19,22 @@ public:
         
         // 1. Oscillators
         // LINE_SELECT: 0-3 (Choice Index)
-        p.parameters[ParameterIDs::lineSelect.toStdString()] = (float)rng.nextInt(4); 
+        p.parameters.set(ParameterIDs::Index::lineSelect, (float)rng.nextInt(4)); 
         
         // WAVEFORM: 0-7 (Choice Index)
-        p.parameters[ParameterIDs::osc1Waveform.toStdString()] = (float)rng.nextInt(8);
-        p.parameters[ParameterIDs::osc1Waveform2.toStdString()] = (rng.nextFloat() > 0.7f) ? (float)rng.nextInt(8) : 0.0f;
-        p.parameters[ParameterIDs::osc1Level.toStdString()] = 0.8f + rng.nextFloat() * 0.2f; // High level
+        p.parameters.set(ParameterIDs::Index::osc1Waveform, (float)rng.nextInt(8));
+        p.parameters.set(ParameterIDs::Index::osc1Waveform2, (rng.nextFloat() > 0.7f) ? (float)rng.nextInt(8) : 0.0f);
+        p.parameters.set(ParameterIDs::Index::osc1Level, 0.8f + rng.nextFloat() * 0.2f); // High level
         
-        p.parameters[ParameterIDs::osc2Waveform.toStdString()] = (float)rng.nextInt(8);
-        p.parameters[ParameterIDs::osc2Waveform2.toStdString()] = (rng.nextFloat() > 0.7f) ? (float)rng.nextInt(8) : 0.0f;
-        p.parameters[ParameterIDs::osc2Level.toStdString()] = rng.nextFloat(); 
-        p.parameters[ParameterIDs::osc2Detune.toStdString()] = (rng.nextFloat() - 0.5f) * 10.0f; // +/- 5 cents approx (Detune parameter is +/- 12 semitones? No, wait.)
+        p.parameters.set(ParameterIDs::Index::osc2Waveform, (float)rng.nextInt(8));
+        p.parameters.set(ParameterIDs::Index::osc2Waveform2, (rng.nextFloat() > 0.7f) ? (float)rng.nextInt(8) : 0.0f);
+        p.parameters.set(ParameterIDs::Index::osc2Level, rng.nextFloat()); 
+        p.parameters.set(ParameterIDs::Index::osc2Detune, (rng.nextFloat() - 0.5f) * 10.0f); // +/- 5 cents approx (Detune parameter is +/- 12 semitones? No, wait.)
         // OSC2_DETUNE in Parameters.cpp is -12.0 to 12.0 semitones.
         // We want subtle detune. 
-        p.parameters[ParameterIDs::osc2Detune.toStdString()] = (rng.nextFloat() - 0.5f) * 0.2f; // +/- 0.1 semitones
+        p.parameters.set(ParameterIDs::Index::osc2Detune, (rng.nextFloat() - 0.5f) * 0.2f); // +/- 0.1 semitones
         
-        p.parameters[ParameterIDs::ringMod.toStdString()] = (rng.nextFloat() > 0.8f) ? 1.0f : 0.0f;
+        p.parameters.set(ParameterIDs::Index::ringMod, (rng.nextFloat() > 0.8f) ? 1.0f : 0.0f);
         // NOISE_MOD? Not in Parameters.cpp. Check HARDWARE_NOISE? That's global.
         
         // 2. Envelopes
@@ -54,40 +54,40 @@ public:
         p.pitchEnv2 = p.pitchEnv;
         
         // 3. LFO
-        p.parameters[ParameterIDs::lfoWaveform.toStdString()] = (float)rng.nextInt(4); // 0-3
-        p.parameters[ParameterIDs::lfoRate.toStdString()] = 0.5f + rng.nextFloat() * 8.0f; // 0.5Hz to 8.5Hz
-        p.parameters[ParameterIDs::lfoDepth.toStdString()] = rng.nextFloat() * 0.3f; // Subtle
-        p.parameters[ParameterIDs::lfoDelay.toStdString()] = rng.nextFloat() * 0.5f; // 0-0.5s
+        p.parameters.set(ParameterIDs::Index::lfoWaveform, (float)rng.nextInt(4)); // 0-3
+        p.parameters.set(ParameterIDs::Index::lfoRate, 0.5f + rng.nextFloat() * 8.0f); // 0.5Hz to 8.5Hz
+        p.parameters.set(ParameterIDs::Index::lfoDepth, rng.nextFloat() * 0.3f); // Subtle
+        p.parameters.set(ParameterIDs::Index::lfoDelay, rng.nextFloat() * 0.5f); // 0-0.5s
         
         // 4. Effects
-        p.parameters[ParameterIDs::chorusMix.toStdString()] = (rng.nextFloat() > 0.7f) ? rng.nextFloat() * 0.5f : 0.0f;
-        p.parameters[ParameterIDs::delayMix.toStdString()] = (rng.nextFloat() > 0.8f) ? rng.nextFloat() * 0.4f : 0.0f;
-        p.parameters[ParameterIDs::delayTime.toStdString()] = 0.2f + rng.nextFloat() * 0.5f;
-        p.parameters[ParameterIDs::delayFeedback.toStdString()] = 0.3f;
+        p.parameters.set(ParameterIDs::Index::chorusMix, (rng.nextFloat() > 0.7f) ? rng.nextFloat() * 0.5f : 0.0f);
+        p.parameters.set(ParameterIDs::Index::delayMix, (rng.nextFloat() > 0.8f) ? rng.nextFloat() * 0.4f : 0.0f);
+        p.parameters.set(ParameterIDs::Index::delayTime, 0.2f + rng.nextFloat() * 0.5f);
+        p.parameters.set(ParameterIDs::Index::delayFeedback, 0.3f);
         
         // [NEW] Drive (Phase 12)
         // 20% chance of being active
         if (rng.nextFloat() > 0.8f) {
-            p.parameters[ParameterIDs::driveAmount.toStdString()] = 0.2f + rng.nextFloat() * 0.6f;
-            p.parameters[ParameterIDs::driveColor.toStdString()] = rng.nextFloat();
-            p.parameters[ParameterIDs::driveMix.toStdString()] = 0.3f + rng.nextFloat() * 0.7f; // Wet mix
+            p.parameters.set(ParameterIDs::Index::driveAmount, 0.2f + rng.nextFloat() * 0.6f);
+            p.parameters.set(ParameterIDs::Index::driveColor, rng.nextFloat());
+            p.parameters.set(ParameterIDs::Index::driveMix, 0.3f + rng.nextFloat() * 0.7f); // Wet mix
         } else {
-             p.parameters[ParameterIDs::driveAmount.toStdString()] = 0.0f;
-             p.parameters[ParameterIDs::driveColor.toStdString()] = 0.5f;
-             p.parameters[ParameterIDs::driveMix.toStdString()] = 0.0f;
+             p.parameters.set(ParameterIDs::Index::driveAmount, 0.0f);
+             p.parameters.set(ParameterIDs::Index::driveColor, 0.5f);
+             p.parameters.set(ParameterIDs::Index::driveMix, 0.0f);
         }
 
         // 5. Arpeggiator (Audit Fix)
         // Enable with low probability to not annoy user immediately, but randomize settings
-        p.parameters[ParameterIDs::arpEnabled.toStdString()] = (rng.nextFloat() > 0.8f) ? 1.0f : 0.0f; 
-        p.parameters[ParameterIDs::arpLatch.toStdString()] = (rng.nextFloat() > 0.7f) ? 1.0f : 0.0f;
-        p.parameters[ParameterIDs::arpRate.toStdString()] = (float)rng.nextInt(4); // 0-3
-        p.parameters[ParameterIDs::arpBpm.toStdString()] = 80.0f + rng.nextFloat() * 60.0f; // 80-140 Practical range
-        p.parameters[ParameterIDs::arpGate.toStdString()] = 0.3f + rng.nextFloat() * 0.7f; // Usable gate
-        p.parameters[ParameterIDs::arpSwing.toStdString()] = (rng.nextFloat() > 0.7f) ? rng.nextFloat() * 0.5f : 0.0f;
-        p.parameters[ParameterIDs::arpSwingMode.toStdString()] = (float)rng.nextInt(3);
-        p.parameters[ParameterIDs::arpPattern.toStdString()] = (float)rng.nextInt(5);
-        p.parameters[ParameterIDs::arpOctave.toStdString()] = (float)(1 + rng.nextInt(3)); // 1-3 useful range
+        p.parameters.set(ParameterIDs::Index::arpEnabled, (rng.nextFloat() > 0.8f) ? 1.0f : 0.0f); 
+        p.parameters.set(ParameterIDs::Index::arpLatch, (rng.nextFloat() > 0.7f) ? 1.0f : 0.0f);
+        p.parameters.set(ParameterIDs::Index::arpRate, (float)rng.nextInt(4)); // 0-3
+        p.parameters.set(ParameterIDs::Index::arpBpm, 80.0f + rng.nextFloat() * 60.0f); // 80-140 Practical range
+        p.parameters.set(ParameterIDs::Index::arpGate, 0.3f + rng.nextFloat() * 0.7f); // Usable gate
+        p.parameters.set(ParameterIDs::Index::arpSwing, (rng.nextFloat() > 0.7f) ? rng.nextFloat() * 0.5f : 0.0f);
+        p.parameters.set(ParameterIDs::Index::arpSwingMode, (float)rng.nextInt(3));
+        p.parameters.set(ParameterIDs::Index::arpPattern, (float)rng.nextInt(5));
+        p.parameters.set(ParameterIDs::Index::arpOctave, (float)(1 + rng.nextInt(3))); // 1-3 useful range
         
         return p;
     }
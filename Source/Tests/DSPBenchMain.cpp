@@ -0,0 +1,407 @@
+/*
+  ==============================================================================
+
+    DSPBenchMain.cpp
+    Micro-benchmarks for the audio-rate DSP kernels.
+    Reports ns/sample and speedup of the block kernels against the
+    per-sample reference paths they replace, plus cost and alias
+    rejection of the oversampling decimators, the fast-math
+    approximations against the C library, and the voice filter bank.
+
+  ==============================================================================
+*/
+
+#include <juce_core/juce_core.h>
+#include <juce_audio_basics/juce_audio_basics.h>
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <vector>
+#include <cmath>
+
+#include "../DSP/Oscillators/PhaseDistOsc.h"
+#include "../DSP/Filters/HalfBandDecimator.h"
+#include "../DSP/Filters/ResonantFilter.h"
+#include "../DSP/Filters/SVFFilterBank.h"
+#include "../Utils/FastMath.h"
+
+namespace
+{
+    using Clock = std::chrono::high_resolution_clock;
+    using Osc = CZ101::DSP::PhaseDistOscillator;
+
+    constexpr double SAMPLE_RATE = 44100.0;
+    constexpr int SEGMENT = 8;          // Control-rate period, as Voice renders
+    constexpr int TOTAL_SAMPLES = 1 << 20;
+
+    volatile float sink = 0.0f; // Keeps the optimiser from dropping the work
+
+    template <typename Fn>
+    double nsPerSample(Fn&& fn)
+    {
+        fn(); // Warm-up
+        double best = 1.0e30;
+        for (int run = 0; run < 5; ++run)
+        {
+            const auto start = Clock::now();
+            fn();
+            const auto end = Clock::now();
+            best = std::min(best, std::chrono::duration<double, std::nano>(end - start).count() / TOTAL_SAMPLES);
+        }
+        return best;
+    }
+
+    const char* waveName(int w)
+    {
+        static const char* names[] = { "SAW", "SQR", "PLS", "DSN", "SPL", "RS1", "RS2", "RS3", "---" };
+        return names[w];
+    }
+
+    // Oscillator kernels: renderNextSample() loop vs the (first, second)-specialised renderBlock()
+    void benchOscillatorKernels()
+    {
+        std::cout << "PhaseDistOscillator: per-sample vs specialised block kernel (ns/sample)" << std::endl;
+        std::cout << "  pair      scalar   kernel   speedup" << std::endl;
+
+        double totalScalar = 0.0, totalKernel = 0.0;
+        std::vector<float> block(SEGMENT);
+
+        for (int first = 0; first < Osc::NONE; ++first)
+        {
+            for (int second = 0; second <= Osc::NONE; ++second)
+            {
+                Osc osc;
+                osc.setSampleRate(SAMPLE_RATE);
+                osc.setFrequency(220.0f);
+                osc.setWaveforms(static_cast<Osc::CzWaveform>(first), static_cast<Osc::CzWaveform>(second));
+
+                const double scalar = nsPerSample([&]
+                {
+                    float acc = 0.0f;
+                    for (int i = 0; i < TOTAL_SAMPLES; ++i)
+                        acc += osc.renderNextSample(0.7f);
+                    sink = acc;
+                });
+
+                const double kernel = nsPerSample([&]
+                {
+                    float acc = 0.0f;
+                    for (int i = 0; i < TOTAL_SAMPLES; i += SEGMENT)
+                    {
+                        osc.renderBlock(block.data(), SEGMENT, 0.7f);
+                        for (float s : block) acc += s;
+                    }
+                    sink = acc;
+                });
+
+                totalScalar += scalar;
+                totalKernel += kernel;
+                std::cout << "  " << waveName(first) << "/" << waveName(second)
+                          << std::fixed << std::setprecision(2)
+                          << std::setw(10) << scalar << std::setw(9) << kernel
+                          << std::setw(9) << (scalar / kernel) << "x" << std::endl;
+            }
+        }
+
+        std::cout << "  mean speedup: " << std::setprecision(2) << (totalScalar / totalKernel) << "x" << std::endl;
+    }
+
+    //==========================================================================
+    // Oversampling: legacy boxcar average vs polyphase half-band chain
+    enum class Decimation { None, Boxcar, HalfBand };
+
+    struct OversampledSaw
+    {
+        Osc osc;
+        CZ101::DSP::OversamplingDecimator decimator;
+        std::vector<float> hi;
+        Decimation mode;
+        int factor;
+
+        OversampledSaw(Decimation m, int f, float frequency) : mode(m), factor(f)
+        {
+            osc.setSampleRate(SAMPLE_RATE * factor);
+            osc.setFrequency(frequency);
+            osc.setWaveforms(Osc::SAWTOOTH, Osc::NONE);
+            decimator.setFactor(mode == Decimation::HalfBand ? factor : 1);
+            hi.resize((size_t)(SEGMENT * factor));
+        }
+
+        // One control segment at the base rate, the way Voice renders it
+        void render(float* out)
+        {
+            osc.renderBlock(hi.data(), SEGMENT * factor, 1.0f);
+
+            if (mode == Decimation::HalfBand)
+            {
+                decimator.process(hi.data(), out, SEGMENT);
+                return;
+            }
+
+            const float scale = 1.0f / (float)factor;
+            for (int i = 0; i < SEGMENT; ++i)
+            {
+                float acc = 0.0f;
+                for (int k = 0; k < factor; ++k) acc += hi[(size_t)(i * factor + k)];
+                out[i] = acc * scale;
+            }
+        }
+    };
+
+    // Worst-case decimator rejection (dB) over oversampled-rate tones that fold below 18 kHz.
+    // Oscillator aliasing generated at the raised rate is not counted: this isolates the decimator.
+    double worstAliasRejectionDb(Decimation mode, int factor)
+    {
+        constexpr int NUM_OUT = 2048;
+        constexpr int WARM_UP = 256;
+        constexpr double AUDIO_EDGE = 18000.0;
+        const double hiRate = SAMPLE_RATE * factor;
+
+        double worst = -1000.0;
+        for (double f = SAMPLE_RATE * 0.5 + 250.0; f < hiRate * 0.5; f += 500.0)
+        {
+            const double folded = std::abs(f - SAMPLE_RATE * std::round(f / SAMPLE_RATE));
+            if (folded > AUDIO_EDGE) continue;
+
+            CZ101::DSP::OversamplingDecimator decimator;
+            decimator.setFactor(factor);
+            std::vector<float> hi((size_t)(SEGMENT * factor));
+            std::vector<float> out((size_t)SEGMENT);
+            double power = 0.0;
+            int n = 0;
+
+            for (int pos = 0; pos < NUM_OUT; pos += SEGMENT)
+            {
+                for (int k = 0; k < SEGMENT * factor; ++k, ++n)
+                    hi[(size_t)k] = (float)std::sin(juce::MathConstants<double>::twoPi * f * n / hiRate);
+
+                if (mode == Decimation::HalfBand)
+                {
+                    decimator.process(hi.data(), out.data(), SEGMENT);
+                }
+                else
+                {
+                    for (int i = 0; i < SEGMENT; ++i)
+                    {
+                        float acc = 0.0f;
+                        for (int k = 0; k < factor; ++k) acc += hi[(size_t)(i * factor + k)];
+                        out[(size_t)i] = acc / (float)factor;
+                    }
+                }
+
+                if (pos >= WARM_UP)
+                    for (float y : out) power += (double)y * y;
+            }
+
+            const double gainDb = 10.0 * std::log10(power / (NUM_OUT - WARM_UP) / 0.5 + 1.0e-30);
+            worst = std::max(worst, gainDb);
+        }
+        return -worst;
+    }
+
+    void benchOversampling()
+    {
+        struct Config { const char* name; Decimation mode; int factor; };
+        const Config configs[] = {
+            { "1x  (none)     ", Decimation::None, 1 },
+            { "4x  boxcar     ", Decimation::Boxcar, 4 },
+            { "2x  half-band  ", Decimation::HalfBand, 2 },
+            { "4x  half-band  ", Decimation::HalfBand, 4 },
+        };
+
+        std::cout << std::endl << "Oversampled SAW line, DCW 1.0 (ns/sample at base rate; worst alias rejection below 18 kHz)" << std::endl;
+        std::cout << "  config          ns/smp   rejection" << std::endl;
+
+        for (const auto& c : configs)
+        {
+            OversampledSaw saw(c.mode, c.factor, 220.0f);
+            std::vector<float> block(SEGMENT);
+
+            const double ns = nsPerSample([&]
+            {
+                float acc = 0.0f;
+                for (int i = 0; i < TOTAL_SAMPLES; i += SEGMENT)
+                {
+                    saw.render(block.data());
+                    acc += block[0];
+                }
+                sink = acc;
+            });
+
+            std::cout << "  " << c.name << std::fixed << std::setprecision(2) << std::setw(7) << ns;
+            if (c.mode == Decimation::None)
+                std::cout << "        -" << std::endl;
+            else
+                std::cout << std::setprecision(1) << std::setw(9) << worstAliasRejectionDb(c.mode, c.factor) << " dB" << std::endl;
+        }
+
+        std::cout << "  latency (base samples): 2x " << CZ101::DSP::OversamplingDecimator::getLatencySamples(2)
+                  << ", 4x " << CZ101::DSP::OversamplingDecimator::getLatencySamples(4) << std::endl;
+    }
+
+    //==========================================================================
+    // Fast math: C library vs FastMath scalar (one call per value, as the voice uses it) vs block form
+    template <typename Std, typename Fast, typename Block>
+    void benchFunction(const char* name, std::vector<float>& input, Std&& stdFn, Fast&& fastFn, Block&& blockFn)
+    {
+        const int n = static_cast<int>(input.size());
+        std::vector<float> out(input.size());
+
+        auto perValue = [&](auto&& fn)
+        {
+            return nsPerSample([&]
+            {
+                float acc = 0.0f;
+                for (int pass = 0; pass < TOTAL_SAMPLES; pass += n)
+                    for (int i = 0; i < n; ++i) acc += fn(input[(size_t)i]);
+                sink = acc;
+            });
+        };
+
+        const double libm = perValue(stdFn);
+        const double scalar = perValue(fastFn);
+        const double block = nsPerSample([&]
+        {
+            float acc = 0.0f;
+            for (int pass = 0; pass < TOTAL_SAMPLES; pass += n)
+            {
+                blockFn(input.data(), out.data(), n);
+                acc += out[0];
+            }
+            sink = acc;
+        });
+
+        std::cout << "  " << name << std::fixed << std::setprecision(2)
+                  << std::setw(9) << libm << std::setw(9) << scalar << std::setw(9) << block
+                  << std::setw(9) << (libm / block) << "x" << std::endl;
+    }
+
+    void benchFastMath()
+    {
+        namespace FM = CZ101::Utils::FastMath;
+        std::cout << std::endl << "FastMath vs C library (ns/value; block = 256-value arrays)" << std::endl;
+        std::cout << "  func      libm   scalar    block  speedup" << std::endl;
+
+        std::vector<float> input(256);
+        for (size_t i = 0; i < input.size(); ++i) input[i] = -4.0f + 8.0f * (float)i / (float)input.size();
+        benchFunction("exp2", input, [](float x) { return std::exp2(x); }, [](float x) { return FM::exp2(x); },
+                      [](const float* in, float* out, int n) { FM::exp2(in, out, n); });
+        benchFunction("tanh", input, [](float x) { return std::tanh(x); }, [](float x) { return FM::tanh(x); },
+                      [](const float* in, float* out, int n) { FM::tanh(in, out, n); });
+
+        for (size_t i = 0; i < input.size(); ++i) input[i] = 20.0f + 20000.0f * (float)i / (float)input.size();
+        benchFunction("log2", input, [](float x) { return std::log2(x); }, [](float x) { return FM::log2(x); },
+                      [](const float* in, float* out, int n) { FM::log2(in, out, n); });
+    }
+
+    //==========================================================================
+    // Voice filters (LPF -> HPF), cutoff retargeted every control period:
+    // per-voice biquads recomputing sin/cos on every change vs per-voice SVF vs the lane-parallel bank
+    template <int NumVoices>
+    void benchVoiceFilters()
+    {
+        using namespace CZ101::DSP;
+        juce::ScopedNoDenormals noDenormals;
+
+        juce::Random random(1);
+        std::vector<float> input(SEGMENT);
+        for (auto& x : input) x = random.nextFloat() * 2.0f - 1.0f;
+
+        auto cutoffAt = [](int segment, int voice) { return 2000.0f + 1500.0f * std::sin(0.01f * (float)segment + (float)voice); };
+        const int numSegments = TOTAL_SAMPLES / SEGMENT / NumVoices;
+
+        std::vector<ResonantFilter> lpf(NumVoices), hpf(NumVoices);
+        for (int v = 0; v < NumVoices; ++v)
+        {
+            lpf[(size_t)v].setSampleRate(SAMPLE_RATE);
+            hpf[(size_t)v].setSampleRate(SAMPLE_RATE);
+            hpf[(size_t)v].setType(ResonantFilter::HIGHPASS);
+            hpf[(size_t)v].setCutoff(80.0f);
+            lpf[(size_t)v].setResonance(2.0f);
+        }
+
+        const double biquad = nsPerSample([&]
+        {
+            float acc = 0.0f;
+            for (int seg = 0; seg < numSegments; ++seg)
+                for (int v = 0; v < NumVoices; ++v)
+                {
+                    lpf[(size_t)v].setCutoff(cutoffAt(seg, v));
+                    for (int s = 0; s < SEGMENT; ++s)
+                        acc += hpf[(size_t)v].processSample(lpf[(size_t)v].processSample(input[(size_t)s]));
+                }
+            sink = acc;
+        });
+
+        auto targetsAt = [&](int seg, int v)
+        {
+            return SVFTargets { SVFCutoffTable::gain(cutoffAt(seg, v) / (float)SAMPLE_RATE), 0.5f,
+                                SVFCutoffTable::gain(80.0f / (float)SAMPLE_RATE) };
+        };
+
+        std::vector<SVFVoiceFilter> svf(NumVoices);
+        const double scalar = nsPerSample([&]
+        {
+            float acc = 0.0f;
+            for (int seg = 0; seg < numSegments; ++seg)
+                for (int v = 0; v < NumVoices; ++v)
+                {
+                    svf[(size_t)v].setTargets(targetsAt(seg, v), SEGMENT);
+                    for (int s = 0; s < SEGMENT; ++s)
+                        acc += svf[(size_t)v].processSample(input[(size_t)s]);
+                }
+            sink = acc;
+        });
+
+        SVFFilterBank<NumVoices> bank;
+        const double banked = nsPerSample([&]
+        {
+            float acc = 0.0f;
+            for (int seg = 0; seg < numSegments; ++seg)
+            {
+                for (int v = 0; v < NumVoices; ++v)
+                {
+                    svf[(size_t)v].setTargets(targetsAt(seg, v), SEGMENT);
+                    bank.load(v, svf[(size_t)v].getState());
+                    for (int s = 0; s < SEGMENT; ++s)
+                        bank.getInput(v)[s * bank.getStride()] = input[(size_t)s];
+                }
+
+                bank.process(SEGMENT, NumVoices);
+
+                for (int v = 0; v < NumVoices; ++v)
+                {
+                    bank.store(v, svf[(size_t)v].getState());
+                    acc += bank.getOutput(v)[0];
+                }
+            }
+            sink = acc;
+        });
+
+        std::cout << "  " << std::setw(3) << NumVoices << " voices" << std::fixed << std::setprecision(2)
+                  << std::setw(9) << biquad << std::setw(9) << scalar << std::setw(9) << banked
+                  << std::setw(9) << (biquad / banked) << "x" << std::endl;
+    }
+
+    void benchFilterBank()
+    {
+        std::cout << std::endl << "Voice filter LPF->HPF, cutoff moving every " << SEGMENT << " samples (ns/voice-sample)" << std::endl;
+        std::cout << "  voices     biquad      svf     bank  speedup" << std::endl;
+        benchVoiceFilters<8>();
+        benchVoiceFilters<16>();
+        benchVoiceFilters<64>();
+    }
+}
+
+int main()
+{
+    std::cout << "========================================" << std::endl;
+    std::cout << "      CZ-101 DSP Benchmarks" << std::endl;
+    std::cout << "========================================" << std::endl;
+
+    benchOscillatorKernels();
+    benchOversampling();
+    benchFastMath();
+    benchFilterBank();
+    return 0;
+}
@@ -0,0 +1,119 @@
+/*
+  ==============================================================================
+
+    FastMathTestMain.cpp
+    Accuracy test for Utils::FastMath: sweeps each approximation against
+    double-precision libm and fails if a documented error bound is exceeded.
+    Also checks that the block forms match the scalar forms bit for bit.
+
+  ==============================================================================
+*/
+
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <cmath>
+#include <cstring>
+#include <algorithm>
+
+#include "../Utils/FastMath.h"
+
+namespace
+{
+    namespace FM = CZ101::Utils::FastMath;
+
+    struct Result { double worst = 0.0; double at = 0.0; };
+
+    // Relative: |err / exact|. Scaled: |err| / max(1, |exact|), i.e. absolute until the result's own ulp dominates
+    enum class Error { Absolute, Relative, Scaled };
+
+    template <typename Approx, typename Reference>
+    Result sweep(double from, double to, int steps, Error kind, Approx&& approx, Reference&& reference)
+    {
+        Result r;
+        for (int i = 0; i <= steps; ++i)
+        {
+            const float x = static_cast<float>(from + (to - from) * i / steps);
+            const double exact = reference(static_cast<double>(x));
+            double err = std::abs(static_cast<double>(approx(x)) - exact);
+            if (kind == Error::Relative) err /= std::abs(exact);
+            if (kind == Error::Scaled)   err /= std::max(1.0, std::abs(exact));
+            if (err > r.worst) { r.worst = err; r.at = x; }
+        }
+        return r;
+    }
+
+    bool report(const char* name, const Result& r, double bound)
+    {
+        const bool ok = r.worst < bound;
+        std::cout << "  " << std::left << std::setw(28) << name << std::right
+                  << std::scientific << std::setprecision(2) << r.worst
+                  << " (bound " << bound << ", worst at x = " << std::defaultfloat << r.at << ")"
+                  << (ok ? "  PASS" : "  FAIL") << std::endl;
+        return ok;
+    }
+
+    template <typename Scalar, typename Block>
+    bool blockMatchesScalar(const char* name, const std::vector<float>& input, Scalar&& scalar, Block&& block)
+    {
+        std::vector<float> out(input.size());
+        block(input.data(), out.data(), static_cast<int>(input.size()));
+
+        for (size_t i = 0; i < input.size(); ++i)
+        {
+            const float s = scalar(input[i]);
+            if (std::memcmp(&s, &out[i], sizeof s) != 0)
+            {
+                std::cout << "  " << name << " block/scalar mismatch at x = " << input[i] << "  FAIL" << std::endl;
+                return false;
+            }
+        }
+        std::cout << "  " << name << " block == scalar (" << input.size() << " values)  PASS" << std::endl;
+        return true;
+    }
+}
+
+int main()
+{
+    std::cout << "========================================" << std::endl;
+    std::cout << "      CZ-101 FastMath Accuracy Test" << std::endl;
+    std::cout << "========================================" << std::endl;
+    std::cout << "Deterministic approximations: " << (FM::isDeterministic ? "on" : "off (libm)") << std::endl;
+
+    constexpr int STEPS = 2000000;
+    bool ok = true;
+
+    auto exp2f = [](float x) { return FM::exp2(x); };
+    auto log2f = [](float x) { return FM::log2(x); };
+    auto tanhf = [](float x) { return FM::tanh(x); };
+
+    // exp2: pitch range used by the voice (+-10 octaves) and the full clamp range
+    ok &= report("exp2 rel  [-10, 10]", sweep(-10.0, 10.0, STEPS, Error::Relative, exp2f, [](double x) { return std::exp2(x); }), 2.5e-7);
+    ok &= report("exp2 rel  [-126, 127]", sweep(-126.0, 127.0, STEPS, Error::Relative, exp2f, [](double x) { return std::exp2(x); }), 2.5e-7);
+
+    // log2: audio frequencies and a wide normal range
+    ok &= report("log2 scaled [1, 20000]", sweep(1.0, 20000.0, STEPS, Error::Scaled, log2f, [](double x) { return std::log2(x); }), 2.5e-7);
+    ok &= report("log2 scaled [1e-6, 1]", sweep(1.0e-6, 1.0, STEPS, Error::Scaled, log2f, [](double x) { return std::log2(x); }), 2.5e-7);
+
+    // tanh: around zero (series branch), the switch-over and saturation
+    ok &= report("tanh abs  [-1, 1]", sweep(-1.0, 1.0, STEPS, Error::Absolute, tanhf, [](double x) { return std::tanh(x); }), 3.0e-7);
+    ok &= report("tanh abs  [-20, 20]", sweep(-20.0, 20.0, STEPS, Error::Absolute, tanhf, [](double x) { return std::tanh(x); }), 3.0e-7);
+
+    // Edge cases: no NaN / inf / overshoot
+    const bool edges = FM::exp2(-1000.0f) > 0.0f && std::isfinite(FM::exp2(1000.0f))
+                    && FM::log2(0.0f) == -126.0f && FM::log2(-1.0f) == -126.0f
+                    && FM::tanh(1.0e6f) == 1.0f && FM::tanh(-1.0e6f) == -1.0f && FM::tanh(0.0f) == 0.0f;
+    std::cout << "  edge cases (clamps, saturation)  " << (edges ? "PASS" : "FAIL") << std::endl;
+    ok &= edges;
+
+    std::vector<float> input;
+    for (int i = -4000; i <= 4000; ++i) input.push_back(i * 0.01f);
+    ok &= blockMatchesScalar("exp2", input, exp2f, [](const float* in, float* out, int n) { FM::exp2(in, out, n); });
+    ok &= blockMatchesScalar("tanh", input, tanhf, [](const float* in, float* out, int n) { FM::tanh(in, out, n); });
+
+    for (auto& x : input) x = std::abs(x) + 1.0e-3f;
+    ok &= blockMatchesScalar("log2", input, log2f, [](const float* in, float* out, int n) { FM::log2(in, out, n); });
+
+    std::cout << (ok ? "SUCCESS: all bounds hold." : "FAILURE: see above.") << std::endl;
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,131 @@
+/*
+  ==============================================================================
+
+    MidiTimingTestMain.cpp
+    Sample-accurate MIDI test: a note-on placed anywhere inside a host block
+    must start sounding at its own timestamp. Each case renders a fresh
+    processor from silence and compares the note's onset latency with a
+    note-on at a block start; any difference means the event was moved.
+    Events closer than MIN_SUB_BLOCK_SAMPLES to the previous split must be
+    dispatched at that split instead: a silent controller in front of the
+    note-on sets the split, the note's onset shows where it was dispatched.
+
+  ==============================================================================
+*/
+
+#include <juce_core/juce_core.h>
+#include <juce_events/juce_events.h>
+#include <juce_audio_basics/juce_audio_basics.h>
+#include <juce_audio_processors/juce_audio_processors.h>
+#include <iostream>
+#include <cmath>
+#include <vector>
+
+#include "../PluginProcessor.h"
+
+namespace
+{
+    constexpr double SAMPLE_RATE = 44100.0;
+    constexpr int BLOCK_SIZE = 512;
+    constexpr int NUM_BLOCKS = 6;
+
+    struct TimedEvent
+    {
+        int sample; // Absolute
+        juce::MidiMessage message;
+    };
+
+    TimedEvent noteOnAt(int sample) { return { sample, juce::MidiMessage::noteOn(1, 60, (juce::uint8)100) }; }
+    TimedEvent splitAt(int sample) { return { sample, juce::MidiMessage::controllerEvent(1, 1, 0) }; } // Mod wheel at rest: silent
+
+    /** First non-silent output sample (absolute), with the given events (in time order); -1 if silent */
+    int renderOnset(const std::vector<TimedEvent>& events)
+    {
+        CZ101AudioProcessor processor;
+        processor.prepareToPlay(SAMPLE_RATE, BLOCK_SIZE);
+
+        juce::AudioBuffer<float> block(2, BLOCK_SIZE);
+        for (int start = 0; start < NUM_BLOCKS * BLOCK_SIZE; start += BLOCK_SIZE)
+        {
+            block.clear();
+            juce::MidiBuffer midi;
+            for (const auto& event : events)
+                if (event.sample >= start && event.sample < start + BLOCK_SIZE)
+                    midi.addEvent(event.message, event.sample - start);
+
+            processor.processBlock(block, midi);
+
+            for (int i = 0; i < BLOCK_SIZE; ++i)
+                if (std::abs(block.getSample(0, i)) > 0.0f)
+                    return start + i;
+        }
+        return -1;
+    }
+}
+
+int main()
+{
+    juce::ScopedJuceInitialiser_GUI juceInit; // The processor needs a MessageManager
+
+    std::cout << "========================================" << std::endl;
+    std::cout << "      CZ-101 MIDI Timing Test" << std::endl;
+    std::cout << "========================================" << std::endl;
+
+    // Reference: note-on on the first sample of block 2
+    const int referenceEvent = 2 * BLOCK_SIZE;
+    const int referenceOnset = renderOnset({ noteOnAt(referenceEvent) });
+    if (referenceOnset < 0)
+    {
+        std::cout << "FAILURE: reference note is silent." << std::endl;
+        return 1;
+    }
+
+    const int latency = referenceOnset - referenceEvent;
+    std::cout << "  Reference onset latency: " << latency << " samples" << std::endl;
+    bool ok = latency >= 0 && latency < CZ101::MIDI::MIDIProcessor::MIN_SUB_BLOCK_SAMPLES;
+
+    // Offsets into block 2, including both sides of the minimum sub-block size and the last sample
+    for (int offset : { 1, 7, 15, 16, 17, 100, 255, 333, 510, 511 })
+    {
+        const int eventSample = referenceEvent + offset;
+        const int onset = renderOnset({ noteOnAt(eventSample) });
+        const bool exact = onset - eventSample == latency;
+
+        std::cout << "  note-on at block offset " << offset << ": onset " << onset
+                  << " (expected " << eventSample + latency << ")" << (exact ? "  PASS" : "  FAIL") << std::endl;
+        ok &= exact;
+    }
+
+    // Two events less than MIN_SUB_BLOCK_SAMPLES apart: { controller offsets, note-on offset, expected dispatch offset }
+    using MIDIProcessor = CZ101::MIDI::MIDIProcessor;
+    struct CloseEvents { std::vector<int> splits; int note; int dispatched; const char* rule; };
+    const std::vector<CloseEvents> closeCases {
+        { { 0 },        10,  10,  "first sub-block may be short" },
+        { { 0, 5 },     12,  5,   "early, at the split" },
+        { { 3 },        3 + MIDIProcessor::MIN_SUB_BLOCK_SAMPLES - 1, 3, "early, at the split" },
+        { { 100 },      110, 100, "early, at the split" },
+        { { 100 },      100, 100, "same sample" },
+        { { 100 },      100 + MIDIProcessor::MIN_SUB_BLOCK_SAMPLES, 100 + MIDIProcessor::MIN_SUB_BLOCK_SAMPLES, "exact, a full sub-block" },
+        { { 496, 500 }, 511, 496, "early, at the split" },
+    };
+    for (const auto& c : closeCases)
+    {
+        std::vector<TimedEvent> events;
+        for (int split : c.splits)
+            events.push_back(splitAt(referenceEvent + split));
+        events.push_back(noteOnAt(referenceEvent + c.note));
+
+        const int expected = referenceEvent + c.dispatched + latency;
+        const int onset = renderOnset(events);
+        const bool exact = onset == expected;
+
+        std::cout << "  controller at offset";
+        for (int split : c.splits) std::cout << " " << split;
+        std::cout << ", note-on at " << c.note << " (" << c.rule << "): onset " << onset
+                  << " (expected " << expected << ")" << (exact ? "  PASS" : "  FAIL") << std::endl;
+        ok &= exact;
+    }
+
+    std::cout << (ok ? "SUCCESS: every note starts on its own sample or its split." : "FAILURE: see above.") << std::endl;
+    return ok ? 0 : 1;
+}
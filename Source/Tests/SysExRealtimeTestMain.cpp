@@ -0,0 +1,129 @@
+/*
+  ==============================================================================
+
+    SysExRealtimeTestMain.cpp
+    Real-time SysEx patch swap test: a patch dump received over MIDI while a
+    note is held must change the sound from the dump's sample on, with no
+    message-thread round trip (the test never runs the message loop). Renders
+    the same note with and without the dump and finds where they part; then
+    two dumps that differ only in their 8-stage DCA envelopes, which a note
+    played after them must reveal.
+
+  ==============================================================================
+*/
+
+#include <juce_core/juce_core.h>
+#include <juce_events/juce_events.h>
+#include <juce_audio_basics/juce_audio_basics.h>
+#include <juce_audio_processors/juce_audio_processors.h>
+#include <iostream>
+#include <vector>
+#include <cmath>
+
+#include "../PluginProcessor.h"
+
+namespace
+{
+    constexpr double SAMPLE_RATE = 44100.0;
+    constexpr int BLOCK_SIZE = 512;
+    constexpr int NUM_BLOCKS = 8;
+    constexpr int DUMP_BLOCK = 4;
+    constexpr int DUMP_OFFSET = 100;
+    constexpr int DUMP_SAMPLE = DUMP_BLOCK * BLOCK_SIZE + DUMP_OFFSET;
+    constexpr int BLOCK_END = (DUMP_BLOCK + 1) * BLOCK_SIZE;
+
+    // Well above the hardware DAC noise floor (which differs between renders)
+    constexpr float DIFFERENCE_THRESHOLD = 1.0e-3f;
+
+    /**
+     * Channel 0 of a note held from sample 0, with the dump (if any) at DUMP_SAMPLE and, if
+     * noteAfterDump, a second note right after it (a held note keeps the envelope it started with)
+     */
+    std::vector<float> render(const juce::MemoryBlock* dump, bool noteAfterDump = false)
+    {
+        CZ101AudioProcessor processor;
+        processor.prepareToPlay(SAMPLE_RATE, BLOCK_SIZE);
+        processor.getSysExManager().setProtectionState(false, true); // PROTECT off, MIDI PGM on
+
+        std::vector<float> output;
+        juce::AudioBuffer<float> block(2, BLOCK_SIZE);
+        for (int b = 0; b < NUM_BLOCKS; ++b)
+        {
+            block.clear();
+            juce::MidiBuffer midi;
+            if (b == 0)
+                midi.addEvent(juce::MidiMessage::noteOn(1, 60, (juce::uint8)100), 0);
+            if (dump != nullptr && b == DUMP_BLOCK)
+                midi.addEvent(juce::MidiMessage(dump->getData(), (int)dump->getSize()), DUMP_OFFSET);
+            if (noteAfterDump && b == DUMP_BLOCK)
+                midi.addEvent(juce::MidiMessage::noteOn(1, 67, (juce::uint8)100), DUMP_OFFSET + 1);
+
+            processor.processBlock(block, midi);
+            output.insert(output.end(), block.getReadPointer(0), block.getReadPointer(0) + BLOCK_SIZE);
+        }
+        return output;
+    }
+
+    /** The initial patch as a CZ-101 single-patch dump, with fast gate DCA envelopes at the given level */
+    juce::MemoryBlock createPatchDump(float dcaLevel, bool otherWaveforms)
+    {
+        CZ101AudioProcessor processor;
+        processor.prepareToPlay(SAMPLE_RATE, BLOCK_SIZE);
+
+        using P = CZ101::ParameterIDs::Index;
+        auto patch = processor.getPresetManager().getCurrentPreset();
+        if (otherWaveforms)
+        {
+            patch.parameters.set(P::osc1Waveform, patch.parameters.get(P::osc1Waveform) == 0.0f ? 1.0f : 0.0f);
+            patch.parameters.set(P::osc2Waveform, patch.parameters.get(P::osc2Waveform) == 0.0f ? 1.0f : 0.0f);
+            patch.parameters.set(P::lineSelect, patch.parameters.get(P::lineSelect, 2.0f) == 0.0f ? 1.0f : 0.0f);
+        }
+        for (auto* env : { &patch.dcaEnv, &patch.dcaEnv2 })
+        {
+            *env = CZ101::State::EnvelopeData();
+            env->rates[0] = env->rates[1] = 0.9f;
+            env->levels[0] = dcaLevel;
+            env->sustainPoint = 0;
+        }
+        return processor.getSysExManager().createPatchDump(patch);
+    }
+
+    /** First sample where the renders part, or -1 */
+    int firstDifference(const std::vector<float>& a, const std::vector<float>& b)
+    {
+        for (size_t i = 0; i < a.size(); ++i)
+            if (std::abs(a[i] - b[i]) > DIFFERENCE_THRESHOLD)
+                return (int)i;
+        return -1;
+    }
+
+    bool check(const char* what, int difference)
+    {
+        std::cout << "  " << what << ": sound changed at sample " << difference
+                  << " (expected from " << DUMP_SAMPLE << ", before " << BLOCK_END << ")" << std::endl;
+        return difference >= DUMP_SAMPLE && difference < BLOCK_END;
+    }
+}
+
+int main()
+{
+    juce::ScopedJuceInitialiser_GUI juceInit; // The processor needs a MessageManager
+
+    std::cout << "========================================" << std::endl;
+    std::cout << "      CZ-101 Real-Time SysEx Test" << std::endl;
+    std::cout << "========================================" << std::endl;
+
+    // 1. Another waveform and line selection: heard on the held note
+    const auto otherPatch = createPatchDump(1.0f, true);
+    std::cout << "  dump received at sample " << DUMP_SAMPLE << " (" << otherPatch.getSize() << " bytes)" << std::endl;
+    const bool patchHeard = check("other waveforms", firstDifference(render(nullptr), render(&otherPatch)));
+
+    // 2. Two dumps that differ only in their 8-stage DCA envelopes: heard on the next note
+    const auto loud = createPatchDump(1.0f, false);
+    const auto quiet = createPatchDump(0.25f, false);
+    const bool envelopeHeard = check("other DCA envelope", firstDifference(render(&loud, true), render(&quiet, true)));
+
+    const bool ok = patchHeard && envelopeHeard;
+    std::cout << (ok ? "SUCCESS: the received patch, envelopes included, is heard from its own sample." : "FAILURE: see above.") << std::endl;
+    return ok ? 0 : 1;
+}
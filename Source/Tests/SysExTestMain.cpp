@@ -28,7 +28,6 @@ void PresetManager::createBrassPreset() {}
 void PresetManager::createStringPreset() {}
 void PresetManager::createBellsPreset() {}
 void PresetManager::applyPresetToProcessor() {}
-void PresetManager::applyEnvelopeToVoice(const EnvelopeData&, int, int) {}
 
 // The critical method we are testing
 void PresetManager::loadPresetFromStruct(const Preset& p, bool, bool) 
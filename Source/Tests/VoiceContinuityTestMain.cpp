@@ -0,0 +1,139 @@
+/*
+  ==============================================================================
+
+    VoiceContinuityTestMain.cpp
+    Render-path handoff test: seven held notes, an eighth that comes and goes,
+    so the engine crosses PARALLEL_MIN_VOICES (7 -> 8 -> 7) and switches between
+    the SoA oscillator bank and per-voice rendering mid-note. The held voices
+    must carry on where they were: the switching render is compared with one
+    that never leaves the bank path.
+
+  ==============================================================================
+*/
+
+#include <juce_core/juce_core.h>
+#include <juce_audio_basics/juce_audio_basics.h>
+#include <iostream>
+#include <vector>
+#include <cmath>
+
+#include "../Core/VoiceManager.h"
+
+namespace
+{
+    constexpr double SAMPLE_RATE = 44100.0;
+    constexpr int BLOCK_SIZE = 512;
+    constexpr int NUM_BLOCKS = 24;
+    constexpr int EXTRA_NOTE_ON_BLOCK = 6;
+    constexpr int EXTRA_NOTE_OFF_BLOCK = 12;
+    constexpr int HELD_NOTES[] = { 48, 52, 55, 59, 62, 65, 69 };
+    constexpr int EXTRA_NOTE = 72;
+    constexpr int PARALLEL_WORKERS = 2;
+
+    // Kernel differences between the paths (sine approximation, DAC noise) stay far below
+    // this; a voice restarting its phase or control tick on the switch does not
+    constexpr float DIFFERENCE_THRESHOLD = 1.0e-2f;
+
+    struct Render
+    {
+        std::vector<float> samples;
+        std::vector<int> voiceCounts; // Per block, after rendering
+        bool switchedPath = false;
+    };
+
+    /**
+     * @param switching Parallel rendering on, so the eighth note moves every voice off the bank
+     *                  path. Without real-time workers, the bank is switched off for the same
+     *                  span instead: the same handoff in both directions.
+     */
+    Render render(bool switching)
+    {
+        CZ101::Core::VoiceManager voiceManager;
+        voiceManager.setSampleRate(SAMPLE_RATE);
+        voiceManager.setVoiceLimit(CZ101::Core::VoiceManager::MAX_VOICES);
+        voiceManager.setDCARelease(0.01f);
+
+        Render result;
+        bool toggleBank = false;
+        if (switching)
+        {
+            voiceManager.setParallelRendering(PARALLEL_WORKERS);
+            toggleBank = !voiceManager.isParallelRenderingEnabled();
+            if (toggleBank)
+                std::cout << "  (no real-time workers: switching the oscillator bank off for the 8-voice span)" << std::endl;
+        }
+
+        std::vector<float> left((size_t)BLOCK_SIZE), right((size_t)BLOCK_SIZE);
+        for (int b = 0; b < NUM_BLOCKS; ++b)
+        {
+            if (b == 0)
+                for (int note : HELD_NOTES) voiceManager.noteOn(note, 0.8f);
+            if (b == EXTRA_NOTE_ON_BLOCK)
+                voiceManager.noteOn(EXTRA_NOTE, 0.8f);
+            if (b == EXTRA_NOTE_OFF_BLOCK)
+                voiceManager.noteOff(EXTRA_NOTE);
+
+            if (toggleBank)
+            {
+                const bool eightVoices = voiceManager.getActiveVoiceCount() >= 8;
+                voiceManager.setOscillatorBankEnabled(!eightVoices);
+                result.switchedPath = result.switchedPath || eightVoices;
+            }
+            else if (switching)
+            {
+                result.switchedPath = result.switchedPath || voiceManager.getActiveVoiceCount() >= 8;
+            }
+
+            std::fill(left.begin(), left.end(), 0.0f);
+            std::fill(right.begin(), right.end(), 0.0f);
+            voiceManager.renderNextBlock(left.data(), right.data(), BLOCK_SIZE);
+            result.samples.insert(result.samples.end(), left.begin(), left.end());
+            result.voiceCounts.push_back(voiceManager.getActiveVoiceCount());
+        }
+
+        voiceManager.setParallelRendering(0);
+        return result;
+    }
+}
+
+int main()
+{
+    std::cout << "========================================" << std::endl;
+    std::cout << "   CZ-101 Render Path Continuity Test" << std::endl;
+    std::cout << "========================================" << std::endl;
+
+    if (CZ101::Core::VoiceManager::MAX_VOICES < 8)
+    {
+        std::cout << "SKIPPED: this build holds fewer than 8 voices." << std::endl;
+        return 0;
+    }
+
+    const auto reference = render(false);
+    const auto switching = render(true);
+
+    float peak = 0.0f, maxDifference = 0.0f;
+    int worstSample = -1;
+    for (size_t i = 0; i < reference.samples.size(); ++i)
+    {
+        peak = std::max(peak, std::abs(reference.samples[i]));
+        const float difference = std::abs(reference.samples[i] - switching.samples[i]);
+        if (difference > maxDifference)
+        {
+            maxDifference = difference;
+            worstSample = (int)i;
+        }
+    }
+
+    const bool reachedEight = switching.voiceCounts[(size_t)EXTRA_NOTE_ON_BLOCK] == 8;
+    const bool backToSeven = switching.voiceCounts.back() == 7;
+
+    std::cout << "  voices: 7 -> " << switching.voiceCounts[(size_t)EXTRA_NOTE_ON_BLOCK]
+              << " -> " << switching.voiceCounts.back() << std::endl;
+    std::cout << "  reference peak " << peak << ", max difference " << maxDifference
+              << " at sample " << worstSample << " (limit " << DIFFERENCE_THRESHOLD << ")" << std::endl;
+
+    const bool ok = reachedEight && backToSeven && switching.switchedPath
+                 && peak > DIFFERENCE_THRESHOLD && maxDifference < DIFFERENCE_THRESHOLD;
+    std::cout << (ok ? "SUCCESS: voices continue seamlessly across the render path switch." : "FAILURE: see above.") << std::endl;
+    return ok ? 0 : 1;
+}
@@ -45,6 +45,9 @@ LCDStateManager::~LCDStateManager()
 
 void LCDStateManager::parameterChanged(const juce::String& parameterID, float newValue)
 {
+    // Batched preset writes: skip the per-parameter message; endBatchUpdate() refreshes once
+    if (batchUpdateActive.load()) return;
+
     // Ensure thread safety for UI updates
     juce::MessageManager::callAsync([this, parameterID, newValue]() {
         if (parameterID == ParameterIDs::operationMode)
@@ -239,6 +242,18 @@ void LCDStateManager::showProgramMode()
     sendChangeMessage();
 }
 
+void LCDStateManager::endBatchUpdate()
+{
+    batchUpdateActive.store(false);
+
+    // Operation mode may have changed with the preset, so rebuild the edit list too
+    juce::MessageManager::callAsync([this]()
+    {
+        buildParameterList();
+        showProgramMode();
+    });
+}
+
 void LCDStateManager::onPageChanged(const juce::String& pageName)
 {
     if (feedbackSuppressed) return;
@@ -58,6 +58,10 @@ namespace UI {
         void showProgramMode();
         void onPageChanged(const juce::String& pageName);
         void setParameterFeedbackSuppressed(bool suppressed) { feedbackSuppressed = suppressed; }
+        
+        // Preset loads: per-parameter feedback is dropped until endBatchUpdate() refreshes once
+        void beginBatchUpdate() noexcept { batchUpdateActive.store(true); }
+        void endBatchUpdate();
 
     private:
         juce::AudioProcessorValueTreeState& apvts;
@@ -101,6 +105,7 @@ namespace UI {
         bool showingTemporaryParameter = false;
         bool modernParamActive = false;
         bool feedbackSuppressed = false;
+        std::atomic<bool> batchUpdateActive { false };
         juce::String temporaryParamId;
         
         // Acceleration State
@@ -0,0 +1,150 @@
+#pragma once
+
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <algorithm>
+
+// Build flag (CMake: -DCZ101_DETERMINISTIC_MATH=0|1)
+// 1 (default): the approximations below, built only from +, -, *, / and bit operations in a
+//              fixed order, so results are bit-identical across compilers, C libraries and
+//              between the scalar and block forms. This needs FP contraction off (no fused
+//              multiply-add), which CMake passes (-ffp-contract=off) to every target built with it.
+// 0:           every function forwards to the C library (reference build for A/B listening),
+//              clamped to the same limits, so neither mode yields inf or NaN for finite input.
+#ifndef CZ101_DETERMINISTIC_MATH
+ #define CZ101_DETERMINISTIC_MATH 1
+#endif
+
+namespace CZ101 {
+namespace Utils {
+
+/**
+ * @brief Fast exp2 / log2 / tanh for the voice hot path
+ *
+ * Each function has a scalar form and a block form (in/out arrays, may alias).
+ * The block forms are branch-free loops over the scalar kernels, written so the
+ * compiler vectorises them (SSE/AVX/NEON) without intrinsics.
+ *
+ * Worst-case error against double-precision libm (checked by CZ101FastMathTest):
+ *   exp2  relative < 2.5e-7   x in [-126, 127]; saturates outside, for |x| < 2^22 (no inf, no denormals)
+ *   log2  absolute < 2.5e-7 * max(1, |log2 x|)   positive normal x; x <= FLT_MIN returns -126
+ *   tanh  absolute < 3.0e-7   |x| < 1.4e6; exactly +-1 beyond |x| = 9
+ */
+namespace FastMath
+{
+    constexpr bool isDeterministic = (CZ101_DETERMINISTIC_MATH != 0);
+
+    namespace detail
+    {
+        // Everything below is straight-line: conditionals are bit selects, never branches, so that
+        // the block loops vectorise (a conditional float op is a branch under strict FP semantics)
+        inline float fromBits(int32_t bits) noexcept { float f; std::memcpy(&f, &bits, sizeof f); return f; }
+        inline int32_t toBits(float f) noexcept { int32_t bits; std::memcpy(&bits, &f, sizeof bits); return bits; }
+        inline float select(bool condition, float a, float b) noexcept
+        {
+            const int32_t mask = -static_cast<int32_t>(condition);
+            return fromBits((toBits(a) & mask) | (toBits(b) & ~mask));
+        }
+
+        // 2^x: x = n + f with f in [-0.5, 0.5], 2^f by a degree-5 Chebyshev fit (1.0e-7), 2^n built in the exponent
+        inline float exp2(float x) noexcept
+        {
+            // Round to nearest by adding 1.5 * 2^23: n lands in the low mantissa bits (valid for |x| < 2^22)
+            constexpr float roundingShift = 12582912.0f;
+            const float shifted = x + roundingShift;
+            int32_t n = toBits(shifted) - toBits(roundingShift);
+            const float f = x - (shifted - roundingShift);
+
+            // Saturate through the exponent rather than x, so there is no constant-result path to branch to
+            n = std::min(std::max(n, -126), 127);
+
+            float p = 0.001339086336f;
+            p = p * f + 0.009676031918f;
+            p = p * f + 0.05550357114f;
+            p = p * f + 0.2402210749f;
+            p = p * f + 0.693147188f;
+            p = p * f + 1.000000075f;
+            return p * fromBits((n + 127) << 23);
+        }
+
+        // log2(x) = e + log2(m), m in [sqrt(0.5), sqrt(2)); log2(m) = 2/ln2 * atanh((m-1)/(m+1)) to t^7 (4e-8)
+        inline float log2(float x) noexcept
+        {
+            // Offsetting by the bits of sqrt(0.5) makes mantissas above sqrt(2) borrow one from the exponent
+            constexpr int32_t sqrtHalfBits = 0x3f3504f3;
+            const int32_t bits = toBits(x) - sqrtHalfBits;
+            const int32_t e = bits >> 23;
+            const float m = fromBits((bits & 0x007fffff) + sqrtHalfBits);
+
+            const float t = (m - 1.0f) / (m + 1.0f);
+            const float t2 = t * t;
+            float p = 0.4121985831f;
+            p = p * t2 + 0.5770780164f;
+            p = p * t2 + 0.9617966939f;
+            p = p * t2 + 2.8853900818f;
+            return select(x < 1.17549435e-38f, -126.0f, static_cast<float>(e) + t * p);
+        }
+
+        // tanh(|x|) = (1 - e^(-2|x|)) / (1 + e^(-2|x|)), with the odd Taylor series below 0.25 where that form cancels
+        inline float tanh(float x) noexcept
+        {
+            const int32_t sign = toBits(x) & static_cast<int32_t>(0x80000000);
+            const float ax = std::abs(x);
+
+            const float e = exp2(ax * -2.8853900818f); // -2 / ln2; underflows to 2^-126 well before |x| = 10
+            const float large = (1.0f - e) / (1.0f + e);
+
+            const float x2 = ax * ax;
+            float small = -0.05396825397f;
+            small = small * x2 + 0.1333333333f;
+            small = small * x2 - 0.3333333333f;
+            small = small * x2 + 1.0f;
+            small *= ax;
+
+            return fromBits(toBits(select(ax < 0.25f, small, large)) | sign);
+        }
+    }
+
+    //==============================================================================
+    inline float exp2(float x) noexcept
+    {
+        if constexpr (isDeterministic) return detail::exp2(x);
+        else                           return std::exp2(std::min(std::max(x, -126.0f), 127.0f));
+    }
+
+    inline float log2(float x) noexcept
+    {
+        if constexpr (isDeterministic) return detail::log2(x);
+        else                           return std::log2(std::max(x, 1.17549435e-38f)); // x <= FLT_MIN: -126
+    }
+
+    inline float tanh(float x) noexcept
+    {
+        if constexpr (isDeterministic) return detail::tanh(x);
+        else                           return std::tanh(x);
+    }
+
+    /** 2^(semitones / 12) */
+    inline float semitonesToRatio(float semitones) noexcept { return exp2(semitones * (1.0f / 12.0f)); }
+
+    //==============================================================================
+    // Block forms: out[i] = f(in[i]), in == out allowed
+    inline void exp2(const float* in, float* out, int numSamples) noexcept
+    {
+        for (int i = 0; i < numSamples; ++i) out[i] = exp2(in[i]);
+    }
+
+    inline void log2(const float* in, float* out, int numSamples) noexcept
+    {
+        for (int i = 0; i < numSamples; ++i) out[i] = log2(in[i]);
+    }
+
+    inline void tanh(const float* in, float* out, int numSamples) noexcept
+    {
+        for (int i = 0; i < numSamples; ++i) out[i] = tanh(in[i]);
+    }
+} // namespace FastMath
+
+} // namespace Utils
+} // namespace CZ101
@@ -48,6 +48,16 @@ void PerformanceMonitor::setVoiceCount(int count)
     currentVoiceCount = count;
 }
 
+int PerformanceMonitor::getRetiredVoiceCount() const
+{
+    return retiredVoiceCount;
+}
+
+void PerformanceMonitor::setRetiredVoiceCount(int count)
+{
+    retiredVoiceCount = count;
+}
+
 void PerformanceMonitor::reset()
 {
     totalTime = 0.0;
@@ -17,8 +17,10 @@ public:
     double getAverageCpuUsage() const;
     double getPeakCpuUsage() const;
     int getVoiceCount() const;
+    int getRetiredVoiceCount() const; // Voices ended early by silence retirement
     
     void setVoiceCount(int count);
+    void setRetiredVoiceCount(int count);
     void reset();
     
 private:
@@ -29,6 +31,7 @@ private:
     double peakTime = 0.0;
     int measurementCount = 0;
     int currentVoiceCount = 0;
+    int retiredVoiceCount = 0;
 };
 
 } // namespace Utils